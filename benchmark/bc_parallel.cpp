@@ -45,23 +45,25 @@ void PBFS(GraphEngine &graph_engine,
 #pragma omp for schedule(dynamic, 64) nowait
       for (auto q_iter = queue.begin(); q_iter < queue.end(); q_iter++)
       {
-        GraphBase *g_ = graph_engine.create_graph_handle();
+        GraphBase *g_ = graph_engine.thread_handle(omp_get_thread_num());
         node_id_t u = *q_iter;
-        for (node_id_t &v : g_->get_out_nodes_id(u))
-        {
-          if ((depths[v] == -1) &&
-              (compare_and_swap(depths[v], static_cast<node_id_t>(-1), depth)))
-          {
-            lqueue.push_back(v);
-          }
-          if (depths[v] == depth)
-          {
-            succ.set_bit_atomic(v - g_out_start);
+        g_->for_each_out_neighbor(
+            u,
+            [&](node_id_t v)
+            {
+              if ((depths[v] == -1) &&
+                  (compare_and_swap(
+                      depths[v], static_cast<node_id_t>(-1), depth)))
+              {
+                lqueue.push_back(v);
+              }
+              if (depths[v] == depth)
+              {
+                succ.set_bit_atomic(v - g_out_start);
 #pragma omp atomic
-            path_counts[v] += path_counts[u];
-          }
-        }
-        g_->close(false);
+                path_counts[v] += path_counts[u];
+              }
+            });
       }
       lqueue.flush();
 #pragma omp barrier
@@ -131,7 +133,7 @@ pvector<ScoreT> Brandes(GraphEngine &graph_engine,
 #pragma omp parallel for schedule(dynamic, 64)
       for (auto it = depth_index[d]; it < depth_index[d + 1]; it++)
       {
-        GraphBase *g_ = graph_engine.create_graph_handle();
+        GraphBase *g_ = graph_engine.thread_handle(omp_get_thread_num());
         node_id_t u = *it;
         ScoreT delta_u = 0;
         for (node_id_t v : g_->get_out_nodes_id(u))
@@ -143,7 +145,6 @@ pvector<ScoreT> Brandes(GraphEngine &graph_engine,
         }
         deltas[u] = delta_u;
         scores[u] += delta_u;
-        g_->close(false);
       }
     }
     t.stop();
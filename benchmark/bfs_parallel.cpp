@@ -45,6 +45,7 @@ typedef int64_t NodeID;
 bool logging_enabled = true;
 
 int64_t BUStep(GraphEngine *graph_engine,
+               RangeScheduler *scheduler,
                pvector<NodeID> &parent,
                Bitmap &front,
                Bitmap &next,
@@ -52,33 +53,38 @@ int64_t BUStep(GraphEngine *graph_engine,
 {
   int64_t awake_count = 0;
   next.reset();
+  scheduler->reset();
 
-#pragma omp parallel for reduction(+ : awake_count) num_threads(thread_num)
-  for (int i = 0; i < thread_num; i++)
+#pragma omp parallel reduction(+ : awake_count) num_threads(thread_num)
   {
     GraphBase *graph = graph_engine->create_graph_handle();
     InCursor *in_cursor = graph->get_innbd_iter();
-    adjlist found{0, 0};
-    in_cursor->set_key_range(graph_engine->get_key_range(i));
+    adjlist_view found;
+    key_range range;
+    while (scheduler->next(omp_get_thread_num(), &range))
+    {
+      in_cursor->reset();
+      in_cursor->set_key_range(range);
 
-    in_cursor->next(&found);
+      in_cursor->next_view(&found);
 
-    while (found.node_id != OutOfBand_ID_MAX)
-    {
-      if (parent[found.node_id] < 0)
+      while (found.node_id != OutOfBand_ID_MAX)
       {
-        for (node_id_t v : found.edgelist)
+        if (parent[found.node_id] < 0)
         {
-          if (front.get_bit(v))
+          for (node_id_t v : found.edgelist)
           {
-            parent[found.node_id] = v;
-            awake_count++;
-            next.set_bit(found.node_id);
-            break;
+            if (front.get_bit(v))
+            {
+              parent[found.node_id] = v;
+              awake_count++;
+              next.set_bit_atomic(found.node_id);
+              break;
+            }
           }
         }
+        in_cursor->next_view(&found);
       }
-      in_cursor->next(&found);
     }
     graph->close(false);
   }
@@ -86,33 +92,57 @@ int64_t BUStep(GraphEngine *graph_engine,
   return awake_count;
 }
 
+// Frontiers at least this large are expanded with get_out_nodes_multi: each
+// thread sorts its share of the queue and walks the table once
+const size_t kMultiGetFrontier = 1 << 14;
+
 int64_t TDStep(GraphEngine *graph_engine,
                pvector<NodeID> &parent,
                SlidingQueue<node_id_t> &queue)
 {
   int64_t scout_count = 0;
+  bool multi_get = queue.size() >= kMultiGetFrontier;
 
-#pragma omp parallel
+#pragma omp parallel reduction(+ : scout_count)
   {
     QueueBuffer<node_id_t> lqueue(queue);
-#pragma omp for reduction(+ : scout_count) nowait
-    for (auto q_iter = queue.begin(); q_iter < queue.end(); q_iter++)
+    GraphBase *graph = graph_engine->thread_handle(omp_get_thread_num());
+    auto explore = [&](node_id_t u, node_id_t v)
     {
-      node_id_t u = *q_iter;
-      GraphBase *graph = graph_engine->create_graph_handle();
-      for (node_id_t v : graph->get_out_nodes_id(u))
+      NodeID curr_val = parent[v];
+      if (curr_val < 0)
       {
-        NodeID curr_val = parent[v];
-        if (curr_val < 0)
+        if (compare_and_swap(parent[v], curr_val, static_cast<NodeID>(u)))
         {
-          if (compare_and_swap(parent[v], curr_val, static_cast<NodeID>(u)))
-          {
-            lqueue.push_back(v);
-            scout_count += -curr_val;
-          }
+          lqueue.push_back(v);
+          scout_count += -curr_val;
         }
       }
-      graph->close(false);
+    };
+
+    if (multi_get)
+    {
+      size_t size = queue.size();
+      size_t tid = omp_get_thread_num();
+      size_t num_threads = omp_get_num_threads();
+      std::span<const node_id_t> share(
+          queue.begin() + size * tid / num_threads,
+          queue.begin() + size * (tid + 1) / num_threads);
+      graph->get_out_nodes_multi(
+          share,
+          [&](node_id_t u, std::span<const node_id_t> nbrs)
+          {
+            for (node_id_t v : nbrs) explore(u, v);
+          });
+    }
+    else
+    {
+#pragma omp for nowait
+      for (auto q_iter = queue.begin(); q_iter < queue.end(); q_iter++)
+      {
+        node_id_t u = *q_iter;
+        graph->for_each_out_neighbor(u, [&](node_id_t v) { explore(u, v); });
+      }
     }
     lqueue.flush();
   }
@@ -129,68 +159,109 @@ void QueueToBitmap(const SlidingQueue<node_id_t> &queue, Bitmap &bm)
   }
 }
 
-void BitmapToQueue(GraphEngine *graph_engine,
-                   const Bitmap &bm,
-                   SlidingQueue<node_id_t> &queue,
-                   int thread_num)
+// Walks the set bits word by word, so the cost is one load per 64 IDs plus
+// one ctz per node in the frontier; no table is read
+void BitmapToQueue(const Bitmap &bm, SlidingQueue<node_id_t> &queue)
 {
-#pragma omp parallel num_threads(thread_num)
+#pragma omp parallel
   {
     QueueBuffer<node_id_t> lqueue(queue);
 #pragma omp for nowait
-    for (int i = 0; i < thread_num; i++)
+    for (size_t w = 0; w < bm.num_words(); w++)
     {
-      GraphBase *graph = graph_engine->create_graph_handle();
-      NodeCursor *node_cursor = graph->get_node_iter();
-      node_cursor->set_key_range(graph_engine->get_key_range(i));
-
-      node found = {0};
-      node_cursor->next(&found);
-      while (found.id != OutOfBand_ID_MAX)
+      uint64_t bits = bm.get_word(w);
+      while (bits != 0)
       {
-        if (bm.get_bit(found.id)) lqueue.push_back(found.id);
-        node_cursor->next(&found);
+        lqueue.push_back(w * 64 + __builtin_ctzll(bits));
+        bits &= bits - 1;
       }
-      graph->close(false);
     }
     lqueue.flush();
   }
   queue.slide_window();
 }
 
-pvector<NodeID> InitParent(GraphEngine *graph_engine,
-                           node_id_t max_node_id,
-                           int thread_num)
+/**
+ * Out and in degrees of every ID in [0, num_ids), read once per run. Each
+ * thread fills its key range with one get_degrees() pass; IDs without a node
+ * keep degree 0. Everything after this (parent init, the bottom-up schedule,
+ * verification) reads the arrays instead of the tables.
+ */
+struct DegreeCache
 {
-  pvector<NodeID> parent(max_node_id);
+  pvector<degree_t> out;
+  pvector<degree_t> in;
 
-#pragma omp parallel for num_threads(thread_num)
-  for (int i = 0; i < thread_num; i++)
+  DegreeCache(GraphEngine *graph_engine, node_id_t num_ids, int thread_num)
+      : out(num_ids, 0), in(num_ids, 0)
   {
-    GraphBase *graph = graph_engine->create_graph_handle();
-    NodeCursor *node_cursor = graph->get_node_iter();
-    node found = {0};
-    node_cursor->set_key_range(graph_engine->get_key_range(i));
-
-    node_cursor->next(&found);
-    while (found.id != OutOfBand_ID_MAX)
+#pragma omp parallel for num_threads(thread_num)
+    for (int i = 0; i < thread_num; i++)
     {
-      auto degree = static_cast<int64_t>(graph->get_out_degree(found.id));
-      parent[found.id] = degree != 0 ? -degree : -1;
+      GraphBase *graph = graph_engine->create_graph_handle();
+      key_range range = graph_engine->get_key_range(i);
+      range.end = std::min<node_id_t>(range.end, num_ids - 1);
+      if (range.start <= range.end)
+      {
+        size_t len = range.end - range.start + 1;
+        graph->get_degrees(range,
+                           std::span<degree_t>(out.begin() + range.start, len),
+                           std::span<degree_t>(in.begin() + range.start, len));
+      }
+      graph->close(false);
+    }
+  }
 
-      node_cursor->next(&found);
+  /**
+   * Cuts the ID space into about num_ranges ranges of equal bottom-up work:
+   * the step reads the in list of every ID in a range, so the work of an ID
+   * is its in-degree plus one for the visit.
+   */
+  std::vector<key_range> edge_balanced_ranges(size_t num_ranges) const
+  {
+    uint64_t total = 0;
+    for (size_t n = 0; n < in.size(); n++) total += in[n] + 1;
+    uint64_t per_range = total / num_ranges + 1;
+
+    std::vector<key_range> ranges;
+    node_id_t start = 0;
+    uint64_t work = 0;
+    for (size_t n = 0; n < in.size(); n++)
+    {
+      work += in[n] + 1;
+      // an end of 0 would read as an open range, so ID 0 never ends one
+      if (work >= per_range && n != 0)
+      {
+        ranges.push_back({start, static_cast<node_id_t>(n)});
+        start = n + 1;
+        work = 0;
+      }
     }
-    graph->close(false);
+    if (start < in.size())
+    {
+      ranges.push_back({start, static_cast<node_id_t>(in.size() - 1)});
+    }
+    return ranges;
+  }
+};
+
+// Fills parent with -degree for the nodes with out edges, -1 otherwise.
+pvector<NodeID> InitParent(const DegreeCache &degrees)
+{
+  pvector<NodeID> parent(degrees.out.size());
+#pragma omp parallel for
+  for (size_t n = 0; n < parent.size(); n++)
+  {
+    auto degree = static_cast<NodeID>(degrees.out[n]);
+    parent[n] = degree != 0 ? -degree : -1;
   }
   return parent;
 }
 
 /**
- * In this function, only the parent array is being accessed by node_id. We need
- * to assign the array to be as large as the max_node_id
- *
- * SlidingQueue and the Bitmaps are always accessed by their methods (flush,
- * push, begin, end, etc.) and therefore can be created with size = num_nodes
+ * The parent array, the degree cache and the Bitmaps are indexed by node ID,
+ * so they cover the whole ID space [0, max_node_id]. The SlidingQueue holds
+ * each node at most once and is sized by num_nodes.
  */
 pvector<NodeID> DOBFS(GraphEngine *graph_engine,
                       node_id_t source,
@@ -203,9 +274,13 @@ pvector<NodeID> DOBFS(GraphEngine *graph_engine,
 {
   if (logging_enabled) std::cout << "Source" << source << std::endl;
   GraphBase *graph_stat = graph_engine->create_graph_handle();
+  node_id_t num_ids = max_node_id + 1;
   Times t;
   t.start();
-  pvector<NodeID> parent = InitParent(graph_engine, max_node_id, thread_num);
+  DegreeCache degrees(graph_engine, num_ids, thread_num);
+  pvector<NodeID> parent = InitParent(degrees);
+  RangeScheduler scheduler(degrees.edge_balanced_ranges(thread_num * 64),
+                           thread_num);
   t.stop();
   if (logging_enabled) printf("%5s%23.5Lf\n", "i", t.t_secs());
 
@@ -213,12 +288,12 @@ pvector<NodeID> DOBFS(GraphEngine *graph_engine,
   SlidingQueue<node_id_t> queue(num_nodes);
   queue.push_back(source);
   queue.slide_window();
-  Bitmap curr(num_nodes);
+  Bitmap curr(num_ids);
   curr.reset();
-  Bitmap front(num_nodes);
+  Bitmap front(num_ids);
   front.reset();
-  int64_t edges_to_check = GraphBase::get_num_edges();
-  int64_t scout_count = graph_stat->get_out_degree(source);
+  int64_t edges_to_check = graph_stat->get_num_edges();
+  int64_t scout_count = degrees.out[source];
   std::cout << "source: " << source << "\tscout_count: " << scout_count
             << "\tedges_to_check: " << edges_to_check << std::endl;
   queue.dump_stdout();
@@ -238,7 +313,8 @@ pvector<NodeID> DOBFS(GraphEngine *graph_engine,
       {
         t.start();
         old_awake_count = awake_count;
-        awake_count = BUStep(graph_engine, parent, front, curr, thread_num);
+        awake_count =
+            BUStep(graph_engine, &scheduler, parent, front, curr, thread_num);
         front.swap(curr);
         t.stop();
         printf("%5s%23.5Lf\n", "bu", t.t_secs());
@@ -246,7 +322,7 @@ pvector<NodeID> DOBFS(GraphEngine *graph_engine,
       } while ((awake_count >= old_awake_count) ||
                (awake_count > num_nodes / beta));
       t.start();
-      BitmapToQueue(graph_engine, front, queue, thread_num);
+      BitmapToQueue(front, queue);
       t.stop();
       printf("%5s%23.5Lf\n", "c", t.t_secs());
       scout_count = 1;
@@ -263,24 +339,20 @@ pvector<NodeID> DOBFS(GraphEngine *graph_engine,
   }
 
 #pragma omp parallel for
-  for (node_id_t n = 0; n < num_nodes; n++)
+  for (size_t n = 0; n < parent.size(); n++)
     if (parent[n] < -1) parent[n] = -1;
 
   if (verify)
   {
     int64_t count = 0, n_edges = 0;
-    NodeCursor *node_cursor = graph_stat->get_node_iter();
-    node found = {0};
-
-    node_cursor->next(&found);
-    while (found.id != OutOfBand_ID_MAX)
+#pragma omp parallel for reduction(+ : count, n_edges)
+    for (size_t n = 0; n < parent.size(); n++)
     {
-      if (parent[found.id] >= 0)
+      if (parent[n] >= 0)
       {
         count++;
-        n_edges += graph_stat->get_out_degree(found.id);
+        n_edges += degrees.out[n];
       }
-      node_cursor->next(&found);
     }
 
     std::cout << "BFS finished, Tree has " << count << " nodes and " << n_edges
@@ -313,7 +385,7 @@ int main(int argc, char *argv[])
 
   t.start();
   GraphBase *g = graphEngine.create_graph_handle();
-  node_id_t num_nodes = GraphBase::get_num_nodes();
+  node_id_t num_nodes = g->get_num_nodes();
   node_id_t max_node_id = g->get_max_node_id();
   if (opts.start_vertex == OutOfBand_ID_MAX)
     opts.start_vertex = g->get_random_node().id;
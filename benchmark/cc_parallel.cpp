@@ -6,6 +6,7 @@
 #include "benchmark_definitions.h"
 #include "command_line.h"
 #include "common_util.h"
+#include "csr_file.h"
 #include "graph_engine.h"
 #include "omp.h"
 #include "pvector.h"
@@ -35,53 +36,75 @@ more consistent performance for undirected graphs.
 */
 
 const int THREAD_NUM = omp_get_max_threads();
+// Limits of one OutCursor::next_batch() call, sized to stay in the L2 cache
+const size_t BATCH_NODES = 1024;
+const size_t BATCH_EDGES = 1 << 16;
 // The hooking condition (comp_u < comp_v) may not coincide with the edge's
 // direction, so we use a min-max swap such that lower component IDs propagate
 // independent of the edge's direction.
+// If out_csr is set the edges are read from it instead of WiredTiger.
 pvector<node_id_t> ShiloachVishkin(GraphEngine& g,
                                    node_id_t numNodes,
-                                   node_id_t maxNodeID)
+                                   node_id_t maxNodeID,
+                                   const CSRGraph* out_csr = nullptr)
 {
   pvector<node_id_t> comp(maxNodeID);
 #pragma omp parallel for
   for (node_id_t n = 0; n < maxNodeID; n++) comp[n] = n;
 
+  RangeScheduler* scheduler = g.create_range_scheduler();
   std::atomic_bool change = true;
   int num_iter = 0;
   while (change)
   {
     change = false;
     num_iter++;
-#pragma omp parallel for
-    for (int i = 0; i < THREAD_NUM; i++)
+    scheduler->reset();
+#pragma omp parallel num_threads(THREAD_NUM)
     {
-      GraphBase* graph = g.create_graph_handle();
-      auto* out_nbd_cur = graph->get_outnbd_iter();
-      out_nbd_cur->set_key_range(g.get_key_range(i));
-
-      adjlist u;  // to keep it consistent with gapbs vars
-      out_nbd_cur->next(&u);
-      while (u.node_id != OutOfBand_ID_MAX)
+      GraphBase* graph = nullptr;
+      OutCursor* out_nbd_cur;
+      if (out_csr != nullptr)
+      {
+        out_nbd_cur = out_csr->get_outnbd_iter();
+      }
+      else
+      {
+        graph = g.create_graph_handle();
+        out_nbd_cur = graph->get_outnbd_iter();
+      }
+      key_range range;
+      adjlist_batch batch;
+      while (scheduler->next(omp_get_thread_num(), &range))
       {
-        for (node_id_t v : u.edgelist)
+        out_nbd_cur->reset();
+        out_nbd_cur->set_key_range(range);
+
+        // Whole runs of lists are decoded per call instead of one at a time
+        while (out_nbd_cur->next_batch(batch, BATCH_NODES, BATCH_EDGES) != 0)
         {
-          node_id_t comp_u = comp[u.node_id];
-          node_id_t comp_v = comp[v];
-          if (comp_u == comp_v) continue;
-          node_id_t high_comp = comp_u > comp_v ? comp_u : comp_v;
-          node_id_t low_comp = comp_u + (comp_v - high_comp);
-          if (high_comp == comp[high_comp])
+          for (size_t i = 0; i < batch.size(); i++)
           {
-            change = true;
-            comp[high_comp] = low_comp;
+            node_id_t u = batch.node_ids[i];  // keeps the gapbs var names
+            for (node_id_t v : batch.neighbors(i))
+            {
+              node_id_t comp_u = comp[u];
+              node_id_t comp_v = comp[v];
+              if (comp_u == comp_v) continue;
+              node_id_t high_comp = comp_u > comp_v ? comp_u : comp_v;
+              node_id_t low_comp = comp_u + (comp_v - high_comp);
+              if (high_comp == comp[high_comp])
+              {
+                change = true;
+                comp[high_comp] = low_comp;
+              }
+            }
           }
         }
-        u.clear();
-        out_nbd_cur->next(&u);
       }
       out_nbd_cur->close();
       delete out_nbd_cur;
-      graph->close(false);
+      if (graph != nullptr) graph->close(false);
     }
 #pragma omp parallel for
     for (node_id_t n = 0; n < maxNodeID; n++)
@@ -171,11 +194,23 @@ int main(int argc, char* argv[])
   t.stop();
   std::cout << "Graph loaded in " << t.t_micros() << std::endl;
 
+  CSRGraph* out_csr = nullptr;
+  if (opts.materialize_csr)
+  {
+    t.start();
+    out_csr = CSRFile::open_or_materialize(
+        graphEngine, opts.db_dir, opts.db_name, CSRDirection::OutEdges);
+    t.stop();
+    std::cout << "CSR loaded in " << t.t_secs() << " s, using "
+              << out_csr->memory_bytes() / (1024 * 1024) << " MB"
+              << std::endl;
+  }
+
   long double total_seconds = 0;
   for (int i = 0; i < opts.num_trials; i++)
   {
     t.start();
-    auto result = ShiloachVishkin(graphEngine, numNodes, maxNodeID);
+    auto result = ShiloachVishkin(graphEngine, numNodes, maxNodeID, out_csr);
     t.stop();
     std::cout << "CC took " << t.t_secs() << " s" << std::endl;
     total_seconds += t.t_secs();
@@ -184,5 +219,6 @@ int main(int argc, char* argv[])
   }
   std::cout << "Average CC took " << total_seconds / opts.num_trials << " s"
             << std::endl;
+  delete out_csr;
   return 0;
 }
\ No newline at end of file
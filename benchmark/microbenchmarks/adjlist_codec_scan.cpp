@@ -0,0 +1,139 @@
+#include <times.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "adj_list.h"
+#include "common_util.h"
+#include "graph_engine.h"
+
+/**
+ * Copies the out adjacency lists of an existing AdjList DB into a fresh DB
+ * for each adjlist codec and reports the on-disk size of the out adjlist
+ * table and the time for a full OutCursor scan over it.
+ */
+
+struct codec_result
+{
+  uint64_t table_bytes;
+  uint64_t num_edges;
+  long double scan_secs;
+};
+
+uint64_t copy_out_adjlists(AdjList &src, AdjList &dst)
+{
+  uint64_t num_edges = 0;
+  std::vector<node_id_t> empty;
+  OutCursor *out_cursor = src.get_outnbd_iter();
+  adjlist found;
+  out_cursor->next(&found);
+  while (found.node_id != OutOfBand_ID_MAX)
+  {
+    dst.add_node(found.node_id, empty, found.edgelist);
+    num_edges += found.edgelist.size();
+    out_cursor->next(&found);
+  }
+  out_cursor->close();
+  delete out_cursor;
+  return num_edges;
+}
+
+codec_result profile_codec(AdjList &src, graph_opts opts, AdjListCodec codec)
+{
+  codec_result result = {};
+  opts.adjlist_codec = codec;
+  opts.create_new = true;
+  opts.is_directed = true;
+  opts.read_optimize = false;
+  opts.db_name += "_codec_" + std::to_string(codec);
+  {
+    GraphEngine engine(1, opts);
+    AdjList graph(opts, engine.get_connection());
+    result.num_edges = copy_out_adjlists(src, graph);
+    graph.close(false);
+    engine.close_graph();
+  }
+  std::filesystem::path db_path(opts.db_dir + "/" + opts.db_name);
+  result.table_bytes =
+      std::filesystem::file_size(db_path / (OUT_ADJLIST + ".wt"));
+
+  // Reopen so the scan starts with an empty WT cache; the OS page cache is
+  // still warm from the load
+  opts.create_new = false;
+  GraphEngine engine(1, opts);
+  AdjList graph(opts, engine.get_connection());
+  OutCursor *out_cursor = graph.get_outnbd_iter();
+  uint64_t scanned = 0;
+  Times timer;
+  timer.start();
+  adjlist found;
+  out_cursor->next(&found);
+  while (found.node_id != OutOfBand_ID_MAX)
+  {
+    scanned += found.edgelist.size();
+    out_cursor->next(&found);
+  }
+  timer.stop();
+  assert(scanned == result.num_edges);
+  result.scan_secs = timer.t_secs();
+  out_cursor->close();
+  delete out_cursor;
+  graph.close(false);
+  engine.close_graph();
+  std::filesystem::remove_all(db_path);
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 3)
+  {
+    std::cout << "Usage: ./adjlist_codec_scan <wt_db_dir> <wt_db_name>"
+              << std::endl;
+    return 0;
+  }
+
+  graph_opts opts;
+  opts.create_new = false;
+  opts.optimize_create = false;
+  opts.is_directed = true;
+  opts.read_optimize = true;
+  opts.is_weighted = false;
+  opts.type = GraphType::Adj;
+  opts.db_dir = argv[1];
+  opts.db_name = argv[2];
+  opts.conn_config = "cache_size=10GB";
+  opts.stat_log = "./";
+
+  GraphEngine src_engine(1, opts);
+  AdjList src(opts, src_engine.get_connection());
+
+  std::ofstream outfile(opts.db_name + "_adjlist_codec_ubench.txt");
+  outfile << "codec,table_bytes,num_edges,bytes_per_edge,scan_secs,"
+             "size_vs_raw,scan_vs_raw"
+          << std::endl;
+
+  codec_result raw = {};
+  for (AdjListCodec codec : {AdjListCodec::Raw,
+                             AdjListCodec::DeltaVarint,
+                             AdjListCodec::BitPacked})
+  {
+    codec_result result = profile_codec(src, opts, codec);
+    if (codec == AdjListCodec::Raw)
+    {
+      raw = result;
+    }
+    outfile << codec << "," << result.table_bytes << "," << result.num_edges
+            << "," << (long double)result.table_bytes / result.num_edges << ","
+            << result.scan_secs << ","
+            << (long double)result.table_bytes / raw.table_bytes << ","
+            << result.scan_secs / raw.scan_secs << std::endl;
+  }
+  outfile.close();
+  src.close(false);
+  src_engine.close_graph();
+  return 0;
+}
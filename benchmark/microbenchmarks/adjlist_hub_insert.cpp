@@ -0,0 +1,119 @@
+#include <times.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "adj_list.h"
+#include "common_util.h"
+#include "graph_engine.h"
+
+/**
+ * Measures the AdjList edge insert throughput as the degree of a single hub
+ * node grows. The Blob layout rewrites the whole adjacency list on every
+ * insert while the Chunked layout only rewrites the tail chunk, so the Blob
+ * throughput is expected to fall off linearly with the hub degree.
+ */
+
+struct bucket_result
+{
+  degree_t hub_degree;
+  long double edges_per_sec;
+};
+
+std::vector<bucket_result> profile_hub_insert(graph_opts &opts,
+                                              degree_t max_degree)
+{
+  std::vector<bucket_result> results;
+  GraphEngine engine(1, opts);
+  AdjList graph(opts, engine.get_connection());
+
+  const node_id_t hub = 0;
+  degree_t degree = 0;
+  degree_t bucket_end = 1;
+  Times timer;
+  while (degree < max_degree)
+  {
+    // Each bucket doubles the hub degree: [degree, bucket_end)
+    degree_t bucket_start = degree;
+    timer.start();
+    for (; degree < bucket_end && degree < max_degree; degree++)
+    {
+      edge to_insert;
+      to_insert.src_id = hub;
+      to_insert.dst_id = degree + 1;
+      if (graph.add_edge(to_insert, false) != 0)
+      {
+        throw GraphException("Failed to insert edge (0, " +
+                             std::to_string(degree + 1) + ")");
+      }
+    }
+    timer.stop();
+    results.push_back(
+        {degree, (degree - bucket_start) / (timer.t_micros() / 1000000)});
+    bucket_end *= 2;
+  }
+  assert(graph.get_out_degree(hub) == max_degree);
+  graph.close(false);
+  engine.close_graph();
+  return results;
+}
+
+void usage()
+{
+  std::cout << "Usage: ./adjlist_hub_insert <wt_db_dir> <max_hub_degree> "
+               "[chunk_size]"
+            << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    usage();
+    return 0;
+  }
+
+  graph_opts opts;
+  opts.create_new = true;
+  opts.optimize_create = false;
+  opts.is_directed = true;
+  opts.read_optimize = false;
+  opts.is_weighted = false;
+  opts.type = GraphType::Adj;
+  opts.db_dir = argv[1];
+  opts.conn_config = "cache_size=10GB";
+  opts.stat_log = "./";
+  if (argc > 3)
+  {
+    long chunk_size = strtol(argv[3], nullptr, 0);
+    if (chunk_size <= 0)
+    {
+      usage();
+      return 1;
+    }
+    opts.adjlist_chunk_size = (degree_t)chunk_size;
+  }
+  auto max_degree = (degree_t)strtol(argv[2], nullptr, 0);
+
+  std::ofstream outfile("adjlist_hub_insert_ubench.txt");
+  outfile << "layout,chunk_size,hub_degree,edges_per_sec" << std::endl;
+
+  for (AdjListLayout layout : {AdjListLayout::Blob, AdjListLayout::Chunked})
+  {
+    opts.adjlist_layout = layout;
+    opts.db_name =
+        layout == AdjListLayout::Blob ? "hub_insert_blob" : "hub_insert_chunk";
+    for (auto &result : profile_hub_insert(opts, max_degree))
+    {
+      outfile << (layout == AdjListLayout::Blob ? "blob" : "chunked") << ","
+              << opts.adjlist_chunk_size << "," << result.hub_degree << ","
+              << result.edges_per_sec << std::endl;
+    }
+    std::filesystem::remove_all(opts.db_dir + "/" + opts.db_name);
+  }
+  outfile.close();
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include <omp.h>
+#include <times.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "adj_list.h"
+#include "common_util.h"
+#include "graph_engine.h"
+
+/**
+ * Runs a parallel scan of the out adjacency lists (the access pattern of the
+ * PR and CC kernels) once with one static key range per thread and once with
+ * the RangeScheduler, for both partition modes. Reports the busy time of
+ * every thread; the max/mean ratio is the tail the slowest thread adds.
+ */
+
+struct scan_result
+{
+  std::vector<long double> thread_secs;
+  uint64_t num_edges;
+};
+
+// Touches every neighbour so the scan cannot be skipped
+uint64_t scan_range(OutCursor *out_cursor, key_range range)
+{
+  uint64_t sum = 0;
+  out_cursor->reset();
+  out_cursor->set_key_range(range);
+  adjlist_view found;
+  out_cursor->next_view(&found);
+  while (found.node_id != OutOfBand_ID_MAX)
+  {
+    for (node_id_t v : found.edgelist) sum += v != OutOfBand_ID_MAX;
+    out_cursor->next_view(&found);
+  }
+  return sum;
+}
+
+scan_result profile_scan(GraphEngine &engine,
+                         RangeScheduler *scheduler,
+                         int thread_num)
+{
+  scan_result result;
+  result.thread_secs.resize(thread_num);
+  uint64_t num_edges = 0;
+  if (scheduler != nullptr) scheduler->reset();
+#pragma omp parallel reduction(+ : num_edges) num_threads(thread_num)
+  {
+    int tid = omp_get_thread_num();
+    GraphBase *graph = engine.create_graph_handle();
+    OutCursor *out_cursor = graph->get_outnbd_iter();
+    Times timer;
+    timer.start();
+    if (scheduler == nullptr)
+    {
+      num_edges += scan_range(out_cursor, engine.get_key_range(tid));
+    }
+    else
+    {
+      key_range range;
+      while (scheduler->next(tid, &range))
+      {
+        num_edges += scan_range(out_cursor, range);
+      }
+    }
+    timer.stop();
+    result.thread_secs[tid] = timer.t_secs();
+    out_cursor->close();
+    delete out_cursor;
+    graph->close(false);
+    delete graph;
+  }
+  result.num_edges = num_edges;
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    std::cout << "Usage: ./range_scheduler_balance <wt_db_dir> <wt_db_name> "
+                 "[ranges_per_thread]"
+              << std::endl;
+    return 0;
+  }
+
+  graph_opts opts;
+  opts.create_new = false;
+  opts.optimize_create = false;
+  opts.is_directed = true;
+  opts.read_optimize = true;
+  opts.is_weighted = false;
+  opts.type = GraphType::Adj;
+  opts.db_dir = argv[1];
+  opts.db_name = argv[2];
+  opts.conn_config = "cache_size=10GB";
+  opts.stat_log = "./";
+  int ranges_per_thread = argc > 3 ? (int)strtol(argv[3], nullptr, 0) : 64;
+  const int THREAD_NUM = omp_get_max_threads();
+
+  std::ofstream outfile(opts.db_name + "_range_scheduler_ubench.txt");
+  outfile << "partition_mode,scheduler,thread,secs" << std::endl;
+  std::ofstream summary(opts.db_name + "_range_scheduler_summary.txt");
+  summary << "partition_mode,scheduler,max_secs,mean_secs,max_vs_mean"
+          << std::endl;
+
+  for (PartitionMode mode :
+       {PartitionMode::IdRange, PartitionMode::DegreeBalanced})
+  {
+    opts.partition_mode = mode;
+    GraphEngine engine(THREAD_NUM, opts);
+    engine.calculate_thread_offsets();
+    RangeScheduler *scheduler =
+        engine.create_range_scheduler(ranges_per_thread);
+    uint64_t num_edges = 0;
+    for (bool use_scheduler : {false, true})
+    {
+      scan_result result =
+          profile_scan(engine, use_scheduler ? scheduler : nullptr, THREAD_NUM);
+      // Both schedules must visit every edge exactly once
+      if (num_edges == 0) num_edges = result.num_edges;
+      assert(num_edges == result.num_edges);
+
+      std::string mode_name =
+          mode == PartitionMode::IdRange ? "range" : "degree";
+      std::string sched_name = use_scheduler ? "dynamic" : "static";
+      long double total = 0;
+      for (int i = 0; i < THREAD_NUM; i++)
+      {
+        outfile << mode_name << "," << sched_name << "," << i << ","
+                << result.thread_secs[i] << std::endl;
+        total += result.thread_secs[i];
+      }
+      long double max_secs =
+          *std::max_element(result.thread_secs.begin(),
+                            result.thread_secs.end());
+      long double mean_secs = total / THREAD_NUM;
+      summary << mode_name << "," << sched_name << "," << max_secs << ","
+              << mean_secs << "," << max_secs / mean_secs << std::endl;
+    }
+    engine.close_graph();
+  }
+  outfile.close();
+  summary.close();
+  return 0;
+}
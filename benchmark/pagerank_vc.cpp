@@ -7,6 +7,7 @@
 #include "benchmark_definitions.h"
 #include "command_line.h"
 #include "common_util.h"
+#include "csr_file.h"
 #include "graph_engine.h"
 #include "mem_usage.h"
 #include "pvector.h"
@@ -15,31 +16,39 @@
 typedef float ScoreT;
 const float kDamp = 0.85;
 
+// If in_csr is set the iterations read the in edges from it instead of
+// WiredTiger.
 pvector<ScoreT> pagerank(GraphEngine& graph_engine,
                          int thread_num,
                          int max_iters,
                          node_id_t num_nodes,
                          node_id_t max_node_id,
-                         double epsilon = 0)
+                         double epsilon = 0,
+                         const CSRGraph* in_csr = nullptr)
 {
   pvector<ScoreT> src(max_node_id, 0);
   pvector<ScoreT> dst(max_node_id, 1 / num_nodes);
   pvector<node_id_t> deg(max_node_id, 0);
 
-#pragma omp parallel for
-  for (int i = 0; i < thread_num; i++)
+  RangeScheduler* scheduler = graph_engine.create_range_scheduler();
+#pragma omp parallel num_threads(thread_num)
   {
     GraphBase* graph = graph_engine.create_ro_graph_handle();
     NodeCursor* node_cursor = graph->get_node_iter();
-    node_cursor->set_key_range(graph_engine.get_key_range(i));
-
-    node found = {0};
-    node_cursor->next(&found);
-    while (found.id != OutOfBand_ID_MAX)
+    key_range range;
+    while (scheduler->next(omp_get_thread_num(), &range))
     {
-      //      std::cout << found.id << "\n";
-      deg[found.id] = found.out_degree;
+      node_cursor->reset();
+      node_cursor->set_key_range(range);
+
+      node found = {0};
       node_cursor->next(&found);
+      while (found.id != OutOfBand_ID_MAX)
+      {
+        //      std::cout << found.id << "\n";
+        deg[found.id] = found.out_degree;
+        node_cursor->next(&found);
+      }
     }
     node_cursor->close();
     graph->close(false);
@@ -47,37 +56,52 @@ pvector<ScoreT> pagerank(GraphEngine& graph_engine,
   for (int iter = 0; iter < max_iters; iter++)
   {
     double error = 0;
-#pragma omp parallel for reduction(+ : error)
-    for (int i = 0; i < thread_num; i++)
+    scheduler->reset();
+#pragma omp parallel reduction(+ : error) num_threads(thread_num)
     {
-      GraphBase* graph = graph_engine.create_ro_graph_handle();
-      InCursor* in_cursor = graph->get_innbd_iter();
-      in_cursor->set_key_range(graph_engine.get_key_range(i));
+      GraphBase* graph = nullptr;
+      InCursor* in_cursor;
+      if (in_csr != nullptr)
+      {
+        in_cursor = in_csr->get_innbd_iter();
+      }
+      else
+      {
+        graph = graph_engine.create_ro_graph_handle();
+        in_cursor = graph->get_innbd_iter();
+      }
+      key_range range;
+      while (scheduler->next(omp_get_thread_num(), &range))
+      {
+        in_cursor->reset();
+        in_cursor->set_key_range(range);
 
-      adjlist found;
-      in_cursor->next(&found);
+        adjlist_view found;
+        in_cursor->next_view(&found);
 
-      while (found.node_id != OutOfBand_ID_MAX)
-      {
-        //        std::cout << found.node_id << ": [";
-        ScoreT incoming_total = 0;
-        for (node_id_t v : found.edgelist)
+        while (found.node_id != OutOfBand_ID_MAX)
         {
-          incoming_total += src[v];
-          //          std::cout << v << " ";
+          //        std::cout << found.node_id << ": [";
+          ScoreT incoming_total = 0;
+          for (node_id_t v : found.edgelist)
+          {
+            incoming_total += src[v];
+            //          std::cout << v << " ";
+          }
+          //        std::cout << " ]" << std::endl;
+          ScoreT old_score = dst[found.node_id];
+          dst[found.node_id] =
+              (1 - kDamp) / num_nodes + kDamp * incoming_total;
+          error += fabs(dst[found.node_id] - old_score);
+          src[found.node_id] = dst[found.node_id] / deg[found.node_id];
+
+          in_cursor->next_view(&found);
         }
-        //        std::cout << " ]" << std::endl;
-        ScoreT old_score = dst[found.node_id];
-        dst[found.node_id] = (1 - kDamp) / num_nodes + kDamp * incoming_total;
-        error += fabs(dst[found.node_id] - old_score);
-        src[found.node_id] = dst[found.node_id] / deg[found.node_id];
-
-        found.clear();
-        in_cursor->next(&found);
       }
 
       in_cursor->close();
-      graph->close(false);
+      delete in_cursor;
+      if (graph != nullptr) graph->close(false);
     }
     printf(" %2d    %lf\n", iter, error);
     if (error < epsilon) break;
@@ -150,11 +174,28 @@ int main(int argc, char* argv[])
   Times t;
   t.start();
   GraphEngine graphEngine(THREAD_NUM, opts);
-  std::string checkpt = graphEngine.make_checkpoint();
   graphEngine.calculate_thread_offsets();
   t.stop();
   std::cout << "Graph loaded in " << t.t_secs() << "s" << std::endl;
 
+  // The handles read the checkpoint the snapshot was taken at
+  CSRGraph* in_csr = nullptr;
+  std::string checkpt;
+  if (opts.materialize_csr)
+  {
+    t.start();
+    in_csr = CSRFile::open_or_materialize(
+        graphEngine, opts.db_dir, opts.db_name, CSRDirection::InEdges);
+    t.stop();
+    checkpt = graphEngine.get_last_checkpoint();
+    std::cout << "CSR loaded in " << t.t_secs() << "s, using "
+              << in_csr->memory_bytes() / (1024 * 1024) << " MB" << std::endl;
+  }
+  else
+  {
+    checkpt = graphEngine.make_checkpoint();
+  }
+
   long double total_time = 0;
   for (int i = 0; i < opts.num_trials; i++)
   {
@@ -169,7 +210,8 @@ int main(int argc, char* argv[])
                                      opts.iterations,
                                      num_nodes,
                                      max_node_id,
-                                     opts.tolerance);
+                                     opts.tolerance,
+                                     in_csr);
     t.stop();
     cout << "PR  completed in : " << t.t_secs() << "s" << endl;
     total_time += t.t_secs();
@@ -177,6 +219,7 @@ int main(int argc, char* argv[])
       print_top_scores(score, num_nodes, g);
   }
   cout << "Average time: " << total_time / opts.num_trials << endl;
+  delete in_csr;
   graphEngine.close_graph();
   memory_usage.after();
   memory_usage.print_diff();
@@ -46,9 +46,9 @@ void pagerank(GraphBase *graph,
   {
     t.start();
     int index = 0;
-    adjlist found;
+    adjlist_view found;
     InCursor *in_cursor = graph->get_innbd_iter();
-    in_cursor->next(&found);
+    in_cursor->next_view(&found);
 
     while (found.node_id != OutOfBand_ID_MAX)
     {
@@ -60,7 +60,7 @@ void pagerank(GraphBase *graph,
       }
       ptr[index].p_rank[p_next] = constant + (dampness * sum);
       index++;
-      in_cursor->next(&found);
+      in_cursor->next_view(&found);
     }
     iter_count++;
 
@@ -12,42 +12,12 @@
 #include "graph_engine.h"
 #include "omp.h"
 #include "pvector.h"
+#include "sssp.h"
 #include "times.h"
 
 const int THREAD_NUM = omp_get_max_threads();
-const edgeweight_t DistInf = INT32_MAX;
 std::vector<node_id_t> random_nodes;
 
-pvector<edgeweight_t> sssp(GraphBase *graph,
-                           node_id_t source,
-                           node_id_t max_node_id)
-{
-  pvector<edgeweight_t> oracle_dist(max_node_id, DistInf);
-  oracle_dist[source] = 0;
-  typedef pair<edgeweight_t, node_id_t> WN;
-  std::priority_queue<WN, vector<WN>, greater<>> mq;
-  mq.emplace(0, source);
-  while (!mq.empty())
-  {
-    edgeweight_t tent_dist = mq.top().first;
-    node_id_t u = mq.top().second;
-    mq.pop();
-    if (tent_dist == oracle_dist[u])
-    {
-      for (edge e : graph->get_out_edges(u))
-      {
-        if (tent_dist + e.edge_weight < oracle_dist[e.dst_id])
-        {
-          oracle_dist[e.dst_id] = tent_dist + e.edge_weight;
-          // cerr << e.edge_weight << '\n';
-          mq.emplace(tent_dist + e.edge_weight, e.dst_id);
-        }
-      }
-    }
-  }
-  return oracle_dist;
-}
-
 int main(int argc, char *argv[])
 {
   std::cout << "Running SSSP" << std::endl;
@@ -94,7 +64,7 @@ int main(int argc, char *argv[])
   for (int i = 0; i < opts.num_trials; i++)
   {
     t.start();
-    sssp(graph, random_nodes.at(i), maxNodeID);
+    DijkstraSSSP(graph, random_nodes.at(i), maxNodeID + 1);
     t.stop();
 
     info.time_taken = t.t_secs();
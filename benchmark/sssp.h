@@ -0,0 +1,224 @@
+#ifndef SSSP_H
+#define SSSP_H
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+#include "graph_engine.h"
+#include "platform_atomics.h"
+#include "pvector.h"
+#include "times.h"
+
+/*
+Single-source shortest paths kernels shared by sssp.cpp, sssp_parallel.cpp
+and the tests. DijkstraSSSP is the sequential reference; DeltaStep is the
+parallel delta-stepping of the GAP Benchmark Suite (Scott Beamer):
+
+The frontier of the current bin is split across the threads. Each thread
+relaxes its share into thread-local bins, keeps draining its own copy of the
+current bin while it is small (kBinSizeThreshold), and then the threads agree
+on the smallest non-empty bin, which they copy into the shared frontier for
+the next round. Distances are updated with compare_and_swap.
+*/
+
+const edgeweight_t DistInf = std::numeric_limits<edgeweight_t>::max() / 2;
+const size_t kMaxBin = std::numeric_limits<size_t>::max() / 2;
+const size_t kBinSizeThreshold = 1000;
+// Frontiers at least this large are relaxed with get_out_edges_multi, which
+// walks the table in key order instead of seeking at random
+const size_t kMultiGetFrontier = 1 << 14;
+
+/**
+ * Distances from source to every ID in [0, num_ids), DistInf where there is
+ * no path. The weights are read through get_out_edges(), independently of
+ * the visitor DeltaStep uses.
+ */
+inline pvector<edgeweight_t> DijkstraSSSP(GraphBase *graph,
+                                          node_id_t source,
+                                          node_id_t num_ids)
+{
+  pvector<edgeweight_t> oracle_dist(num_ids, DistInf);
+  oracle_dist[source] = 0;
+  typedef std::pair<edgeweight_t, node_id_t> WN;
+  std::priority_queue<WN, std::vector<WN>, std::greater<>> mq;
+  mq.emplace(0, source);
+  while (!mq.empty())
+  {
+    edgeweight_t tent_dist = mq.top().first;
+    node_id_t u = mq.top().second;
+    mq.pop();
+    if (tent_dist == oracle_dist[u])
+    {
+      for (edge e : graph->get_out_edges(u))
+      {
+        if (tent_dist + e.edge_weight < oracle_dist[e.dst_id])
+        {
+          oracle_dist[e.dst_id] = tent_dist + e.edge_weight;
+          mq.emplace(tent_dist + e.edge_weight, e.dst_id);
+        }
+      }
+    }
+  }
+  return oracle_dist;
+}
+
+inline void RelaxEdge(node_id_t v,
+                      edgeweight_t new_dist,
+                      edgeweight_t delta,
+                      pvector<edgeweight_t> &dist,
+                      std::vector<std::vector<node_id_t>> &local_bins)
+{
+  edgeweight_t old_dist = dist[v];
+  while (new_dist < old_dist)
+  {
+    if (compare_and_swap(dist[v], old_dist, new_dist))
+    {
+      size_t dest_bin = new_dist / delta;
+      if (dest_bin >= local_bins.size()) local_bins.resize(dest_bin + 1);
+      local_bins[dest_bin].push_back(v);
+      break;
+    }
+    old_dist = dist[v];  // swap failed, recheck dist update & retry
+  }
+}
+
+// Relaxes the out edges of u while walking them, without allocating
+inline void RelaxEdges(GraphBase *g,
+                       node_id_t u,
+                       edgeweight_t delta,
+                       pvector<edgeweight_t> &dist,
+                       std::vector<std::vector<node_id_t>> &local_bins)
+{
+  edgeweight_t dist_u = dist[u];
+  g->for_each_out_edge(
+      u,
+      [&](node_id_t v, edgeweight_t weight)
+      { RelaxEdge(v, dist_u + weight, delta, dist, local_bins); });
+}
+
+inline void PrintStep(size_t step, long double millis, size_t count)
+{
+  printf("%5zu%11zu  %10.5Lf\n", step, count, millis);
+}
+
+/**
+ * Delta-stepping from source over the IDs [0, num_ids). The frontier holds
+ * at most one entry per relaxation, so num_edges bounds it.
+ */
+inline pvector<edgeweight_t> DeltaStep(GraphEngine &graph_engine,
+                                       node_id_t source,
+                                       edgeweight_t delta,
+                                       node_id_t num_ids,
+                                       edge_id_t num_edges,
+                                       int thread_num,
+                                       bool log_steps = true)
+{
+  pvector<edgeweight_t> dist(num_ids, DistInf);
+  dist[source] = 0;
+  pvector<node_id_t> frontier(std::max<edge_id_t>(num_edges, 1));
+  // two element arrays for double buffering curr=iter&1, next=(iter+1)&1
+  size_t shared_indexes[2] = {0, kMaxBin};
+  size_t frontier_tails[2] = {1, 0};
+  frontier[0] = source;
+  Times t;
+  t.start();
+#pragma omp parallel num_threads(thread_num)
+  {
+    GraphBase *graph = graph_engine.create_graph_handle();
+    std::vector<std::vector<node_id_t>> local_bins(0);
+    std::vector<node_id_t> active;  // this thread's share of a large frontier
+    size_t iter = 0;
+    while (shared_indexes[iter & 1] != kMaxBin)
+    {
+      size_t &curr_bin_index = shared_indexes[iter & 1];
+      size_t &next_bin_index = shared_indexes[(iter + 1) & 1];
+      size_t &curr_frontier_tail = frontier_tails[iter & 1];
+      size_t &next_frontier_tail = frontier_tails[(iter + 1) & 1];
+      edgeweight_t bin_start =
+          delta * static_cast<edgeweight_t>(curr_bin_index);
+      if (curr_frontier_tail >= kMultiGetFrontier)
+      {
+        // A contiguous share per thread, relaxed in key order
+        size_t tid = omp_get_thread_num();
+        size_t num_threads = omp_get_num_threads();
+        active.clear();
+        for (size_t i = curr_frontier_tail * tid / num_threads;
+             i < curr_frontier_tail * (tid + 1) / num_threads;
+             i++)
+        {
+          if (dist[frontier[i]] >= bin_start) active.push_back(frontier[i]);
+        }
+        graph->get_out_edges_multi(
+            active,
+            [&](node_id_t u, node_id_t v, edgeweight_t weight)
+            { RelaxEdge(v, dist[u] + weight, delta, dist, local_bins); });
+      }
+      else
+      {
+#pragma omp for nowait schedule(dynamic, 64)
+        for (size_t i = 0; i < curr_frontier_tail; i++)
+        {
+          node_id_t u = frontier[i];
+          if (dist[u] >= bin_start)
+            RelaxEdges(graph, u, delta, dist, local_bins);
+        }
+      }
+      while (curr_bin_index < local_bins.size() &&
+             !local_bins[curr_bin_index].empty() &&
+             local_bins[curr_bin_index].size() < kBinSizeThreshold)
+      {
+        std::vector<node_id_t> curr_bin_copy = local_bins[curr_bin_index];
+        local_bins[curr_bin_index].resize(0);
+        for (node_id_t u : curr_bin_copy)
+          RelaxEdges(graph, u, delta, dist, local_bins);
+      }
+      for (size_t i = curr_bin_index; i < local_bins.size(); i++)
+      {
+        if (!local_bins[i].empty())
+        {
+#pragma omp critical
+          next_bin_index = std::min(next_bin_index, i);
+          break;
+        }
+      }
+#pragma omp barrier
+#pragma omp single nowait
+      {
+        t.stop();
+        if (log_steps)
+        {
+          PrintStep(curr_bin_index, t.t_millis(), curr_frontier_tail);
+        }
+        t.start();
+        curr_bin_index = kMaxBin;
+        curr_frontier_tail = 0;
+      }
+      if (next_bin_index < local_bins.size())
+      {
+        size_t copy_start = fetch_and_add(next_frontier_tail,
+                                          local_bins[next_bin_index].size());
+        std::copy(local_bins[next_bin_index].begin(),
+                  local_bins[next_bin_index].end(),
+                  frontier.data() + copy_start);
+        local_bins[next_bin_index].resize(0);
+      }
+      iter++;
+#pragma omp barrier
+    }
+#pragma omp single
+    {
+      if (log_steps) printf("took %zu iterations\n", iter);
+    }
+    graph->close(false);
+  }
+  return dist;
+}
+
+#endif  // SSSP_H
@@ -36,16 +36,17 @@ size_t OrderedCount(GraphEngine &graph_engine, int THREAD_NUM = 1)
       for (node_id_t v : found.edgelist)
       {
         if (v > found.node_id) break;
-        std::vector<node_id_t> v_nbd = graph->get_out_nodes_id(v);
-        auto it = v_nbd.begin();
-        for (node_id_t w : found.edgelist)
+        // merge v's neighbours (w <= v) against u's as they are read
+        auto it = found.edgelist.begin();
+        auto end = found.edgelist.end();
+        auto count_common = [&](node_id_t w)
         {
-          if (w > v) break;
-          //                    while (it != v_nbd.end() && *it < w)
-          //                    it++; if (w == *it) total++;
-          while (it != v_nbd.end() && *it < w) it++;
-          if (it != v_nbd.end() && w == *it) total++;
-        }
+          if (w > v) return false;
+          while (it != end && *it < w) it++;
+          if (it != end && w == *it) total++;
+          return true;
+        };
+        graph->for_each_out_neighbor(v, count_common);
       }
       out_cursor->next(&found);
     }
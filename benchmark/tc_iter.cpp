@@ -21,11 +21,16 @@ const int THREAD_NUM = omp_get_max_threads();
 
 bool id_compare(node_id_t a, node_id_t b) { return (a < b); }
 
+// Pass sorted = true if both A and B are already sorted (OutCursor::is_sorted)
 std::vector<node_id_t> intersection_id(std::vector<node_id_t> &A,
-                                       std::vector<node_id_t> &B)
+                                       std::vector<node_id_t> &B,
+                                       bool sorted = false)
 {
-  std::sort(A.begin(), A.end(), id_compare);
-  std::sort(B.begin(), B.end(), id_compare);
+  if (!sorted)
+  {
+    std::sort(A.begin(), A.end(), id_compare);
+    std::sort(B.begin(), B.end(), id_compare);
+  }
   std::vector<node_id_t> ABintersection;
   auto A_iter = A.begin();
   auto B_iter = B.begin();
@@ -59,6 +64,7 @@ int64_t trust_tc_iter(GraphEngine &graph_engine)
     GraphBase *graph = graph_engine.create_graph_handle();
     OutCursor *out_cursor = graph->get_outnbd_iter();
     out_cursor->set_key_range(graph_engine.get_key_range(i));
+    bool sorted = out_cursor->is_sorted();
     adjlist found;
 
     out_cursor->next(&found);
@@ -72,7 +78,7 @@ int64_t trust_tc_iter(GraphEngine &graph_engine)
           continue;
         }
         std::vector<node_id_t> intersect =
-            intersection_id(found.edgelist, node_out_nbrhood);
+            intersection_id(found.edgelist, node_out_nbrhood, sorted);
         count += (int64_t)(intersect.size());
       }
 
@@ -96,6 +102,7 @@ int64_t cycle_tc_iter(GraphEngine &graph_engine)
     GraphBase *graph = graph_engine.create_graph_handle();
     OutCursor *out_cursor = graph->get_outnbd_iter();
     out_cursor->set_key_range(graph_engine.get_key_range(i));
+    bool sorted = out_cursor->is_sorted();
     adjlist found;
     out_cursor->next(&found);
     while (found.node_id != OutOfBand_ID_MAX)
@@ -116,7 +123,7 @@ int64_t cycle_tc_iter(GraphEngine &graph_engine)
               graph->get_in_nodes_id(found.node_id);
           if (u_in_nbrhood.empty()) continue;
           std::vector<node_id_t> intersect =
-              intersection_id(v_out_nbrhood, u_in_nbrhood);
+              intersection_id(v_out_nbrhood, u_in_nbrhood, sorted);
           for (auto w : intersect)
           {
             if (found.node_id < w)
@@ -24,11 +24,16 @@
  */
 bool id_compare(node_id_t a, node_id_t b) { return (a < b); }
 
+// Pass sorted = true if both A and B are already sorted (OutCursor::is_sorted)
 std::vector<node_id_t> intersection_id(std::vector<node_id_t> A,
-                                       std::vector<node_id_t> B)
+                                       std::vector<node_id_t> B,
+                                       bool sorted = false)
 {
-  std::sort(A.begin(), A.end(), id_compare);
-  std::sort(B.begin(), B.end(), id_compare);
+  if (!sorted)
+  {
+    std::sort(A.begin(), A.end(), id_compare);
+    std::sort(B.begin(), B.end(), id_compare);
+  }
   std::vector<node_id_t> ABintersection;
   std::vector<node_id_t>::iterator A_iter = A.begin();
   std::vector<node_id_t>::iterator B_iter = B.begin();
@@ -65,6 +70,7 @@ int64_t trust_tc_iter_parallel(const GraphEngine& graph_engine, int thread_num)
     adjlist found = {0};
 
     out_cursor->set_key_range(graph_engine.get_key_range(i));
+    bool sorted = out_cursor->is_sorted();
 
     out_cursor->next(&found);
     while (found.node_id != OutOfBand_ID_MAX)
@@ -74,7 +80,7 @@ int64_t trust_tc_iter_parallel(const GraphEngine& graph_engine, int thread_num)
       {
         std::vector<node_id_t> node_out_nbrhood = graph->get_out_nodes_id(node);
         std::vector<node_id_t> intersect =
-            intersection_id(out_nbrhood, node_out_nbrhood);
+            intersection_id(out_nbrhood, node_out_nbrhood, sorted);
         count += intersect.size();
       }
       out_cursor->next(&found);
@@ -100,6 +106,7 @@ int64_t cycle_tc_iter_parallel(const GraphEngine& graph_engine, int thread_num)
 
     in_cursor->set_key_range(graph_engine.get_key_range(i));
     out_cursor->set_key_range(graph_engine.get_key_range(i));
+    bool sorted = in_cursor->is_sorted() && out_cursor->is_sorted();
 
     in_cursor->next(&found);
     out_cursor->next(&found_out);
@@ -115,7 +122,7 @@ int64_t cycle_tc_iter_parallel(const GraphEngine& graph_engine, int thread_num)
           std::vector<node_id_t> node_out_nbrhood =
               graph->get_out_nodes_id(node);
           std::vector<node_id_t> intersect =
-              intersection_id(in_nbrhood, node_out_nbrhood);
+              intersection_id(in_nbrhood, node_out_nbrhood, sorted);
 
           for (node_id_t itsc : intersect)
           {
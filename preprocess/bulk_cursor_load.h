@@ -0,0 +1,571 @@
+#ifndef GRAPHAPI_BULK_CURSOR_LOAD_H
+#define GRAPHAPI_BULK_CURSOR_LOAD_H
+
+#include <tbb/concurrent_queue.h>
+
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+#include "bulk_insert_low_mem.h"
+
+/*
+Bulk cursor load path of bulk_insert_low_mem (-b).
+
+The out_aa, out_ab, ... (and in_...) files are cut from one edge list sorted
+by (src, dst), so reading them in order yields the adjacency lists by
+increasing node ID. Instead of inserting into the tables from one thread per
+file, every table gets a single writer that streams its keys, in order, into
+a WiredTiger bulk cursor. Bulk cursors build the B-tree pages directly and
+skip the page splits and reconciliation of the normal insert path, but need
+an empty table and strictly increasing keys.
+
+Parsing stays parallel: one parser per file reads and sorts the lists and
+hands them out in chunks. Every writer has its own bounded queue per file,
+so a parser can run at most BULK_QUEUE_CHUNKS chunks ahead of the slowest
+writer still reading its file. All writers move through the node IDs in the
+same order, so the slowest one can always make progress.
+
+Edge weights are a hash of (src, dst) rather than random, so that the out
+and in lists of an edge agree without looking one up in the other. Weights
+read from binary adjacency files are kept as they are.
+*/
+
+// Adjacency lists a parser hands to the writers at a time
+const size_t BULK_CHUNK_LISTS = 4096;
+// Chunks a parser can queue for a writer that has not read them yet
+const int BULK_QUEUE_CHUNKS = 8;
+
+// An empty chunk marks the end of a file
+using adjlist_chunk = std::shared_ptr<const std::vector<adjlist>>;
+using adjlist_chunk_queue = tbb::concurrent_bounded_queue<adjlist_chunk>;
+
+// The name of the tid-th file of the adjacency files starting with prefix
+std::string adj_file_name(const std::string &prefix, int tid)
+{
+  std::string filename = prefix;
+  filename.push_back((char)(97 + tid / 26));
+  filename.push_back((char)(97 + tid % 26));
+  return filename;
+}
+
+// Weight in [0,255] of the edge (src, dst)
+edgeweight_t bulk_edge_weight(node_id_t src, node_id_t dst)
+{
+  uint64_t x = (uint64_t)src * 0x9E3779B97F4A7C15ULL ^ (uint64_t)dst;
+  x ^= x >> 33;
+  x *= 0xFF51AFD7ED558CCDULL;
+  x ^= x >> 33;
+  return (edgeweight_t)(x & 0xFF);
+}
+
+/**
+ * @brief The adjacency files starting with prefix, parsed in parallel and
+ * read back in file order by every Reader taken with add_reader().
+ */
+class AdjFileStream
+{
+ public:
+  /**
+   * @brief Reads the lists of one writer in node ID order. A default
+   * constructed Reader is empty.
+   */
+  class Reader
+  {
+   public:
+    Reader() = default;
+    Reader(AdjFileStream *_stream, int _slot) : stream(_stream), slot(_slot) {}
+
+    // The next list, or nullptr at the end. Valid until the next call.
+    const adjlist *next()
+    {
+      if (stream == nullptr) return nullptr;
+      while (chunk == nullptr || pos == chunk->size())
+      {
+        if (file == stream->num_files) return nullptr;
+        stream->queue(file, slot).pop(chunk);
+        pos = 0;
+        if (chunk->empty()) file++;
+      }
+      const adjlist *adj = &(*chunk)[pos++];
+      if (started && adj->node_id <= last_id)
+      {
+        std::cerr << "The bulk load needs the files starting with "
+                  << stream->prefix << " sorted by node ID" << std::endl;
+        exit(1);
+      }
+      started = true;
+      last_id = adj->node_id;
+      return adj;
+    }
+
+   private:
+    AdjFileStream *stream = nullptr;
+    int slot = 0;
+    int file = 0;
+    adjlist_chunk chunk;
+    size_t pos = 0;
+    bool started = false;
+    node_id_t last_id = 0;
+  };
+
+  /**
+   * @param _prefix the file names up to the two letter suffix
+   * @param _num_files the number of files, out_aa onwards
+   * @param _is_weighted fill the weights of every list
+   * @param _reversed the files hold in lists, so the list of node v with
+   * neighbour u holds the edge (u, v)
+   */
+  AdjFileStream(std::string _prefix,
+                int _num_files,
+                bool _is_weighted,
+                bool _reversed)
+      : prefix(std::move(_prefix)),
+        num_files(_num_files),
+        is_weighted(_is_weighted),
+        reversed(_reversed)
+  {
+  }
+
+  ~AdjFileStream() { join(); }
+
+  // Only valid before start()
+  Reader add_reader() { return {this, num_readers++}; }
+
+  void start()
+  {
+    queues.resize((size_t)num_files * num_readers);
+    for (auto &q : queues)
+    {
+      q = std::make_unique<adjlist_chunk_queue>();
+      q->set_capacity(BULK_QUEUE_CHUNKS);
+    }
+    for (int i = 0; i < num_files; i++)
+    {
+      parsers.emplace_back(&AdjFileStream::parse_file, this, i);
+    }
+  }
+
+  void join()
+  {
+    for (std::thread &t : parsers)
+    {
+      if (t.joinable()) t.join();
+    }
+  }
+
+ private:
+  std::string prefix;
+  int num_files;
+  bool is_weighted;
+  bool reversed;
+  int num_readers = 0;
+  std::vector<std::unique_ptr<adjlist_chunk_queue>> queues;
+  std::vector<std::thread> parsers;
+
+  adjlist_chunk_queue &queue(int file, int slot)
+  {
+    return *queues[(size_t)file * num_readers + slot];
+  }
+
+  void push(int file, const adjlist_chunk &chunk)
+  {
+    for (int slot = 0; slot < num_readers; slot++)
+    {
+      queue(file, slot).push(chunk);
+    }
+  }
+
+  void parse_file(int file)
+  {
+    reader::AdjReader adj_reader(adj_file_name(prefix, file));
+    auto lists = std::make_shared<std::vector<adjlist>>();
+    adjlist adj;
+    while (adj_reader.get_next_adjlist(adj) == 0)
+    {
+      // Bulk cursors need strictly increasing keys
+      sort_unique(adj);
+      if (!is_weighted)
+      {
+        adj.weights.clear();
+      }
+      else if (adj.weights.empty())
+      {
+        for (node_id_t nbr : adj.edgelist)
+        {
+          adj.weights.push_back(reversed ? bulk_edge_weight(nbr, adj.node_id)
+                                         : bulk_edge_weight(adj.node_id, nbr));
+        }
+      }
+      // A copy, so the chunk does not keep the capacity reserved by adj
+      lists->push_back(adj);
+      adj.clear();
+      if (lists->size() == BULK_CHUNK_LISTS)
+      {
+        push(file, std::move(lists));
+        lists = std::make_shared<std::vector<adjlist>>();
+      }
+    }
+    if (!lists->empty()) push(file, std::move(lists));
+    push(file, std::make_shared<std::vector<adjlist>>());
+  }
+
+  // Sorts the neighbours and drops repeats, keeping the weights that binary
+  // files carry next to their neighbours
+  static void sort_unique(adjlist &adj)
+  {
+    if (adj.weights.size() != adj.edgelist.size())
+    {
+      adj.weights.clear();
+      std::sort(adj.edgelist.begin(), adj.edgelist.end());
+      adj.edgelist.erase(
+          std::unique(adj.edgelist.begin(), adj.edgelist.end()),
+          adj.edgelist.end());
+      return;
+    }
+    std::vector<std::pair<node_id_t, edgeweight_t>> pairs;
+    pairs.reserve(adj.edgelist.size());
+    for (size_t i = 0; i < adj.edgelist.size(); i++)
+    {
+      pairs.emplace_back(adj.edgelist[i], adj.weights[i]);
+    }
+    std::sort(pairs.begin(),
+              pairs.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    adj.edgelist.clear();
+    adj.weights.clear();
+    for (const auto &[nbr, weight] : pairs)
+    {
+      if (!adj.edgelist.empty() && adj.edgelist.back() == nbr) continue;
+      adj.edgelist.push_back(nbr);
+      adj.weights.push_back(weight);
+    }
+  }
+};
+
+// The out and in lists of one node; either can be missing
+typedef struct joined_adjlist
+{
+  node_id_t node_id = 0;
+  const adjlist *out = nullptr;
+  const adjlist *in = nullptr;
+
+  [[nodiscard]] degree_t out_degree() const
+  {
+    return out == nullptr ? 0 : out->edgelist.size();
+  }
+  [[nodiscard]] degree_t in_degree() const
+  {
+    return in == nullptr ? 0 : in->edgelist.size();
+  }
+} joined_adjlist;
+
+/**
+ * @brief Walks an out and an in Reader side by side, returning every node
+ * that has a list in either of them once.
+ */
+class JoinedReader
+{
+ public:
+  JoinedReader(AdjFileStream::Reader _out, AdjFileStream::Reader _in)
+      : out(std::move(_out)), in(std::move(_in))
+  {
+  }
+
+  // The next node; false at the end. Valid until the next call.
+  bool next(joined_adjlist &joined)
+  {
+    if (need_out) out_head = out.next();
+    if (need_in) in_head = in.next();
+    if (out_head == nullptr && in_head == nullptr) return false;
+    need_out = out_head != nullptr &&
+               (in_head == nullptr || out_head->node_id <= in_head->node_id);
+    need_in = in_head != nullptr &&
+              (out_head == nullptr || in_head->node_id <= out_head->node_id);
+    joined.out = need_out ? out_head : nullptr;
+    joined.in = need_in ? in_head : nullptr;
+    joined.node_id = need_out ? out_head->node_id : in_head->node_id;
+    return true;
+  }
+
+ private:
+  AdjFileStream::Reader out, in;
+  const adjlist *out_head = nullptr;
+  const adjlist *in_head = nullptr;
+  bool need_out = true;
+  bool need_in = true;
+};
+
+/**
+ * The neighbours of joined: the union of its out list and, if in_edges is
+ * set, its in list. Uses scratch when there is something to merge.
+ */
+const adjlist &joined_neighbours(const joined_adjlist &joined,
+                                 bool in_edges,
+                                 adjlist &scratch)
+{
+  const adjlist *in = in_edges ? joined.in : nullptr;
+  if (joined.out != nullptr && in != nullptr)
+  {
+    scratch = merge_adjlists(*joined.out, *in);
+    return scratch;
+  }
+  if (joined.out != nullptr) return *joined.out;
+  if (in != nullptr) return *in;
+  scratch.clear();
+  scratch.node_id = joined.node_id;
+  return scratch;
+}
+
+/**
+ * @brief A session and a bulk cursor on one table, which must be empty and
+ * get its keys in increasing order.
+ */
+typedef struct bulk_table_writer
+{
+  WT_SESSION *session = nullptr;
+  WT_CURSOR *cur = nullptr;
+  std::string table;
+  Times t;
+  size_t rows = 0;
+
+  bulk_table_writer(WT_CONNECTION *conn, std::string _table)
+      : table(std::move(_table))
+  {
+    int ret = conn->open_session(conn, nullptr, nullptr, &session);
+    if (ret == 0)
+    {
+      ret = session->open_cursor(
+          session, table.c_str(), nullptr, "bulk=true", &cur);
+    }
+    if (ret != 0)
+    {
+      std::cerr << "Error opening a bulk cursor to " << table << ": "
+                << wiredtiger_strerror(ret) << std::endl;
+      exit(1);
+    }
+    t.start();
+  }
+
+  ~bulk_table_writer()
+  {
+    // Closing the bulk cursor writes out the last pages
+    cur->close(cur);
+    session->close(session, nullptr);
+    t.stop();
+    std::cout << "Time taken to bulk load " << table << ": " << t.t_secs()
+              << "s (" << rows << " rows)" << std::endl;
+  }
+} bulk_table_writer;
+
+// Writes the adjlist record of every node into an adjlistout/adjlistin table
+void bulk_write_adjlists(WT_CONNECTION *conn,
+                         const std::string &table,
+                         JoinedReader lists)
+{
+  bulk_table_writer writer(conn, "table:" + table);
+  joined_adjlist joined;
+  adjlist scratch;
+  std::vector<uint8_t> buf;
+  while (lists.next(joined))
+  {
+    const adjlist &adj = joined_neighbours(joined, true, scratch);
+    CommonUtil::set_key(writer.cur, adj.node_id);
+    WT_ITEM item = AdjCodec::encode(opts.adjlist_codec, adj, buf);
+    writer.cur->set_value(writer.cur, adj.edgelist.size(), &item);
+    int ret = writer.cur->insert(writer.cur);
+    if (ret != 0)
+    {
+      PRINT_ADJ_ERROR(adj.node_id, ret, wiredtiger_strerror(ret))
+      continue;
+    }
+    writer.rows++;
+  }
+}
+
+// Writes the out edges into the AdjList edge table
+void bulk_write_edge_table(WT_CONNECTION *conn, AdjFileStream::Reader lists)
+{
+  bulk_table_writer writer(conn, "table:" + EDGE_TABLE);
+  int edge_count = 0;
+  while (const adjlist *adj = lists.next())
+  {
+    add_to_edge_table(
+        writer.cur, adj->node_id, adj->edgelist, adj->weights, &edge_count);
+  }
+  writer.rows = edge_count;
+}
+
+/**
+ * Writes the nodes into the AdjList node table and records the number of
+ * nodes and the smallest and largest node ID.
+ */
+void bulk_write_node_table(WT_CONNECTION *conn,
+                           JoinedReader lists,
+                           node_id_t *num_nodes,
+                           node_id_t *min_id,
+                           node_id_t *max_id)
+{
+  bulk_table_writer writer(conn, "table:" + NODE_TABLE);
+  joined_adjlist joined;
+  while (lists.next(joined))
+  {
+    if (writer.rows == 0) *min_id = joined.node_id;
+    *max_id = joined.node_id;
+    add_to_node_table(
+        writer.cur, joined.node_id, joined.in_degree(), joined.out_degree());
+    writer.rows++;
+  }
+  *num_nodes = writer.rows;
+}
+
+/**
+ * Writes a split edge-key table. With node_records every node gets its
+ * record ahead of its edges, as in edge_out. The edges are the out lists
+ * and, if in_edges is set, the in lists.
+ */
+void bulk_write_ekey_table(WT_CONNECTION *conn,
+                           const std::string &table,
+                           JoinedReader lists,
+                           bool node_records,
+                           bool in_edges)
+{
+  bulk_table_writer writer(conn, "table:" + table);
+  joined_adjlist joined;
+  adjlist scratch;
+  while (lists.next(joined))
+  {
+    if (node_records)
+    {
+      add_node_to_ekey(
+          writer.cur, joined.node_id, joined.in_degree(), joined.out_degree());
+      writer.rows++;
+    }
+    const adjlist &adj = joined_neighbours(joined, in_edges, scratch);
+    // ekey_set_key leaves node 0 unmapped, so an edge to it has the key of
+    // the node record. The insert path drops one of the two as a duplicate.
+    size_t first = node_records && !adj.edgelist.empty() &&
+                   adj.edgelist[0] == OutOfBand_ID_MIN;
+    for (size_t i = first; i < adj.edgelist.size(); i++)
+    {
+      CommonUtil::ekey_set_key(writer.cur, adj.node_id, adj.edgelist[i]);
+      writer.cur->set_value(writer.cur,
+                            adj.weights.empty() ? 0 : adj.weights[i],
+                            OutOfBand_ID_MAX);
+      int ret = writer.cur->insert(writer.cur);
+      if (ret != 0)
+      {
+        PRINT_EDGE_ERROR(adj.node_id, adj.edgelist[i], ret,
+                         wiredtiger_strerror(ret))
+        continue;
+      }
+      writer.rows++;
+    }
+  }
+}
+
+// Writes the split edge-key degree table
+void bulk_write_degree_table(WT_CONNECTION *conn, JoinedReader lists)
+{
+  bulk_table_writer writer(conn, "table:" + DEGREE_TABLE);
+  joined_adjlist joined;
+  while (lists.next(joined))
+  {
+    add_to_degree_table(
+        writer.cur, joined.node_id, joined.in_degree(), joined.out_degree());
+    writer.rows++;
+  }
+}
+
+typedef struct bulk_load_stats
+{
+  node_id_t num_nodes = 0;
+  node_id_t min_id = 0;
+  node_id_t max_id = 0;
+} bulk_load_stats;
+
+/**
+ * @brief Loads the AdjList and split edge-key DBs through bulk cursors, one
+ * writer thread per table. The tables must be empty and have no indices.
+ */
+bulk_load_stats bulk_load(const graph_opts &_opts)
+{
+  AdjFileStream out(
+      _opts.dataset + "/out_", _opts.num_threads, _opts.is_weighted, false);
+  AdjFileStream in(
+      _opts.dataset + "/in_", _opts.num_threads, _opts.is_weighted, true);
+  AdjFileStream::Reader none;
+  bulk_load_stats stats;
+
+  // Every Reader is taken before the parsers start
+  std::vector<std::thread> writers;
+  writers.emplace_back(bulk_write_edge_table, conn_adj, out.add_reader());
+  writers.emplace_back(bulk_write_node_table,
+                       conn_adj,
+                       JoinedReader(out.add_reader(), in.add_reader()),
+                       &stats.num_nodes,
+                       &stats.min_id,
+                       &stats.max_id);
+  if (_opts.is_directed)
+  {
+    writers.emplace_back(bulk_write_adjlists,
+                         conn_adj,
+                         OUT_ADJLIST,
+                         JoinedReader(out.add_reader(), none));
+    writers.emplace_back(bulk_write_adjlists,
+                         conn_adj,
+                         IN_ADJLIST,
+                         JoinedReader(none, in.add_reader()));
+    writers.emplace_back(bulk_write_ekey_table,
+                         conn_split_ekey,
+                         IN_EDGES,
+                         JoinedReader(none, in.add_reader()),
+                         false,
+                         true);
+  }
+  else
+  {
+    // An undirected graph keeps the in lists in the out tables
+    writers.emplace_back(bulk_write_adjlists,
+                         conn_adj,
+                         OUT_ADJLIST,
+                         JoinedReader(out.add_reader(), in.add_reader()));
+  }
+  writers.emplace_back(bulk_write_ekey_table,
+                       conn_split_ekey,
+                       OUT_EDGES,
+                       JoinedReader(out.add_reader(), in.add_reader()),
+                       true,
+                       !_opts.is_directed);
+  if (_opts.degree_table)
+  {
+    writers.emplace_back(bulk_write_degree_table,
+                         conn_split_ekey,
+                         JoinedReader(out.add_reader(), in.add_reader()));
+  }
+
+  out.start();
+  in.start();
+  for (std::thread &t : writers)
+  {
+    t.join();
+  }
+  return stats;
+}
+
+// Prints the size of every WiredTiger file in the DB directory db_path
+void report_table_sizes(const std::string &db_path)
+{
+  std::uintmax_t total = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(db_path))
+  {
+    if (entry.path().extension() != ".wt") continue;
+    total += entry.file_size();
+    std::cout << "Size of " << entry.path().string() << ": "
+              << entry.file_size() << " bytes" << std::endl;
+  }
+  std::cout << "Total size of " << db_path << ": " << total << " bytes"
+            << std::endl;
+}
+
+#endif  // GRAPHAPI_BULK_CURSOR_LOAD_H
@@ -1,5 +1,10 @@
 #include "bulk_insert_low_mem.h"
 
+#include "bulk_cursor_load.h"
+
+#include "csr_file.h"
+#include "graph_engine.h"
+
 void insert_edge_thread(int _tid, bool is_weighted = false)
 {
   int tid = _tid;
@@ -21,13 +26,25 @@ void insert_edge_thread(int _tid, bool is_weighted = false)
   int adj_count = 0;
   while (adj_reader.get_next_adjlist(adj_list) == 0)
   {
-    add_to_edgekey(
-        split_ekey_out.e_cur, adj_list.node_id, adj_list.edgelist, is_weighted);
+    // Both DBs, and the Weighted adjlist, get the same weights. Binary
+    // input files can already carry them.
+    if (!is_weighted)
+    {
+      adj_list.weights.clear();
+    }
+    else if (adj_list.weights.empty())
+    {
+      adj_list.weights = InsertWeights(adj_list.edgelist.size());
+    }
+    add_to_edgekey(split_ekey_out.e_cur,
+                   adj_list.node_id,
+                   adj_list.edgelist,
+                   adj_list.weights);
     add_to_edge_table(adj_obj.e_cur,
                       adj_list.node_id,
                       adj_list.edgelist,
-                      &edge_count,
-                      is_weighted);
+                      adj_list.weights,
+                      &edge_count);
 
     add_to_adjlist(adj_obj.cur, adj_list);
 
@@ -88,9 +105,22 @@ void insert_rev_edge_thread(int _tid, bool is_directed)
   adjlist adj_list;
   while (adj_reader.get_next_adjlist(adj_list) == 0)
   {
+    // The reverse lists carry the weights drawn in the out pass
+    if (!opts.is_weighted)
+    {
+      adj_list.weights.clear();
+    }
+    else if (adj_list.weights.empty())
+    {
+      adj_list.weights =
+          lookup_in_weights(adj_obj.e_cur, adj_list.node_id, adj_list.edgelist);
+    }
     // insert into ADJ: inadjlist table
     add_to_adjlist(adj_obj.cur, adj_list);
-    add_to_edgekey(split_ekey_in.e_cur, adj_list.node_id, adj_list.edgelist);
+    add_to_edgekey(split_ekey_in.e_cur,
+                   adj_list.node_id,
+                   adj_list.edgelist,
+                   adj_list.weights);
     // get the node degree from the map and update the in_degree
     {
       degree_map::accessor acc;
@@ -120,6 +150,16 @@ void insert_nodes()
         worker_sessions adj_node_obj(conn_adj, "", GraphType::Adj, false);
         worker_sessions split_ekey_node_obj(
             conn_split_ekey, "", GraphType::SplitEKey, false);
+        WT_CURSOR *degree_cur = nullptr;
+        if (opts.degree_table)
+        {
+          split_ekey_node_obj.session->open_cursor(
+              split_ekey_node_obj.session,
+              ("table:" + DEGREE_TABLE).c_str(),
+              nullptr,
+              nullptr,
+              &degree_cur);
+        }
         int count = 0;
         for (auto it = r.begin(); it != r.end(); it++)
         {
@@ -134,8 +174,16 @@ void insert_nodes()
                            it->first,
                            it->second.in_degree,
                            it->second.out_degree);
+          if (degree_cur != nullptr)
+          {
+            add_to_degree_table(degree_cur,
+                                it->first,
+                                it->second.in_degree,
+                                it->second.out_degree);
+          }
           count++;
         }
+        if (degree_cur != nullptr) degree_cur->close(degree_cur);
         //        std::cout << "inserted " << count << " nodes" << std::endl;
       });
   });
@@ -177,7 +225,9 @@ void dump_mdata(int key, char *key_str, WT_CURSOR *cursor)
             << std::endl;
 }
 
-void update_metadata(const graph_opts &_opts)
+void update_metadata(const graph_opts &_opts,
+                     node_id_t key_min,
+                     node_id_t key_max)
 {
   std::cout << "Number of nodes: " << _opts.num_nodes << std::endl;
   std::cout << "Count of node_degrees: " << node_degrees.size() << std::endl;
@@ -185,7 +235,6 @@ void update_metadata(const graph_opts &_opts)
   //           << std::endl;
   std::cout << "Number of edges: " << _opts.num_edges << std::endl;
 
-  auto [key_min, key_max] = get_min_max_key();
   std::cout << "Min node id: " << key_min << std::endl;
   std::cout << "Max node id: " << key_max << std::endl;
 
@@ -210,6 +259,33 @@ void update_metadata(const graph_opts &_opts)
                  sizeof(opts.num_edges),
                  cursor);
   }
+  {
+    // The adjlists were written sorted and with opts.adjlist_codec
+    worker_sessions obj(conn_adj, "table:metadata", GraphType::META, false);
+    bool sorted = true;
+    add_metadata(MetadataKey::sorted_adjlist,
+                 (char *)&sorted,
+                 sizeof(sorted),
+                 obj.metadata);
+    add_metadata(MetadataKey::adjlist_codec,
+                 (char *)&opts.adjlist_codec,
+                 sizeof(opts.adjlist_codec),
+                 obj.metadata);
+    // A Weighted codec only opens on a weighted graph
+    add_metadata(MetadataKey::is_weighted,
+                 (char *)&opts.is_weighted,
+                 sizeof(opts.is_weighted),
+                 obj.metadata);
+  }
+  if (opts.degree_table)
+  {
+    worker_sessions obj(
+        conn_split_ekey, "table:metadata", GraphType::META, false);
+    add_metadata(MetadataKey::degree_table,
+                 (char *)&opts.degree_table,
+                 sizeof(opts.degree_table),
+                 obj.metadata);
+  }
   for (auto conn :
        {conn_adj, conn_split_ekey})  //, conn_ekey, conn_split_ekey})
   {
@@ -222,6 +298,42 @@ void update_metadata(const graph_opts &_opts)
   }
 }
 
+/**
+ * @brief Reopens the AdjList DB that was just loaded and writes its CSR
+ * sidecar files into the DB directory, stamped with the checkpoint the
+ * snapshots were taken from.
+ */
+void write_csr_sidecars(graph_opts adj_opts, const std::string &conn_config)
+{
+  adj_opts.create_new = false;
+  adj_opts.type = GraphType::Adj;
+  adj_opts.db_name = adj_db_name(adj_opts);
+  adj_opts.conn_config = conn_config;
+  GraphEngine engine(adj_opts.num_threads, adj_opts);
+  engine.calculate_thread_offsets();
+  // Both directions are read from, and stamped with, the same checkpoint
+  std::string checkpoint = engine.make_checkpoint();
+
+  std::vector<CSRDirection> directions = {CSRDirection::OutEdges};
+  if (adj_opts.is_directed) directions.push_back(CSRDirection::InEdges);
+  for (CSRDirection direction : directions)
+  {
+    Times t;
+    t.start();
+    std::unique_ptr<CSRGraph> csr(engine.materialize_csr(
+        direction,
+        adj_opts.is_weighted && direction == CSRDirection::OutEdges,
+        checkpoint));
+    std::string path =
+        CSRFile::sidecar_path(adj_opts.db_dir, adj_opts.db_name, direction);
+    CSRFile::write(path, *csr, checkpoint, true);
+    t.stop();
+    std::cout << "Time taken to write " << path << ": " << t.t_secs() << "s"
+              << std::endl;
+  }
+  engine.close_graph();
+}
+
 int main(int argc, char *argv[])
 {
   InsertOpts params(argc, argv);
@@ -243,48 +355,95 @@ int main(int argc, char *argv[])
   conn_config += "," + stat_config;
 #endif
 
+  // The degree table mirrors the degrees in the node records
+  if (opts.degree_table && !opts.read_optimize)
+  {
+    std::cerr << "The degree table needs a read optimized DB (-r)"
+              << std::endl;
+    return -1;
+  }
+
+  // Weighted adjlists store the weights of the edge table next to the IDs
+  if (opts.adjlist_codec == AdjListCodec::Weighted && !opts.is_weighted)
+  {
+    std::cerr << "The weighted adjlist codec needs a weighted graph (-w)"
+              << std::endl;
+    return -1;
+  }
+
   // open connections to all three dbs
   make_connections(opts, conn_config);
+  if (opts.degree_table)
+  {
+    WT_SESSION *session;
+    conn_split_ekey->open_session(conn_split_ekey, nullptr, nullptr, &session);
+    SplitEdgeKey::create_degree_table(session);
+    session->close(session, nullptr);
+  }
 
   num_per_chunk = (int)(opts.num_edges / opts.num_threads);
   dump_config(opts, conn_config);
   std::cout << "dataset: " << opts.dataset << std::endl;
 
-  // We first work on the out edges. We will read the edges from the file and
-  // insert them into the edge table and the adjlist table
   std::cout << "weighted? " << opts.is_weighted << std::endl;
   Times t;
-  t.start();
-#pragma omp parallel for num_threads(opts.num_threads)
-  for (int i = 0; i < opts.num_threads; i++)
+  node_id_t key_min, key_max;
+  if (params.get_bulk_cursors())
   {
-    insert_edge_thread(i, opts.is_weighted);
+    t.start();
+    bulk_load_stats stats = bulk_load(opts);
+    t.stop();
+    std::cout << "Time taken to bulk load: " << t.t_secs() << "s" << std::endl;
+    std::cout << "Number of loaded nodes: " << stats.num_nodes << std::endl;
+    key_min = stats.min_id;
+    key_max = stats.max_id;
   }
+  else
+  {
+    // We first work on the out edges. We will read the edges from the file
+    // and insert them into the edge table and the adjlist table
+    t.start();
+#pragma omp parallel for num_threads(opts.num_threads)
+    for (int i = 0; i < opts.num_threads; i++)
+    {
+      insert_edge_thread(i, opts.is_weighted);
+    }
 
-  t.stop();
-  std::cout << "Time taken to insert edges: " << t.t_secs() << "s" << std::endl;
-  t.start();
+    t.stop();
+    std::cout << "Time taken to insert edges: " << t.t_secs() << "s"
+              << std::endl;
+    t.start();
 #pragma omp parallel for num_threads(opts.num_threads)
-  for (int i = 0; i < opts.num_threads; i++)
-  {
-    insert_rev_edge_thread(i, opts.is_directed);
-  }
-  t.stop();
-  std::cout << "Time taken to insert rev edges: " << t.t_secs() << "s"
-            << std::endl;
-  // insert nodes into the node table
-  t.start();
+    for (int i = 0; i < opts.num_threads; i++)
+    {
+      insert_rev_edge_thread(i, opts.is_directed);
+    }
+    t.stop();
+    std::cout << "Time taken to insert rev edges: " << t.t_secs() << "s"
+              << std::endl;
+    // insert nodes into the node table
+    t.start();
 
-  insert_nodes();
+    insert_nodes();
 
-  t.stop();
-  std::cout << "Time taken to insert nodes: " << t.t_secs() << "s" << std::endl;
-  // debug_dump_nodes();
+    t.stop();
+    std::cout << "Time taken to insert nodes: " << t.t_secs() << "s"
+              << std::endl;
+    // debug_dump_nodes();
+    std::tie(key_min, key_max) = get_min_max_key();
+  }
 
-  update_metadata(opts);
+  update_metadata(opts, key_min, key_max);
 
   conn_adj->close(conn_adj, nullptr);
   conn_split_ekey->close(conn_split_ekey, nullptr);
+  report_table_sizes(opts.db_dir + "/" + adj_db_name(opts));
+  report_table_sizes(opts.db_dir + "/" + split_ekey_db_name(opts));
+
+  if (params.get_write_csr())
+  {
+    write_csr_sidecars(opts, "cache_size=10GB");
+  }
 
   return (EXIT_SUCCESS);
 }
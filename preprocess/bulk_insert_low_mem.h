@@ -10,6 +10,7 @@
 #include <tbb/parallel_reduce.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <random>
@@ -203,53 +204,94 @@ int check_cursors(worker_sessions &info)
   return 0;
 }
 
-// Overwrites existing weights with random from [1,255]
-int *InsertWeights(size_t n)
+// Random weights from [0,255] for n edges
+std::vector<edgeweight_t> InsertWeights(size_t n)
 {
   // Set up random number generator
   std::random_device rd;
   std::mt19937 gen(rd());
-  std::uniform_int_distribution<int> distribution(0, 255);
+  std::uniform_int_distribution<edgeweight_t> distribution(0, 255);
 
-  // Allocate memory for the array
-  int *randomArray = new int[n];
-
-  // Fill the array with random values
-  for (int i = 0; i < n; ++i)
+  std::vector<edgeweight_t> weights(n);
+  for (size_t i = 0; i < n; ++i)
   {
-    randomArray[i] = distribution(gen);
+    weights[i] = distribution(gen);
   }
+  return weights;
+}
 
-  return randomArray;
+/**
+ * Union of the sorted adjlists a and b; an ID in both keeps its weight from
+ * a. Weights are carried along only if both lists have them.
+ */
+adjlist merge_adjlists(const adjlist &a, const adjlist &b)
+{
+  bool weighted = !a.weights.empty() && !b.weights.empty();
+  adjlist merged(a.node_id, 0);
+  size_t i = 0, j = 0;
+  while (i < a.edgelist.size() || j < b.edgelist.size())
+  {
+    bool take_a = j == b.edgelist.size() ||
+                  (i < a.edgelist.size() && a.edgelist[i] <= b.edgelist[j]);
+    if (take_a)
+    {
+      if (j < b.edgelist.size() && b.edgelist[j] == a.edgelist[i]) j++;
+      if (weighted) merged.weights.push_back(a.weights[i]);
+      merged.edgelist.push_back(a.edgelist[i++]);
+    }
+    else
+    {
+      if (weighted) merged.weights.push_back(b.weights[j]);
+      merged.edgelist.push_back(b.edgelist[j++]);
+    }
+  }
+  return merged;
 }
 
 int add_to_adjlist(WT_CURSOR *adjcur, adjlist &adj)
 {
+  bool weighted = opts.adjlist_codec == AdjListCodec::Weighted;
+  if (weighted)
+  {
+    // an edge without a weight gets 0
+    adj.weights.resize(adj.edgelist.size(), 0);
+  }
+  // Always write sorted adjacency lists so that the DB can be opened with
+  // sorted_adjlist and the set_union below sees sorted input.
+  if (!std::is_sorted(adj.edgelist.begin(), adj.edgelist.end()))
+  {
+    weighted ? AdjCodec::sort_weighted(adj.edgelist, adj.weights)
+             : std::sort(adj.edgelist.begin(), adj.edgelist.end());
+  }
   CommonUtil::set_key(adjcur, adj.node_id);
   int ret;
+  std::vector<uint8_t> buf;
   if (adjcur->search(adjcur) == 0)
   {
     adjlist old_adj;
-    CommonUtil::record_to_adjlist(adjcur, &old_adj);
+    CommonUtil::record_to_adjlist(adjcur, &old_adj, opts.adjlist_codec);
     // merge the edgelists and remove duplicates
-    std::vector<node_id_t> new_edgelist;
-    std::set_union(adj.edgelist.begin(),
-                   adj.edgelist.end(),
-                   old_adj.edgelist.begin(),
-                   old_adj.edgelist.end(),
-                   std::back_inserter(new_edgelist));
-    WT_ITEM item;
-    item.data = new_edgelist.data();
-    item.size = new_edgelist.size() * sizeof(node_id_t);
-    adjcur->set_value(adjcur, new_edgelist.size(), &item);
+    adjlist merged;
+    if (weighted)
+    {
+      merged = merge_adjlists(adj, old_adj);
+    }
+    else
+    {
+      std::set_union(adj.edgelist.begin(),
+                     adj.edgelist.end(),
+                     old_adj.edgelist.begin(),
+                     old_adj.edgelist.end(),
+                     std::back_inserter(merged.edgelist));
+    }
+    WT_ITEM item = AdjCodec::encode(opts.adjlist_codec, merged, buf);
+    adjcur->set_value(adjcur, merged.edgelist.size(), &item);
     ret = adjcur->update(adjcur);
   }
   else
   {
-    WT_ITEM item;
-    item.data = adj.edgelist.data();
-    item.size = adj.edgelist.size() * sizeof(node_id_t);
-    // space += adj.edgelist.size() * sizeof(node_id_t);
+    WT_ITEM item = AdjCodec::encode(opts.adjlist_codec, adj, buf);
+    // space += item.size;
     adjcur->set_value(adjcur, adj.edgelist.size(), &item);
     ret = adjcur->insert(adjcur);
   }
@@ -261,63 +303,74 @@ int add_to_adjlist(WT_CURSOR *adjcur, adjlist &adj)
   return ret;
 }
 
+// Edges past the end of weights (all of them for an unweighted graph) get 0
 int add_to_edge_table(WT_CURSOR *cur,
                       const node_id_t node_id,
                       const std::vector<node_id_t> &edgelist,
-                      int *edge_count,
-                      bool is_weighted = false)
+                      const std::vector<edgeweight_t> &weights,
+                      int *edge_count)
 {
-  int *weight = InsertWeights(edgelist.size());
-
-  int i = 0;
-  for (node_id_t dst : edgelist)
+  for (size_t i = 0; i < edgelist.size(); i++)
   {
-    CommonUtil::set_key(cur, node_id, dst);
-    if (is_weighted)
-      cur->set_value(cur, weight[i], OutOfBand_ID_MAX);
-    else
-      cur->set_value(cur, 0, OutOfBand_ID_MAX);
+    CommonUtil::set_key(cur, node_id, edgelist[i]);
+    cur->set_value(
+        cur, i < weights.size() ? weights[i] : 0, OutOfBand_ID_MAX);
     int ret = cur->insert(cur);
     if (ret != 0)
     {
-      PRINT_EDGE_ERROR(node_id, dst, ret, wiredtiger_strerror(ret))
-      delete[] weight;
+      PRINT_EDGE_ERROR(node_id, edgelist[i], ret, wiredtiger_strerror(ret))
       return ret;
     }
-    i++;
   }
   *edge_count += edgelist.size();
-  delete[] weight;
   return 0;
 }
 
 int add_to_edgekey(WT_CURSOR *ekey_cur,
                    const node_id_t node_id,
                    const std::vector<node_id_t> &edgelist,
-                   bool is_weighted = false)
+                   const std::vector<edgeweight_t> &weights)
 {
   node_id_t src = node_id;
-  int *weight = InsertWeights(edgelist.size());
-  for (int i = 0; i < edgelist.size(); i++)
+  for (size_t i = 0; i < edgelist.size(); i++)
   {
     CommonUtil::ekey_set_key(ekey_cur, src, edgelist[i]);
-    if (is_weighted)
-      ekey_cur->set_value(ekey_cur, weight[i], OutOfBand_ID_MAX);
-    else
-      ekey_cur->set_value(ekey_cur, 0, OutOfBand_ID_MAX);
+    ekey_cur->set_value(
+        ekey_cur, i < weights.size() ? weights[i] : 0, OutOfBand_ID_MAX);
 
     int ret = ekey_cur->insert(ekey_cur);
     if (ret != 0)
     {
       PRINT_EDGE_ERROR(node_id, edgelist[i], ret, wiredtiger_strerror(ret))
-      delete[] weight;
       return ret;
     }
   }
-  delete[] weight;
   return 0;
 }
 
+/**
+ * Looks up the weight of the edge from every ID in edgelist to node_id in the
+ * AdjList edge table, which the out pass has already filled. Missing edges
+ * get 0.
+ */
+std::vector<edgeweight_t> lookup_in_weights(
+    WT_CURSOR *edge_cur,
+    const node_id_t node_id,
+    const std::vector<node_id_t> &edgelist)
+{
+  std::vector<edgeweight_t> weights(edgelist.size(), 0);
+  for (size_t i = 0; i < edgelist.size(); i++)
+  {
+    CommonUtil::set_key(edge_cur, edgelist[i], node_id);
+    if (edge_cur->search(edge_cur) == 0)
+    {
+      edge_cur->get_value(edge_cur, &weights[i]);
+    }
+  }
+  edge_cur->reset(edge_cur);
+  return weights;
+}
+
 inline int add_to_node_table(WT_CURSOR *cur,
                              const node_id_t id,
                              const degree_t in_degree,
@@ -365,6 +418,22 @@ int add_node_to_ekey(WT_CURSOR *ekey_cur,
   return ret;
 }
 
+int add_to_degree_table(WT_CURSOR *degree_cur,
+                        const node_id_t id,
+                        const degree_t in_degree,
+                        const degree_t out_degree)
+{
+  degree_cur->set_key(degree_cur, (uint64_t)MAKE_EKEY(id));
+  degree_cur->set_value(degree_cur, in_degree, out_degree);
+  int ret = degree_cur->insert(degree_cur);
+  if (ret != 0)
+  {
+    std::cerr << "Error inserting degrees of node " << id << ": "
+              << wiredtiger_strerror(ret) << std::endl;
+  }
+  return ret;
+}
+
 void debug_print_edges(WT_CURSOR *cur,
                        GraphType type,
                        const std::string &filename)
@@ -396,7 +465,8 @@ void debug_print_edges(WT_CURSOR *cur,
   file.close();
 }
 
-void make_connections(graph_opts &_opts, const std::string &conn_config)
+// The "rd_" style infix that tells the read optimized and directed DBs apart
+std::string db_name_middle(const graph_opts &_opts)
 {
   std::string middle;
   if (_opts.read_optimize)
@@ -411,6 +481,23 @@ void make_connections(graph_opts &_opts, const std::string &conn_config)
   {
     middle += "_";
   }
+  return middle;
+}
+
+// The name of the AdjList DB the loader writes, relative to _opts.db_dir
+std::string adj_db_name(const graph_opts &_opts)
+{
+  return "adj_" + db_name_middle(_opts) + _opts.db_name;
+}
+
+// The name of the split edge-key DB the loader writes
+std::string split_ekey_db_name(const graph_opts &_opts)
+{
+  return "split_ekey_" + db_name_middle(_opts) + _opts.db_name;
+}
+
+void make_connections(graph_opts &_opts, const std::string &conn_config)
+{
   // make sure the dataset is a directory, if not, extract the directory name
   // and use it
   if (_opts.dataset.back() != '/')
@@ -423,7 +510,7 @@ void make_connections(graph_opts &_opts, const std::string &conn_config)
   }
   std::cout << "Dataset: " << _opts.dataset << std::endl;
 
-  std::string _db_name = _opts.db_dir + "/adj_" + middle + _opts.db_name;
+  std::string _db_name = _opts.db_dir + "/" + adj_db_name(_opts);
   if (wiredtiger_open(_db_name.c_str(),
                       nullptr,
                       const_cast<char *>(conn_config.c_str()),
@@ -434,7 +521,7 @@ void make_connections(graph_opts &_opts, const std::string &conn_config)
   }
 
   // open split ekey connection
-  _db_name = _opts.db_dir + "/split_ekey_" + middle + _opts.db_name;
+  _db_name = _opts.db_dir + "/" + split_ekey_db_name(_opts);
   if (wiredtiger_open(_db_name.c_str(),
                       nullptr,
                       const_cast<char *>(conn_config.c_str()),
@@ -483,6 +570,7 @@ void dump_config(const graph_opts &_opts, const std::string &conn_config)
   std::cout << "Num edges: " << _opts.num_edges << std::endl;
   std::cout << "Num nodes: " << _opts.num_nodes << std::endl;
   std::cout << "Num threads: " << _opts.num_threads << std::endl;
+  std::cout << "Adjlist codec: " << _opts.adjlist_codec << std::endl;
   std::cout << "DB dir: " << _opts.db_dir << std::endl;
   std::cout << "DB name: " << _opts.db_name << std::endl;
   std::cout << "DB config: " << conn_config << std::endl;
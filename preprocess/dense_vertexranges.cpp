@@ -4,130 +4,183 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <mutex>
-#include <shared_mutex>
-#include <sstream>
-#include <unordered_map>
-
-#include "common_util.h"
-#include "parallel_hashmap/phmap.h"
-#define MAPNAME phmap::parallel_flat_hash_map
-#define NMSP phmap
-#define NUM_THREADS 16
-#define MTX std::mutex
-#define EXTRAARGS                                                     \
-  , NMSP::priv::hash_default_hash<K>, NMSP::priv::hash_default_eq<K>, \
-      std::allocator<std::pair<const K, V>>, 4, MTX
+#include <iterator>
+#include <vector>
+
+#include "graph_file.h"
+#include "mapped_text.h"
+
+/*
+Dense ID remapping of an edge list.
+
+Every thread parses its own newline aligned byte range of the mmapped edge
+file, collects the node IDs it sees and sorts them without repeats. The
+sorted lists are merged pairwise in parallel into dense_ids, the sorted old
+IDs of the graph: the new ID of a node is the rank of its old ID there. The
+threads then parse their ranges again and write their edges with the new
+IDs, as text or as binary edge files (--binary).
 
-template <class K, class V>
-using HashT = MAPNAME<K, V EXTRAARGS>;
-using hash_t = HashT<node_id_t, node_id_t>;
+dense_ids is kept next to the dataset as the binary IdList dense_map.bin,
+so the old ID of new ID i is entry i and the new ID of an old one is found
+by binary search. graph_convert --kind map turns it into text.
+*/
 
-double num_edges;
-double num_nodes;
+#define NUM_THREADS 16
+// Old IDs are looked up in a direct table if the largest is below this many
+// times the number of nodes, and by binary search in dense_ids otherwise
+#define DIRECT_MAP_FACTOR 4
+
+double expected_edges;
+double expected_nodes;
 std::string dataset;
-[[maybe_unused]] std::string out_dir;
 bool map_exit = false;
+bool binary_out = false;
 
-hash_t remap;
+std::vector<node_id_t> dense_ids;
+std::vector<node_id_t> direct_map;
 
-int64_t construct_vertex_mapping(node_id_t beg, node_id_t end)
+// The sorted node IDs, without repeats, of the edges in the byte range
+// [beg, end)
+std::vector<node_id_t> collect_ids(reader::MappedText &edges,
+                                   size_t beg,
+                                   size_t end)
 {
-  std::string filename = dataset + "_nodes";
-  std::ifstream nodefile(filename.c_str());
-  int64_t line = 0;
+  std::vector<node_id_t> ids;
+  reader::LineParser lines(edges.begin() + beg, edges.begin() + end);
+  while (lines.next_line())
+  {
+    node_id_t src, dst;
+    if (!lines.next(src) || !lines.next(dst))
+    {
+      continue;
+    }
+    ids.push_back(src);
+    ids.push_back(dst);
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
 
-  if (nodefile.is_open())
+// Merges sorted ID lists pairwise, a level of the merge tree at a time
+std::vector<node_id_t> merge_ids(std::vector<std::vector<node_id_t>> lists)
+{
+  while (lists.size() > 1)
   {
-    std::string tp;
-    while (getline(nodefile, tp) && line < end)
+    size_t pairs = lists.size() / 2;
+    std::vector<std::vector<node_id_t>> merged(pairs + lists.size() % 2);
+#pragma omp parallel for num_threads(NUM_THREADS)
+    for (size_t p = 0; p < pairs; p++)
     {
-      if (line < beg)
-      {
-        line++;
-        continue;
-      }
-      else
-      {
-        node_id_t val;
-        std::stringstream s_str(tp);
-        s_str >> val;
-        remap[val] = line;
-        line++;
-      }
+      std::vector<node_id_t> &a = lists[2 * p];
+      std::vector<node_id_t> &b = lists[2 * p + 1];
+      merged[p].reserve(a.size() + b.size());
+      std::set_union(a.begin(),
+                     a.end(),
+                     b.begin(),
+                     b.end(),
+                     std::back_inserter(merged[p]));
+      std::vector<node_id_t>().swap(a);
+      std::vector<node_id_t>().swap(b);
     }
-    nodefile.close();
+    if (lists.size() % 2 == 1) merged.back() = std::move(lists.back());
+    lists = std::move(merged);
   }
-  else
+  return lists.empty() ? std::vector<node_id_t>() : std::move(lists[0]);
+}
+
+void build_lookup()
+{
+  if (dense_ids.empty() ||
+      dense_ids.back() >= DIRECT_MAP_FACTOR * dense_ids.size())
   {
-    std::cout << "failed;";
+    return;
+  }
+  direct_map.resize((size_t)dense_ids.back() + 1);
+#pragma omp parallel for num_threads(NUM_THREADS)
+  for (size_t i = 0; i < dense_ids.size(); i++)
+  {
+    direct_map[dense_ids[i]] = (node_id_t)i;
   }
-  return line;
 }
 
-int64_t convert_edge_list(node_id_t beg_offset,
-                          node_id_t end_offset,
-                          node_id_t t_id)
+inline node_id_t new_id(node_id_t old_id)
 {
-  std::ifstream edgefile(dataset.c_str());
+  if (!direct_map.empty()) return direct_map[old_id];
+  return (node_id_t)(std::lower_bound(
+                         dense_ids.begin(), dense_ids.end(), old_id) -
+                     dense_ids.begin());
+}
 
+// Rewrites the edges in the byte range [beg, end) with the new IDs
+int64_t convert_edge_list(reader::MappedText &edges,
+                          size_t beg,
+                          size_t end,
+                          int t_id)
+{
   char c = (char)(97 + t_id);
   std::string out_filename = dataset + "_edges";
-
   out_filename.push_back('a');
   out_filename.push_back(c);
-  std::ofstream outfile(out_filename.c_str());
-  node_id_t line = 0;
-  if (edgefile.is_open())
+
+  reader::LineParser lines(edges.begin() + beg, edges.begin() + end);
+  int64_t line = 0;
+  node_id_t src, dst;
+  if (binary_out)
   {
-    std::string tp;
-    while (getline(edgefile, tp) && line < end_offset)
+    GraphFileWriter outfile(out_filename, GraphFileKind::EdgeList, false);
+    while (lines.next_line())
     {
-      if (line < beg_offset)
+      if (!lines.next(src) || !lines.next(dst))
       {
-        line++;
         continue;
       }
-      else
-      {
-        node_id_t src, dst;
-        std::stringstream s_str(tp);
-        s_str >> src;
-        s_str >> dst;
-        outfile << remap[src] << "\t" << remap[dst] << "\n";
-
-        line++;
-      }
+      outfile.add_edge(new_id(src), new_id(dst));
+      line++;
     }
-    edgefile.close();
     outfile.close();
+    return line;
   }
+
+  std::ofstream outfile(out_filename.c_str());
+  while (lines.next_line())
+  {
+    if (!lines.next(src) || !lines.next(dst))
+    {
+      continue;
+    }
+    outfile << new_id(src) << "\t" << new_id(dst) << "\n";
+    line++;
+  }
+  outfile.close();
   return line;
 }
 
 void help()
 {
-  std::cout << "Usage: ./dense_vertexranges --edges <num_edges> --nodes "
-               "<num_nodes> --file <dataset>"
+  std::cout << "Usage: ./dense_vertexranges --file <dataset> [--edges "
+               "<num_edges>] [--nodes <num_nodes>] [--make-map] [--binary]"
             << std::endl;
   std::cout << "This program will generate a dense vertexrange file for "
                "the graph and produce a new graph with this new mapping. "
-               "This assumes that the nodes file has been created "
-               "<preprocess.sh does that> "
+               "The map is written to dense_map.bin and the new node IDs to "
+               "<dataset>_nodes; --make-map stops there. --binary writes the "
+               "new edge files in the binary graph file format."
             << std::endl;
 }
 
 int main(int argc, char *argv[])
 {
-  std::string logfile;
   static struct option long_opts[] = {{"edges", required_argument, 0, 'e'},
                                       {"nodes", required_argument, 0, 'n'},
                                       {"file", required_argument, 0, 'f'},
                                       {"make-map", optional_argument, 0, 'm'},
+                                      {"binary", no_argument, 0, 'b'},
                                       {0, 0, 0, 0}};
   int option_idx = 0;
   int c;
@@ -137,16 +190,16 @@ int main(int argc, char *argv[])
     exit(-1);
   }
 
-  while ((c = getopt_long(argc, argv, "e:n:f:md", long_opts, &option_idx)) !=
+  while ((c = getopt_long(argc, argv, "e:n:f:mdb", long_opts, &option_idx)) !=
          -1)
   {
     switch (c)
     {
       case 'e':
-        num_edges = atol(optarg);
+        expected_edges = atol(optarg);
         break;
       case 'n':
-        num_nodes = atol(optarg);
+        expected_nodes = atol(optarg);
         break;
       case 'f':
         dataset = optarg;
@@ -154,6 +207,9 @@ int main(int argc, char *argv[])
       case 'm':
         map_exit = true;
         break;
+      case 'b':
+        binary_out = true;
+        break;
       case ':':
       /* missing option argument */
       case '?':
@@ -163,61 +219,84 @@ int main(int argc, char *argv[])
     }
   }
 
-  int64_t offsets[NUM_THREADS];
-  int64_t end_offsets[NUM_THREADS];
-#pragma omp parallel for num_threads(NUM_THREADS) shared(num_nodes)
+  auto start = std::chrono::steady_clock::now();
+  reader::MappedText edges(dataset);
+  std::vector<std::pair<size_t, size_t>> ranges = edges.split(NUM_THREADS);
+  std::vector<std::vector<node_id_t>> part_ids(NUM_THREADS);
+#pragma omp parallel for num_threads(NUM_THREADS)
   for (int i = 0; i < NUM_THREADS; i++)
   {
-    node_id_t beg = ((i * num_nodes) / NUM_THREADS);
-    node_id_t end = (((i + 1) * num_nodes) / NUM_THREADS);
-    offsets[i] = beg;
-    end_offsets[i] = construct_vertex_mapping(beg, end);
+    part_ids[i] = collect_ids(edges, ranges[i].first, ranges[i].second);
   }
-  assert(remap.size() == num_nodes);
-
-  auto __nodes_per_edge = num_nodes / NUM_THREADS;
-  int i = 0;
-  for (auto x : offsets)
+  dense_ids = merge_ids(std::move(part_ids));
+  build_lookup();
+  std::cout << "Found " << dense_ids.size() << " nodes in "
+            << std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << " s" << (direct_map.empty() ? "" : " (direct lookup)")
+            << std::endl;
+  if (expected_nodes > 0 && dense_ids.size() != (size_t)expected_nodes)
   {
-    std::cout << (i * __nodes_per_edge) << "\t(" << x << "," << end_offsets[i]
-              << ")" << std::endl;
-    i++;
+    std::cerr << "Expected " << (size_t)expected_nodes << " nodes but found "
+              << dense_ids.size() << std::endl;
   }
+
+  // Write out the map as the sorted old IDs, indexed by the new ID
   std::filesystem::path path(dataset);
-  std::string out_filename = path.parent_path().string() + "/dense_map_og.txt";
+  std::string out_filename = path.parent_path().string() + "/dense_map.bin";
   std::cout << "\ndense_map file is :" << out_filename << std::endl;
+  try
+  {
+    GraphFileWriter map_file(out_filename, GraphFileKind::IdList, false);
+    for (node_id_t id : dense_ids) map_file.add_id(id);
+    map_file.close();
+  }
+  catch (GraphException &e)
+  {
+    std::cerr << e.what() << std::endl;
+    exit(1);
+  }
+
+  // Write the nodes file.
+  out_filename = dataset + "_nodes";
   std::ofstream out(out_filename.c_str());
-  for (auto iter = remap.begin(); iter != remap.end(); ++iter)
+  for (size_t i = 0; i < dense_ids.size(); i++)
   {
-    out << iter->first << ":" << iter->second << std::endl;
+    out << i << "\n";
   }
   out.close();
+
   if (map_exit)
   {
     exit(EXIT_SUCCESS);
   }
 
-  int64_t e_offsets[NUM_THREADS];
+  // Every thread rewrites its own byte range of the edges
   int64_t e_end_offsets[NUM_THREADS];
-#pragma omp parallel for num_threads(NUM_THREADS) shared(num_edges)
+#pragma omp parallel for num_threads(NUM_THREADS)
+  for (int i = 0; i < NUM_THREADS; i++)
+  {
+    e_end_offsets[i] =
+        convert_edge_list(edges, ranges[i].first, ranges[i].second, i);
+  }
+  int64_t total = 0;
   for (int i = 0; i < NUM_THREADS; i++)
   {
-    node_id_t beg_offset = ((i * num_edges) / NUM_THREADS);
-    node_id_t end_offset = ((i + 1) * num_edges) / NUM_THREADS;
-    e_offsets[i] = beg_offset;
-    e_end_offsets[i] = convert_edge_list(beg_offset, end_offset, i);
+    std::cout << "(" << ranges[i].first << "," << ranges[i].second << ") "
+              << e_end_offsets[i] << " edges" << std::endl;
+    total += e_end_offsets[i];
   }
-  std::cout << "-----------------\n\n";
-  i = 0;
-  auto shoulda = num_edges / NUM_THREADS;
-  for (auto x : e_offsets)
+  if (expected_edges > 0 && total != (int64_t)expected_edges)
   {
-    std::cout << (i * shoulda) << "\t(" << x << "," << e_end_offsets[i] << ")"
-              << std::endl;
-    i++;
+    std::cerr << "Expected " << (int64_t)expected_edges << " edges but found "
+              << total << std::endl;
   }
-
-  // test the combined file with map
+  std::cout << "Remapped " << total << " edges in "
+            << std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << " s" << std::endl;
 
   return (EXIT_SUCCESS);
 }
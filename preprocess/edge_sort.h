@@ -0,0 +1,468 @@
+#ifndef GRAPHAPI_EDGE_SORT_H
+#define GRAPHAPI_EDGE_SORT_H
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "graph_file.h"
+#include "mapped_text.h"
+
+/*
+Sort stage of the preprocessing pipeline, replacing the `sort -g` of the
+edge files in preprocess.sh.
+
+The edges are loaded from text or binary edge files and sorted by (src, dst)
+with a parallel LSD radix sort: one pass per significant byte, each thread
+counting and then scattering its own slice. Passes where every edge has the
+same byte are skipped, so dense IDs only pay for the bytes they use.
+
+Edges that do not fit the memory budget are cut into runs. Every run is
+sorted in both orders and written to a temporary binary file; the runs are
+then merged, the out and in orders at the same time. Repeated edges are
+dropped while writing, so the output is sorted and unique.
+
+The output is what mk_adjlists -x reads: parts binary files <out>_aa, ...
+sorted by (src, dst), and <out>_reverse_aa, ... holding the transposed
+edges sorted by (dst, src).
+*/
+
+typedef struct sort_edge
+{
+  node_id_t src;
+  node_id_t dst;
+  edgeweight_t weight;
+} sort_edge;
+
+inline bool edge_less(const sort_edge &a, const sort_edge &b)
+{
+  return a.src < b.src || (a.src == b.src && a.dst < b.dst);
+}
+
+inline bool same_edge(const sort_edge &a, const sort_edge &b)
+{
+  return a.src == b.src && a.dst == b.dst;
+}
+
+// Number of low bytes needed to hold id
+inline int significant_bytes(node_id_t id)
+{
+  int bytes = 0;
+  for (; id != 0; id >>= 8) bytes++;
+  return bytes;
+}
+
+/**
+ * @brief Stable LSD radix sort of edges by (src, dst) with threads threads.
+ * buf is scratch space of the same size; both vectors are swapped around
+ * between passes, but the result always ends up in edges.
+ */
+void radix_sort_edges(std::vector<sort_edge> &edges,
+                      std::vector<sort_edge> &buf,
+                      int threads)
+{
+  size_t n = edges.size();
+  if (n < 2) return;
+  buf.resize(n);
+
+  node_id_t max_src = 0, max_dst = 0;
+#pragma omp parallel for num_threads(threads) \
+    reduction(max : max_src, max_dst)
+  for (size_t i = 0; i < n; i++)
+  {
+    max_src = std::max(max_src, edges[i].src);
+    max_dst = std::max(max_dst, edges[i].dst);
+  }
+  int dst_bytes = significant_bytes(max_dst);
+  int src_bytes = significant_bytes(max_src);
+
+  // counts[t][b] first holds how many edges of slice t have digit b, then
+  // where slice t writes its first edge with digit b
+  std::vector<std::array<size_t, 256>> counts(threads);
+  for (int d = 0; d < dst_bytes + src_bytes; d++)
+  {
+    bool on_src = d >= dst_bytes;
+    int shift = 8 * (on_src ? d - dst_bytes : d);
+    auto digit = [on_src, shift](const sort_edge &e)
+    { return ((on_src ? e.src : e.dst) >> shift) & 0xFF; };
+
+#pragma omp parallel for num_threads(threads)
+    for (int t = 0; t < threads; t++)
+    {
+      counts[t].fill(0);
+      for (size_t i = n * t / threads; i < n * (t + 1) / threads; i++)
+      {
+        counts[t][digit(edges[i])]++;
+      }
+    }
+
+    size_t pos = 0;
+    bool one_bucket = false;
+    for (int b = 0; b < 256; b++)
+    {
+      size_t bucket = 0;
+      for (int t = 0; t < threads; t++)
+      {
+        size_t count = counts[t][b];
+        counts[t][b] = pos;
+        pos += count;
+        bucket += count;
+      }
+      if (bucket == n) one_bucket = true;
+    }
+    if (one_bucket) continue;  // this byte would not move any edge
+
+#pragma omp parallel for num_threads(threads)
+    for (int t = 0; t < threads; t++)
+    {
+      std::array<size_t, 256> &next = counts[t];
+      for (size_t i = n * t / threads; i < n * (t + 1) / threads; i++)
+      {
+        buf[next[digit(edges[i])]++] = edges[i];
+      }
+    }
+    edges.swap(buf);
+  }
+}
+
+void transpose_edges(std::vector<sort_edge> &edges, int threads)
+{
+#pragma omp parallel for num_threads(threads)
+  for (size_t i = 0; i < edges.size(); i++)
+  {
+    std::swap(edges[i].src, edges[i].dst);
+  }
+}
+
+/**
+ * @brief Writes sorted edges, without repeats, across parts split files of
+ * about the same number of edges. All parts files exist once close() is
+ * called, even if some are empty.
+ */
+class SplitEdgeWriter
+{
+ public:
+  SplitEdgeWriter(std::string _prefix,
+                  int _parts,
+                  uint64_t total_edges,
+                  bool _weighted)
+      : prefix(std::move(_prefix)),
+        parts(_parts),
+        per_part((total_edges + _parts - 1) / _parts),
+        weighted(_weighted)
+  {
+  }
+
+  void add(const sort_edge &e)
+  {
+    if (num_written > 0 && same_edge(e, last)) return;
+    if (file == nullptr || (in_file >= per_part && part + 1 < parts))
+    {
+      next_file();
+    }
+    file->add_edge(e.src, e.dst, e.weight);
+    last = e;
+    in_file++;
+    num_written++;
+  }
+
+  // The number of edges written
+  uint64_t close()
+  {
+    while (part + 1 < parts || file == nullptr) next_file();
+    file->close();
+    file.reset();
+    return num_written;
+  }
+
+ private:
+  std::string prefix;
+  int parts;
+  uint64_t per_part;
+  bool weighted;
+  std::unique_ptr<GraphFileWriter> file;
+  int part = -1;
+  uint64_t in_file = 0;
+  uint64_t num_written = 0;
+  sort_edge last{};
+
+  void next_file()
+  {
+    if (file != nullptr) file->close();
+    part++;
+    file = std::make_unique<GraphFileWriter>(
+        split_file_name(prefix, part), GraphFileKind::EdgeList, weighted);
+    in_file = 0;
+  }
+};
+
+typedef struct edge_sort_opts
+{
+  std::vector<std::string> inputs;  // text or binary edge files
+  std::string out_prefix;
+  std::string tmp_dir;  // for the runs; next to the output if empty
+  int parts = 16;
+  int threads = 16;
+  size_t memory_mb = 4096;
+  bool text_weights = false;  // the third column of text input is a weight
+} edge_sort_opts;
+
+typedef struct edge_sort_stats
+{
+  uint64_t edges_read = 0;
+  uint64_t edges_written = 0;  // without the repeated edges
+  size_t num_runs = 0;
+  double load_secs = 0;    // including the sorts of the spilled runs
+  double finish_secs = 0;  // the last sort or the merge, and the output
+} edge_sort_stats;
+
+/**
+ * @brief Loads edges into runs of at most run_capacity edges, spilling
+ * sorted runs to tmp_dir whenever one fills up.
+ */
+class EdgeSorter
+{
+ public:
+  explicit EdgeSorter(const edge_sort_opts &_opts) : opts(_opts)
+  {
+    // The run, the radix sort buffer and the edges of one parse batch
+    run_capacity = std::max<size_t>(
+        1 << 16, (opts.memory_mb << 20) / (3 * sizeof(sort_edge)));
+    if (opts.tmp_dir.empty())
+    {
+      opts.tmp_dir =
+          std::filesystem::path(opts.out_prefix).parent_path().string();
+      if (opts.tmp_dir.empty()) opts.tmp_dir = ".";
+    }
+    weighted = opts.text_weights;
+    for (const std::string &input : opts.inputs)
+    {
+      if (GraphFileReader::is_graph_file(input))
+      {
+        weighted |= GraphFileReader(input, GraphFileKind::EdgeList)
+                        .is_weighted();
+      }
+    }
+  }
+
+  void add_file(const std::string &path)
+  {
+    if (GraphFileReader::is_graph_file(path))
+      add_binary(path);
+    else
+      add_text(path);
+  }
+
+  edge_sort_stats finish()
+  {
+    edge_sort_stats stats;
+    stats.edges_read = total;
+    auto start = std::chrono::steady_clock::now();
+    SplitEdgeWriter out(opts.out_prefix, opts.parts, total, weighted);
+    SplitEdgeWriter in(
+        opts.out_prefix + "_reverse", opts.parts, total, weighted);
+
+    if (out_runs.empty())
+    {
+      // Everything fit in memory: no runs to spill or merge
+      radix_sort_edges(run, buf, opts.threads);
+      for (const sort_edge &e : run) out.add(e);
+      stats.edges_written = out.close();
+      transpose_edges(run, opts.threads);
+      radix_sort_edges(run, buf, opts.threads);
+      for (const sort_edge &e : run) in.add(e);
+      in.close();
+    }
+    else
+    {
+      if (!run.empty()) flush_run();
+      release(run);
+      release(buf);
+      std::thread in_merge([&] { merge_runs(in_runs, in); });
+      merge_runs(out_runs, out);
+      in_merge.join();
+      stats.edges_written = out.close();
+      in.close();
+      for (const std::string &path : out_runs) std::remove(path.c_str());
+      for (const std::string &path : in_runs) std::remove(path.c_str());
+    }
+    stats.num_runs = std::max<size_t>(1, out_runs.size());
+    stats.finish_secs = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    return stats;
+  }
+
+ private:
+  edge_sort_opts opts;
+  size_t run_capacity;
+  bool weighted = false;
+  uint64_t total = 0;
+  std::vector<sort_edge> run, buf;
+  std::vector<std::string> out_runs, in_runs;
+
+  void append(const sort_edge *first, size_t count)
+  {
+    while (count > 0)
+    {
+      if (run.capacity() < run_capacity) run.reserve(run_capacity);
+      size_t take = std::min(count, run_capacity - run.size());
+      run.insert(run.end(), first, first + take);
+      first += take;
+      count -= take;
+      total += take;
+      if (run.size() == run_capacity) flush_run();
+    }
+  }
+
+  void add_binary(const std::string &path)
+  {
+    GraphFileReader edges(path, GraphFileKind::EdgeList);
+    std::vector<sort_edge> chunk_edges;
+    for (size_t c = 0; c < edges.num_chunks(); c++)
+    {
+      graph_file_chunk chunk = edges.chunk(c);
+      chunk_edges.resize(chunk.num_items);
+      for (size_t i = 0; i < chunk.num_items; i++)
+      {
+        chunk_edges[i] = {chunk.ids[i],
+                          chunk.dsts[i],
+                          chunk.weights ? chunk.weights[i] : 0};
+      }
+      append(chunk_edges.data(), chunk_edges.size());
+    }
+  }
+
+  void add_text(const std::string &path)
+  {
+    reader::MappedText text(path);
+    // A line takes at least 4 bytes ("1 2\n"), so one batch of ranges
+    // parses into at most run_capacity edges
+    size_t range_bytes =
+        std::max<size_t>(1 << 20, run_capacity / opts.threads * 4);
+    int num_ranges = (int)std::max<size_t>(
+        opts.threads, (text.size() + range_bytes - 1) / range_bytes);
+    std::vector<std::pair<size_t, size_t>> ranges = text.split(num_ranges);
+
+    std::vector<std::vector<sort_edge>> parsed(opts.threads);
+    for (int first = 0; first < num_ranges; first += opts.threads)
+    {
+#pragma omp parallel for num_threads(opts.threads)
+      for (int t = 0; t < opts.threads; t++)
+      {
+        parsed[t].clear();
+        if (first + t >= num_ranges) continue;
+        auto [beg, end] = ranges[first + t];
+        reader::LineParser lines(text.begin() + beg, text.begin() + end);
+        sort_edge e{};
+        while (lines.next_line())
+        {
+          if (!lines.next(e.src) || !lines.next(e.dst)) continue;
+          e.weight = 0;
+          if (opts.text_weights) lines.next(e.weight);
+          parsed[t].push_back(e);
+        }
+      }
+      for (const std::vector<sort_edge> &part : parsed)
+      {
+        append(part.data(), part.size());
+      }
+    }
+  }
+
+  // Sorts the run in both orders and writes each to a temporary file
+  void flush_run()
+  {
+    std::string base = opts.tmp_dir + "/edge_sort_" +
+                       std::to_string(getpid()) + "_" +
+                       std::to_string(out_runs.size());
+    radix_sort_edges(run, buf, opts.threads);
+    out_runs.push_back(base + "_out");
+    write_run(out_runs.back());
+    transpose_edges(run, opts.threads);
+    radix_sort_edges(run, buf, opts.threads);
+    in_runs.push_back(base + "_in");
+    write_run(in_runs.back());
+    std::cout << "Spilled run " << out_runs.size() << " of " << run.size()
+              << " edges" << std::endl;
+    run.clear();
+  }
+
+  void write_run(const std::string &path)
+  {
+    GraphFileWriter file(path, GraphFileKind::EdgeList, weighted);
+    for (size_t i = 0; i < run.size(); i++)
+    {
+      if (i > 0 && same_edge(run[i], run[i - 1])) continue;
+      file.add_edge(run[i].src, run[i].dst, run[i].weight);
+    }
+    file.close();
+  }
+
+  static void release(std::vector<sort_edge> &v)
+  {
+    std::vector<sort_edge>().swap(v);
+  }
+
+  // k-way merge of sorted run files into out
+  static void merge_runs(const std::vector<std::string> &runs,
+                         SplitEdgeWriter &out)
+  {
+    std::vector<std::unique_ptr<GraphFileReader>> readers;
+    using head = std::pair<sort_edge, size_t>;
+    auto later = [](const head &a, const head &b)
+    { return edge_less(b.first, a.first); };
+    std::priority_queue<head, std::vector<head>, decltype(later)> heads(
+        later);
+
+    edge e;
+    for (const std::string &path : runs)
+    {
+      readers.push_back(
+          std::make_unique<GraphFileReader>(path, GraphFileKind::EdgeList));
+      if (readers.back()->next_edge(e))
+      {
+        heads.push({{e.src_id, e.dst_id, e.edge_weight}, readers.size() - 1});
+      }
+    }
+    while (!heads.empty())
+    {
+      head top = heads.top();
+      heads.pop();
+      out.add(top.first);
+      if (readers[top.second]->next_edge(e))
+      {
+        heads.push({{e.src_id, e.dst_id, e.edge_weight}, top.second});
+      }
+    }
+  }
+};
+
+// Sorts the input edges of opts into the out and in order split files
+edge_sort_stats sort_edges(const edge_sort_opts &opts)
+{
+  auto start = std::chrono::steady_clock::now();
+  EdgeSorter sorter(opts);
+  for (const std::string &input : opts.inputs)
+  {
+    sorter.add_file(input);
+  }
+  double load_secs = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  edge_sort_stats stats = sorter.finish();
+  stats.load_secs = load_secs;
+  return stats;
+}
+
+#endif  // GRAPHAPI_EDGE_SORT_H
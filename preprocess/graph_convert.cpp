@@ -0,0 +1,206 @@
+#include <getopt.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "graph_file.h"
+#include "reader.h"
+
+/**
+ * Converts the text files of the preprocessing pipeline to the binary graph
+ * file format of graph_file.h and back. The text forms are:
+ *  - ids:   one node ID per line (the _nodes files)
+ *  - edges: "src dst [weight]" per line (the _edges, _sorted and split
+ *           dataset files)
+ *  - adj:   "id degree n1,n2,..." per line (out_xx and in_xx)
+ *  - map:   "old_id new_id" per line (dense_map.txt). The binary form is an
+ *           IdList holding the old ID of every new ID, in new ID order.
+ */
+
+std::string kind;
+std::string in_path;
+std::string out_path;
+bool to_binary = true;
+bool weighted = false;
+
+void help()
+{
+  std::cout << "Usage: ./graph_convert --kind <ids|edges|adj|map> --in <file> "
+               "--out <file> [--text] [--weighted]"
+            << std::endl;
+  std::cout << "Converts a text graph file to the binary graph file format, "
+               "or back to text with --text. --weighted keeps the third "
+               "column of an edge list as its weight."
+            << std::endl;
+}
+
+void text_to_binary()
+{
+  if (kind == "adj")
+  {
+    GraphFileWriter out(out_path, GraphFileKind::AdjLists, false);
+    reader::AdjReader adj_reader(in_path);
+    adjlist adj;
+    while (adj_reader.get_next_adjlist(adj) == 0)
+    {
+      out.add_adjlist(adj);
+      adj.clear();
+    }
+    out.close();
+    return;
+  }
+
+  reader::MappedText text(in_path);
+  reader::LineParser lines(text.begin(), text.end());
+  if (kind == "ids")
+  {
+    GraphFileWriter out(out_path, GraphFileKind::IdList, false);
+    node_id_t id;
+    while (lines.next_line())
+    {
+      if (lines.next(id)) out.add_id(id);
+    }
+    out.close();
+  }
+  else if (kind == "edges")
+  {
+    GraphFileWriter out(out_path, GraphFileKind::EdgeList, weighted);
+    edge e;
+    while (lines.next_line())
+    {
+      if (!lines.next(e.src_id) || !lines.next(e.dst_id)) continue;
+      e.edge_weight = 0;
+      if (weighted) lines.next(e.edge_weight);
+      out.add_edge(e.src_id, e.dst_id, e.edge_weight);
+    }
+    out.close();
+  }
+  else  // map
+  {
+    std::vector<node_id_t> old_ids;
+    node_id_t old_id, new_id;
+    while (lines.next_line())
+    {
+      if (!lines.next(old_id) || !lines.next(new_id)) continue;
+      if (new_id >= old_ids.size()) old_ids.resize(new_id + 1);
+      old_ids[new_id] = old_id;
+    }
+    GraphFileWriter out(out_path, GraphFileKind::IdList, false);
+    for (node_id_t id : old_ids) out.add_id(id);
+    out.close();
+  }
+}
+
+void binary_to_text()
+{
+  std::ofstream out(out_path);
+  if (!out.is_open())
+  {
+    throw GraphException("Could not open " + out_path);
+  }
+  if (kind == "ids" || kind == "map")
+  {
+    GraphFileReader in(in_path, GraphFileKind::IdList);
+    node_id_t id;
+    node_id_t new_id = 0;
+    while (in.next_id(id))
+    {
+      if (kind == "map")
+        out << id << "\t" << new_id++ << "\n";
+      else
+        out << id << "\n";
+    }
+  }
+  else if (kind == "edges")
+  {
+    GraphFileReader in(in_path, GraphFileKind::EdgeList);
+    edge e;
+    while (in.next_edge(e))
+    {
+      out << e.src_id << "\t" << e.dst_id;
+      if (in.is_weighted()) out << "\t" << e.edge_weight;
+      out << "\n";
+    }
+  }
+  else  // adj
+  {
+    GraphFileReader in(in_path, GraphFileKind::AdjLists);
+    adjlist adj;
+    while (in.next_adjlist(adj))
+    {
+      out << adj.node_id << " " << adj.edgelist.size() << " ";
+      for (size_t i = 0; i < adj.edgelist.size(); i++)
+      {
+        if (i != 0) out << ",";
+        out << adj.edgelist[i];
+      }
+      out << "\n";
+      adj.clear();
+    }
+  }
+  out.close();
+}
+
+int main(int argc, char* argv[])
+{
+  static struct option long_opts[] = {{"kind", required_argument, 0, 'k'},
+                                      {"in", required_argument, 0, 'i'},
+                                      {"out", required_argument, 0, 'o'},
+                                      {"text", no_argument, 0, 't'},
+                                      {"weighted", no_argument, 0, 'w'},
+                                      {0, 0, 0, 0}};
+  int option_idx = 0;
+  int c;
+  while ((c = getopt_long(argc, argv, "k:i:o:tw", long_opts, &option_idx)) !=
+         -1)
+  {
+    switch (c)
+    {
+      case 'k':
+        kind = optarg;
+        break;
+      case 'i':
+        in_path = optarg;
+        break;
+      case 'o':
+        out_path = optarg;
+        break;
+      case 't':
+        to_binary = false;
+        break;
+      case 'w':
+        weighted = true;
+        break;
+      case ':':
+      /* missing option argument */
+      case '?':
+      default:
+        help();
+        exit(-1);
+    }
+  }
+  if (in_path.empty() || out_path.empty() ||
+      (kind != "ids" && kind != "edges" && kind != "adj" && kind != "map"))
+  {
+    help();
+    exit(-1);
+  }
+
+  try
+  {
+    if (to_binary)
+      text_to_binary();
+    else
+      binary_to_text();
+  }
+  catch (GraphException& e)
+  {
+    std::cerr << e.what() << std::endl;
+    exit(1);
+  }
+  return (EXIT_SUCCESS);
+}
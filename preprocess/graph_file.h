@@ -0,0 +1,491 @@
+#ifndef GRAPHAPI_GRAPH_FILE_H
+#define GRAPHAPI_GRAPH_FILE_H
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common_defs.h"
+#include "graph_exception.h"
+#include "mmap_helper.h"
+
+/**
+ * Binary interchange format of the preprocessing tools, replacing the
+ * decimal text files passed between mk_adjlists, dense_vertexranges and
+ * bulk_insert_low_mem.
+ *
+ * Layout: a graph_file_header followed by num_chunks chunks. A chunk is a
+ * graph_file_chunk_header and the arrays of its records, each starting on
+ * an 8 byte boundary:
+ *  - IdList: ids (node_id_t[num_items])
+ *  - EdgeList: srcs and dsts (node_id_t[num_items] each)
+ *  - AdjLists: node ids (node_id_t[num_items]), degrees
+ *    (degree_t[num_items]) and the neighbours (node_id_t[num_edges])
+ * A weighted EdgeList or AdjLists chunk ends with the edge weights
+ * (edgeweight_t per edge). The file is in host byte order.
+ *
+ * GraphFileWriter streams records into chunks and fills in the counts and
+ * the sortedness flags when it is closed, so they describe what was
+ * written rather than what the caller claimed.
+ */
+
+const uint32_t GRAPH_FILE_VERSION = 1;
+const char GRAPH_FILE_MAGIC[8] = {'W', 'T', 'G', 'F', 'I', 'L', 'E', '\0'};
+// Records GraphFileWriter collects before writing a chunk
+const size_t GRAPH_FILE_CHUNK_ITEMS = 1 << 16;
+
+typedef enum GraphFileKind
+{
+  IdList,
+  EdgeList,
+  AdjLists
+} GraphFileKind;
+
+typedef enum GraphFileFlags
+{
+  GRAPH_FILE_WEIGHTED = 1,
+  GRAPH_FILE_SORTED = 2,  // by node ID, edges by (src, dst)
+  GRAPH_FILE_UNIQUE = 4   // sorted without repeated keys
+} GraphFileFlags;
+
+struct graph_file_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t kind;       // GraphFileKind
+  uint32_t flags;      // GraphFileFlags
+  uint32_t id_bytes;   // sizeof(node_id_t), differs between B64 builds
+  uint64_t num_items;  // IDs, edges or adjacency lists
+  uint64_t num_edges;  // 0 for an IdList
+  uint64_t num_chunks;
+};
+
+struct graph_file_chunk_header
+{
+  uint64_t num_items;
+  uint64_t num_edges;
+};
+
+/**
+ * @brief The records of one chunk, pointing into the mapped file. Arrays a
+ * kind does not have are nullptr.
+ */
+typedef struct graph_file_chunk
+{
+  uint64_t num_items = 0;
+  uint64_t num_edges = 0;
+  const node_id_t *ids = nullptr;  // IDs, edge sources or list node IDs
+  const node_id_t *dsts = nullptr;
+  const degree_t *degrees = nullptr;
+  const node_id_t *nbrs = nullptr;
+  const edgeweight_t *weights = nullptr;
+} graph_file_chunk;
+
+// Byte positions of the arrays of a chunk, relative to its header
+typedef struct graph_file_chunk_layout
+{
+  uint64_t ids = 0;
+  uint64_t dsts = 0;
+  uint64_t degrees = 0;
+  uint64_t nbrs = 0;
+  uint64_t weights = 0;
+  uint64_t size = 0;
+
+  graph_file_chunk_layout(GraphFileKind kind,
+                          bool weighted,
+                          uint64_t num_items,
+                          uint64_t num_edges)
+  {
+    uint64_t pos = align(sizeof(graph_file_chunk_header));
+    ids = pos;
+    pos = align(pos + num_items * sizeof(node_id_t));
+    if (kind == GraphFileKind::EdgeList)
+    {
+      dsts = pos;
+      pos = align(pos + num_items * sizeof(node_id_t));
+    }
+    if (kind == GraphFileKind::AdjLists)
+    {
+      degrees = pos;
+      pos = align(pos + num_items * sizeof(degree_t));
+      nbrs = pos;
+      pos = align(pos + num_edges * sizeof(node_id_t));
+    }
+    if (weighted && kind != GraphFileKind::IdList)
+    {
+      weights = pos;
+      pos = align(pos + num_edges * sizeof(edgeweight_t));
+    }
+    size = pos;
+  }
+
+  static uint64_t align(uint64_t pos) { return (pos + 7) & ~uint64_t(7); }
+} graph_file_chunk_layout;
+
+// base followed by the two letter suffix of the tid-th split file (_aa, ...)
+inline std::string split_file_name(const std::string &base, int tid)
+{
+  std::string filename = base + "_";
+  filename.push_back((char)(97 + tid / 26));
+  filename.push_back((char)(97 + tid % 26));
+  return filename;
+}
+
+/**
+ * @brief Writes a graph file. Records are added with the add_* call that
+ * matches the kind; the file only appears at path once close() succeeds.
+ */
+class GraphFileWriter
+{
+ public:
+  GraphFileWriter(std::string _path, GraphFileKind _kind, bool _weighted)
+      : path(std::move(_path)), kind(_kind), weighted(_weighted)
+  {
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.kind = kind;
+    header.id_bytes = sizeof(node_id_t);
+    // Written to a temporary name first so readers never map a partial file
+    out.open(path + ".tmp", std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      throw GraphException("Could not open " + path + ".tmp");
+    }
+    out.write((const char *)&header, sizeof(header));
+  }
+
+  ~GraphFileWriter()
+  {
+    if (out.is_open()) out.close();
+  }
+
+  void add_id(node_id_t id)
+  {
+    track_order(id, 0);
+    ids.push_back(id);
+    if (ids.size() == GRAPH_FILE_CHUNK_ITEMS) flush_chunk();
+  }
+
+  void add_edge(node_id_t src, node_id_t dst, edgeweight_t weight = 0)
+  {
+    track_order(src, dst);
+    ids.push_back(src);
+    dsts.push_back(dst);
+    if (weighted) weights.push_back(weight);
+    if (ids.size() == GRAPH_FILE_CHUNK_ITEMS) flush_chunk();
+  }
+
+  // Missing weights of a weighted file are written as 0
+  void add_adjlist(const adjlist &adj)
+  {
+    track_order(adj.node_id, 0);
+    ids.push_back(adj.node_id);
+    degrees.push_back(adj.edgelist.size());
+    nbrs.insert(nbrs.end(), adj.edgelist.begin(), adj.edgelist.end());
+    if (weighted)
+    {
+      bool has_weights = adj.weights.size() == adj.edgelist.size();
+      for (size_t i = 0; i < adj.edgelist.size(); i++)
+      {
+        weights.push_back(has_weights ? adj.weights[i] : 0);
+      }
+    }
+    if (ids.size() == GRAPH_FILE_CHUNK_ITEMS ||
+        nbrs.size() >= GRAPH_FILE_CHUNK_ITEMS * 16)
+    {
+      flush_chunk();
+    }
+  }
+
+  // Writes the last chunk and the final header, then moves the file to path
+  void close()
+  {
+    flush_chunk();
+    header.flags = (weighted ? GRAPH_FILE_WEIGHTED : 0) |
+                   (sorted ? GRAPH_FILE_SORTED : 0) |
+                   (sorted && unique ? GRAPH_FILE_UNIQUE : 0);
+    out.seekp(0);
+    out.write((const char *)&header, sizeof(header));
+    out.close();
+    std::string tmp_path = path + ".tmp";
+    if (!out || std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+      throw GraphException("Failed to write " + path);
+    }
+  }
+
+ private:
+  std::string path;
+  GraphFileKind kind;
+  bool weighted;
+  std::ofstream out;
+  graph_file_header header{};
+  std::vector<node_id_t> ids, dsts, nbrs;
+  std::vector<degree_t> degrees;
+  std::vector<edgeweight_t> weights;
+  bool sorted = true;
+  bool unique = true;
+  bool started = false;
+  node_id_t last_first = 0, last_second = 0;
+
+  void track_order(node_id_t first, node_id_t second)
+  {
+    if (started)
+    {
+      if (first < last_first || (first == last_first && second < last_second))
+      {
+        sorted = false;
+      }
+      else if (first == last_first && second == last_second)
+      {
+        unique = false;
+      }
+    }
+    started = true;
+    last_first = first;
+    last_second = second;
+  }
+
+  void flush_chunk()
+  {
+    if (ids.empty()) return;
+    uint64_t num_edges =
+        kind == GraphFileKind::AdjLists ? nbrs.size() : dsts.size();
+    graph_file_chunk_header chunk{ids.size(), num_edges};
+    graph_file_chunk_layout layout(kind, weighted, ids.size(), num_edges);
+    std::vector<char> buf(layout.size, 0);
+    std::memcpy(buf.data(), &chunk, sizeof(chunk));
+    copy_to(buf, layout.ids, ids);
+    copy_to(buf, layout.dsts, dsts);
+    copy_to(buf, layout.degrees, degrees);
+    copy_to(buf, layout.nbrs, nbrs);
+    copy_to(buf, layout.weights, weights);
+    out.write(buf.data(), (std::streamsize)buf.size());
+
+    header.num_items += ids.size();
+    header.num_edges += num_edges;
+    header.num_chunks++;
+    ids.clear();
+    dsts.clear();
+    degrees.clear();
+    nbrs.clear();
+    weights.clear();
+  }
+
+  template <typename T>
+  static void copy_to(std::vector<char> &buf,
+                      uint64_t pos,
+                      const std::vector<T> &values)
+  {
+    if (!values.empty())
+    {
+      std::memcpy(buf.data() + pos, values.data(), values.size() * sizeof(T));
+    }
+  }
+};
+
+/**
+ * @brief Maps a graph file. Chunks can be read independently with chunk(),
+ * or the records in order with next_id(), next_edge() or next_adjlist().
+ */
+class GraphFileReader
+{
+ public:
+  GraphFileReader(const std::string &_path, GraphFileKind expected)
+      : path(_path)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw GraphException("Could not open graph file " + path);
+    }
+    struct stat st
+    {
+    };
+    if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw GraphException("Could not stat graph file " + path);
+    }
+    file_size = (uint64_t)st.st_size;
+    if (file_size < sizeof(graph_file_header))
+    {
+      close(fd);
+      throw GraphException("Truncated graph file " + path);
+    }
+    mapping = mmap_helper<char>(file_size, fd, PROT_READ);
+    close(fd);  // the mapping stays valid
+    base = mapping.get_iterator();
+
+    std::memcpy(&header, base, sizeof(header));
+    check_header(expected);
+    index_chunks();
+  }
+
+  GraphFileReader(const GraphFileReader &) = delete;
+  GraphFileReader &operator=(const GraphFileReader &) = delete;
+
+  ~GraphFileReader() { mapping.unmap(); }
+
+  // Whether the file at path starts with the graph file magic
+  static bool is_graph_file(const std::string &path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(GRAPH_FILE_MAGIC)] = {};
+    return in.read(magic, sizeof(magic)) &&
+           std::memcmp(magic, GRAPH_FILE_MAGIC, sizeof(magic)) == 0;
+  }
+
+  [[nodiscard]] const graph_file_header &get_header() const { return header; }
+  [[nodiscard]] bool is_weighted() const
+  {
+    return header.flags & GRAPH_FILE_WEIGHTED;
+  }
+  [[nodiscard]] bool is_sorted() const
+  {
+    return header.flags & GRAPH_FILE_SORTED;
+  }
+  [[nodiscard]] size_t num_chunks() const { return chunk_pos.size(); }
+
+  [[nodiscard]] graph_file_chunk chunk(size_t i) const
+  {
+    const char *start = base + chunk_pos[i];
+    graph_file_chunk_header chunk_header{};
+    std::memcpy(&chunk_header, start, sizeof(chunk_header));
+    graph_file_chunk_layout layout((GraphFileKind)header.kind,
+                                   is_weighted(),
+                                   chunk_header.num_items,
+                                   chunk_header.num_edges);
+    graph_file_chunk c;
+    c.num_items = chunk_header.num_items;
+    c.num_edges = chunk_header.num_edges;
+    c.ids = (const node_id_t *)(start + layout.ids);
+    if (layout.dsts) c.dsts = (const node_id_t *)(start + layout.dsts);
+    if (layout.degrees) c.degrees = (const degree_t *)(start + layout.degrees);
+    if (layout.nbrs) c.nbrs = (const node_id_t *)(start + layout.nbrs);
+    if (layout.weights)
+    {
+      c.weights = (const edgeweight_t *)(start + layout.weights);
+    }
+    return c;
+  }
+
+  bool next_id(node_id_t &id)
+  {
+    if (!next_record()) return false;
+    id = cur.ids[item_pos];
+    item_pos++;
+    return true;
+  }
+
+  bool next_edge(edge &e)
+  {
+    if (!next_record()) return false;
+    e.src_id = cur.ids[item_pos];
+    e.dst_id = cur.dsts[item_pos];
+    e.edge_weight = cur.weights ? cur.weights[item_pos] : 0;
+    item_pos++;
+    return true;
+  }
+
+  // Appends the neighbours, and weights if the file has them, to adj
+  bool next_adjlist(adjlist &adj)
+  {
+    if (!next_record()) return false;
+    adj.node_id = cur.ids[item_pos];
+    adj.degree = cur.degrees[item_pos];
+    const node_id_t *nbrs = cur.nbrs + edge_pos;
+    adj.edgelist.insert(adj.edgelist.end(), nbrs, nbrs + adj.degree);
+    if (cur.weights)
+    {
+      const edgeweight_t *weights = cur.weights + edge_pos;
+      adj.weights.insert(adj.weights.end(), weights, weights + adj.degree);
+    }
+    edge_pos += adj.degree;
+    item_pos++;
+    return true;
+  }
+
+ private:
+  std::string path;
+  mmap_helper<char> mapping;
+  const char *base = nullptr;
+  uint64_t file_size = 0;
+  graph_file_header header{};
+  std::vector<uint64_t> chunk_pos;
+  // position of the sequential reads
+  size_t next_chunk = 0;
+  graph_file_chunk cur;
+  uint64_t item_pos = 0;
+  uint64_t edge_pos = 0;
+
+  bool next_record()
+  {
+    while (item_pos == cur.num_items)
+    {
+      if (next_chunk == chunk_pos.size()) return false;
+      cur = chunk(next_chunk++);
+      item_pos = 0;
+      edge_pos = 0;
+    }
+    return true;
+  }
+
+  void check_header(GraphFileKind expected)
+  {
+    if (std::memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) !=
+        0)
+    {
+      throw GraphException("Not a graph file: " + path);
+    }
+    if (header.version != GRAPH_FILE_VERSION)
+    {
+      throw GraphException("Unsupported graph file version " +
+                           std::to_string(header.version) + " in " + path);
+    }
+    if (header.id_bytes != sizeof(node_id_t))
+    {
+      throw GraphException("Graph file " + path + " uses " +
+                           std::to_string(header.id_bytes) +
+                           " byte node IDs");
+    }
+    if (header.kind != (uint32_t)expected)
+    {
+      throw GraphException("Graph file " + path + " holds the wrong kind of "
+                           "records");
+    }
+  }
+
+  void index_chunks()
+  {
+    uint64_t pos = graph_file_chunk_layout::align(sizeof(header));
+    for (uint64_t i = 0; i < header.num_chunks; i++)
+    {
+      graph_file_chunk_header chunk_header{};
+      if (pos + sizeof(chunk_header) > file_size)
+      {
+        throw GraphException("Truncated graph file " + path);
+      }
+      std::memcpy(&chunk_header, base + pos, sizeof(chunk_header));
+      graph_file_chunk_layout layout((GraphFileKind)header.kind,
+                                     is_weighted(),
+                                     chunk_header.num_items,
+                                     chunk_header.num_edges);
+      if (pos + layout.size > file_size)
+      {
+        throw GraphException("Truncated graph file " + path);
+      }
+      chunk_pos.push_back(pos);
+      pos += layout.size;
+    }
+  }
+};
+
+#endif  // GRAPHAPI_GRAPH_FILE_H
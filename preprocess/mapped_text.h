@@ -0,0 +1,164 @@
+#ifndef GRAPHAPI_MAPPED_TEXT_H
+#define GRAPHAPI_MAPPED_TEXT_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "graph_exception.h"
+#include "mmap_helper.h"
+
+namespace reader
+{
+
+/**
+ * @brief A read-only mapping of a whole text file, shared by the readers
+ * of the preprocessing tools. split() cuts it into newline aligned byte
+ * ranges, so threads can each parse their own part without reading past
+ * the lines of the others.
+ */
+class MappedText
+{
+ public:
+  explicit MappedText(const std::string &filename)
+  {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw GraphException("Failed to open " + filename);
+    }
+    struct stat st
+    {
+    };
+    if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw GraphException("Failed to stat " + filename);
+    }
+    length = (size_t)st.st_size;
+    if (length > 0)
+    {
+      mapping = mmap_helper<char>(length, fd, PROT_READ);
+      madvise(mapping.get_iterator(), length, MADV_SEQUENTIAL);
+    }
+    close(fd);  // the mapping stays valid
+  }
+
+  MappedText(const MappedText &) = delete;
+  MappedText &operator=(const MappedText &) = delete;
+
+  ~MappedText()
+  {
+    if (mapping.is_mapped()) mapping.unmap();
+  }
+
+  [[nodiscard]] const char *begin() { return mapping.get_iterator(); }
+  [[nodiscard]] const char *end() { return begin() + length; }
+  [[nodiscard]] size_t size() const { return length; }
+
+  /**
+   * @brief Cuts the file into parts byte ranges [first, second) of about
+   * the same size. Every range but the first starts right after a newline,
+   * so no line is split; some ranges can be empty.
+   */
+  std::vector<std::pair<size_t, size_t>> split(int parts)
+  {
+    std::vector<size_t> cuts = {0};
+    for (int i = 1; i < parts; i++)
+    {
+      size_t cut = std::max(cuts.back(), length * i / parts);
+      if (cut > 0 && cut < length && begin()[cut - 1] != '\n')
+      {
+        const void *nl = std::memchr(begin() + cut, '\n', length - cut);
+        cut = nl == nullptr ? length : (const char *)nl - begin() + 1;
+      }
+      cuts.push_back(cut);
+    }
+    cuts.push_back(length);
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (int i = 0; i < parts; i++)
+    {
+      ranges.emplace_back(cuts[i], cuts[i + 1]);
+    }
+    return ranges;
+  }
+
+ private:
+  mmap_helper<char> mapping;
+  size_t length = 0;
+};
+
+/**
+ * @brief Reads the integers of a text range line by line with
+ * std::from_chars. The numbers on a line can be separated by spaces, tabs
+ * or commas. Empty lines and lines starting with '#' or '%' are skipped.
+ */
+class LineParser
+{
+ public:
+  LineParser(const char *_begin, const char *_end) : pos(_begin), end(_end) {}
+
+  // Moves to the next line; false once the range is exhausted
+  bool next_line()
+  {
+    while (pos < end)
+    {
+      const char *line_begin = pos;
+      auto nl = (const char *)std::memchr(pos, '\n', end - pos);
+      line_end = nl == nullptr ? end : nl;
+      pos = nl == nullptr ? end : nl + 1;
+      cur = line_begin;
+      skip_separators();
+      if (cur < line_end && *cur != '#' && *cur != '%') return true;
+    }
+    cur = line_end = end;
+    return false;
+  }
+
+  /**
+   * @brief Parses the next number on the current line into value.
+   * @return false at the end of the line or if the next token is not a
+   * number, in which case the rest of the line is dropped.
+   */
+  template <typename T>
+  bool next(T &value)
+  {
+    skip_separators();
+    if (cur == line_end) return false;
+    auto [ptr, ec] = std::from_chars(cur, line_end, value);
+    if (ec != std::errc())
+    {
+      cur = line_end;
+      return false;
+    }
+    cur = ptr;
+    return true;
+  }
+
+ private:
+  const char *pos;
+  const char *end;
+  const char *cur = nullptr;
+  const char *line_end = nullptr;
+
+  void skip_separators()
+  {
+    while (cur < line_end &&
+           (*cur == ' ' || *cur == '\t' || *cur == ',' || *cur == '\r'))
+    {
+      cur++;
+    }
+  }
+};
+
+}  // namespace reader
+
+#endif  // GRAPHAPI_MAPPED_TEXT_H
@@ -31,6 +31,25 @@ int main(int argc, char** argv)
   std::cout << "Num Per Chunk: " << num_per_chunk << std::endl;
   std::cout << "Num Threads: " << opts.num_threads << std::endl;
   std::cout << "dbname: " << opts.db_name << std::endl;
+  std::cout << "Binary files: " << params.get_binary_io() << std::endl;
+
+  if (params.get_binary_io())
+  {
+    // Lists crossing a file boundary are finished by the thread they start
+    // in, so there are no conflicts to merge
+#pragma omp parallel for num_threads(opts.num_threads)
+    for (int i = 0; i < opts.num_threads; i++)
+    {
+      binary_adjlist_thread(i, "out", opts.num_threads);
+    }
+    dataset = dataset + "_reverse";
+#pragma omp parallel for num_threads(opts.num_threads)
+    for (int i = 0; i < opts.num_threads; i++)
+    {
+      binary_adjlist_thread(i, "in", opts.num_threads);
+    }
+    return 0;
+  }
 
 #pragma omp parallel for num_threads(opts.num_threads)
   for (int i = 0; i < opts.num_threads; i++)
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "cstdlib"
+#include "graph_file.h"
 #include "reader.h"
 
 std::string dataset;
@@ -35,6 +36,85 @@ void insert_edge_thread(int _tid, const std::string& adjtype)
   conflicts[tid] = conflict;
 }
 
+// Source of the last edge in a binary edge file; false if it is empty
+bool last_edge_src(const GraphFileReader& edges, node_id_t& src)
+{
+  if (edges.num_chunks() == 0) return false;
+  graph_file_chunk last = edges.chunk(edges.num_chunks() - 1);
+  src = last.ids[last.num_items - 1];
+  return true;
+}
+
+/**
+ * @brief Builds the binary adjacency file of the tid-th binary edge file.
+ *
+ * A node whose edges cross into the next file belongs to the thread of the
+ * file it starts in: that thread reads on into the following files for the
+ * rest of its list, and the next thread skips those edges. This replaces
+ * merge_conflicts, which rewrites the text files with sed afterwards.
+ */
+void binary_adjlist_thread(int tid, const std::string& adjtype, int num_files)
+{
+  std::string filename = split_file_name(dataset, tid);
+  std::string adj_filename = dataset.substr(0, dataset.find_last_of('/')) +
+                             "/" + adjtype +
+                             filename.substr(filename.find_last_of('_'));
+
+  node_id_t skip_src = 0;
+  bool skip = false;
+  if (tid > 0)
+  {
+    GraphFileReader prev(split_file_name(dataset, tid - 1),
+                         GraphFileKind::EdgeList);
+    skip = last_edge_src(prev, skip_src);
+  }
+
+  auto edges =
+      std::make_unique<GraphFileReader>(filename, GraphFileKind::EdgeList);
+  if (!edges->is_sorted())
+  {
+    throw GraphException(filename + " is not sorted by (src, dst)");
+  }
+  bool weighted = edges->is_weighted();
+  GraphFileWriter adj_file(adj_filename, GraphFileKind::AdjLists, weighted);
+  std::cout << "Opening for writing: " << adj_filename << std::endl;
+
+  adjlist adj;
+  bool open = false;
+  edge e;
+  int next_file = tid + 1;
+  while (true)
+  {
+    if (!edges->next_edge(e))
+    {
+      // Follow the last list into the next file, if it continues there
+      if (!open || next_file == num_files) break;
+      edges = std::make_unique<GraphFileReader>(
+          split_file_name(dataset, next_file++), GraphFileKind::EdgeList);
+      skip = false;
+      continue;
+    }
+    if (skip && e.src_id == skip_src) continue;
+    skip = false;
+    if (open && e.src_id != adj.node_id)
+    {
+      adj_file.add_adjlist(adj);
+      adj.clear();
+      open = false;
+      if (next_file > tid + 1) break;  // past the end of our own file
+    }
+    if (!open)
+    {
+      adj.node_id = e.src_id;
+      open = true;
+    }
+    adj.edgelist.push_back(e.dst_id);
+    if (weighted) adj.weights.push_back(e.edge_weight);
+  }
+  if (open) adj_file.add_adjlist(adj);
+  adj_file.close();
+}
+
 void delete_last_line(int _tid, const std::string& adjtype)
 {
   int tid = _tid;
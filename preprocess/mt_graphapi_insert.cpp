@@ -2,13 +2,14 @@
 
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "common_util.h"
 #include "graph_engine.h"
-#include "reader.h"
+#include "mapped_text.h"
 #include "time_structs.h"
 #include "times.h"
 #include "wiredtiger.h"
@@ -16,7 +17,13 @@
 std::vector<edge> failed_inserts;
 std::mutex fail_lock;
 
-void print_time_csvline(const graph_opts &params, time_info &t)
+// Batch sizes compared by one run; each goes into a DB of its own
+const std::vector<size_t> BATCH_SIZES = {1, 64, 1024, 65536};
+
+void print_time_csvline(const graph_opts &params,
+                        time_info &t,
+                        size_t batch_size,
+                        long double edges_per_sec)
 {
   std::ofstream log_file;
   std::string logfile_name = params.stat_log + "_api_tx.csv";
@@ -27,99 +34,87 @@ void print_time_csvline(const graph_opts &params, time_info &t)
   stat(logfile_name.c_str(), &st);
   if (st.st_size == 0)
   {
-    log_file
-        << "DB path, type, is_readopt, num_nodes, num_edges, "
-           "t_insert, t_rback, num_rback, num_fail, num_ins, num_threads\n";
+    log_file << "DB path, type, is_readopt, num_nodes, num_edges, "
+                "t_insert, t_rback, num_rback, num_fail, num_ins, "
+                "num_threads, batch_size, edges_per_sec\n";
   }
 
   log_file << params.db_dir << "/" << params.db_name << ","
-           << get_type_str(params.type) << "," << params.read_optimize << ","
+           << (params.type == GraphType::Adj ? "adj" : "split_ekey") << ","
+           << params.read_optimize << ","
            << params.num_nodes << "," << params.num_edges << ","
            << t.insert_time << "," << t.rback_time << "," << t.num_rollbacks
            << "," << t.num_failures << "," << t.num_inserted << ","
-           << params.num_threads << "\n";
+           << params.num_threads << "," << batch_size << "," << edges_per_sec
+           << "\n";
   log_file.close();
 }
 
-void insert_edge_thread(int _tid,
-                        std::string filename,
-                        int num_threads,
-                        int num_edges,
+/**
+ * Inserts the edges of one batch through GraphBase::add_edges, which retries
+ * rolled back sub-batches itself. Edges that still fail are kept for a final
+ * single threaded pass.
+ */
+void insert_batch(GraphBase *graph, std::vector<edge> &batch, time_info &info)
+{
+  std::vector<edge> failed;
+  graph->add_edges(batch, &failed);
+  for (edge &x : failed)
+  {
+    // Duplicates in the input are not worth retrying
+    if (graph->has_edge(x.src_id, x.dst_id)) continue;
+    info.num_failures++;
+    fail_lock.lock();
+    failed_inserts.push_back(x);
+    fail_lock.unlock();
+  }
+  info.num_inserted += batch.size() - failed.size();
+  batch.clear();
+}
+
+// Inserts the edges in the byte range [beg, end) of the mapped edge list
+void insert_edge_thread(reader::MappedText &edges,
+                        size_t beg,
+                        size_t end,
+                        size_t batch_size,
                         GraphBase *graph,
                         time_info &info)
 {
-  int tid = _tid;
-  int num_per_chunk = (num_edges / num_threads);
-  int beg = tid * num_per_chunk;
-
-  Times outer, inner;
+  Times outer;
   outer.start();
-  reader::EdgeReader graph_reader(
-      std::move(filename), beg, num_per_chunk, "out");
-
+  std::vector<edge> batch;
+  batch.reserve(batch_size);
   edge to_insert = {0};
-  while (graph_reader.get_next_edge(to_insert) == 0)
+  reader::LineParser lines(edges.begin() + beg, edges.begin() + end);
+  while (lines.next_line())
   {
-    int ret = graph->add_edge(to_insert, false);
-    if (ret == 0)
+    if (!lines.next(to_insert.src_id) || !lines.next(to_insert.dst_id))
     {
-      info.num_inserted++;
+      continue;
     }
-    else if (ret == WT_ROLLBACK)
+    batch.push_back(to_insert);
+    if (batch.size() == batch_size)
     {
-      inner.start();
-      info.num_rollbacks++;
-      bool succeeded = false;
-      int tries = 3;
-      do
-      {
-        ret = graph->add_edge(to_insert, false);
-        if (ret == 0)
-        {
-          info.num_inserted++;
-          succeeded = true;
-        }
-        else if (ret == WT_ROLLBACK)
-        {
-          tries--;
-          info.num_rollbacks++;
-        }
-      } while (!succeeded && tries > 0);
-
-      if (!succeeded && tries == 0)
-      {
-        info.num_failures++;
-        fail_lock.lock();
-        failed_inserts.push_back(to_insert);
-        fail_lock.unlock();
-      }
-      inner.stop();
-      info.rback_time += inner.t_micros();
+      insert_batch(graph, batch, info);
     }
   }
+  if (!batch.empty())
+  {
+    insert_batch(graph, batch, info);
+  }
   outer.stop();
   info.insert_time = outer.t_micros();
-
-  std::cout << "Time spent in retrying rollbacks: " << info.rback_time << "us";
 }
 
-int main(int argc, char *argv[])
+void run_batch_size(graph_opts opts, size_t batch_size)
 {
   time_info edge_insert_times;
-
-  InsertOpts test_params(argc, argv);
-  if (!test_params.parse_args())
-  {
-    test_params.print_help();
-    return -1;
-  }
+  failed_inserts.clear();
+  opts.db_name += "_b" + std::to_string(batch_size);
 
   Times timer;
   timer.start();
-  graph_opts opts = test_params.make_graph_opts();
   GraphEngine graphEngine(opts.num_threads, opts);
-  // GraphBase *graph = graphEngine.create_graph_handle();
-
   timer.stop();
   std::cout << " Total time to create empty DB was " << timer.t_micros()
 
@@ -128,30 +123,36 @@ int main(int argc, char *argv[])
   // Now insert edges
   timer.start();
   int NUM_THREADS = opts.num_threads;
-  std::cout << "Inserting edges with " << NUM_THREADS << " threads"
-            << std::endl;
+  std::cout << "Inserting edges with " << NUM_THREADS << " threads in batches "
+            << "of " << batch_size << std::endl;
+
+  // Each thread parses its own newline aligned part of the file; the last
+  // part runs to the end, so no line is left over
+  reader::MappedText edges(opts.dataset);
+  std::vector<std::pair<size_t, size_t>> ranges = edges.split(NUM_THREADS);
 
 #pragma omp parallel for num_threads(NUM_THREADS)
   for (int i = 0; i < NUM_THREADS; i++)
   {
     GraphBase *graph = graphEngine.create_graph_handle();
     time_info this_thread_time;
-    insert_edge_thread(i,
-                       opts.dataset,
-                       opts.num_threads,
-                       opts.num_edges,
+    insert_edge_thread(edges,
+                       ranges[i].first,
+                       ranges[i].second,
+                       batch_size,
                        graph,
                        this_thread_time);
+    graph->close(false);
+    delete graph;
 #pragma omp critical
     {
       edge_insert_times.insert_time += this_thread_time.insert_time;
       edge_insert_times.num_failures += this_thread_time.num_failures;
-      edge_insert_times.num_rollbacks += this_thread_time.num_rollbacks;
       edge_insert_times.num_inserted += this_thread_time.num_inserted;
-      edge_insert_times.rback_time += this_thread_time.rback_time;
     }
   }
   timer.stop();
+  long double edges_per_sec = edge_insert_times.num_inserted / timer.t_secs();
 
   std::cout << "Time to insert in threads: " << timer.t_secs() << "s" << endl;
 
@@ -164,27 +165,25 @@ int main(int argc, char *argv[])
   }
   timer.stop();
   cout << "Inserted the failed edges in : " << timer.t_micros() << endl;
+  graph->close(false);
+  delete graph;
+  graphEngine.force_metadata_sync();
 
   std::cout << "Insertion summary (summed for all threads):\n";
   std::cout << "Number (nodes, edges) in graph : " << opts.num_nodes << ", "
             << opts.num_edges << std::endl;
   std::cout << "Number of edges inserted: " << edge_insert_times.num_inserted
             << std::endl;
-  std::cout << "Number of Rollbacks: " << edge_insert_times.num_rollbacks
-            << endl;
   std::cout << "Number of failures: " << edge_insert_times.num_failures << endl;
-  std::cout << "Time spent in retrying rollbacks: "
-
-            << edge_insert_times.rback_time << " us" << endl;
+  std::cout << "Edges per second: " << edges_per_sec << std::endl;
   std::cout << "Total time taken : " << edge_insert_times.insert_time << "us"
 
             << endl;
 
   // Adjust for threads
-  edge_insert_times.rback_time = edge_insert_times.rback_time / NUM_THREADS;
   edge_insert_times.insert_time = edge_insert_times.insert_time / NUM_THREADS;
 
-  print_time_csvline(opts, edge_insert_times);
+  print_time_csvline(opts, edge_insert_times, batch_size, edges_per_sec);
 
   cout << "-------------------" << endl;
   for (edge x : failed_inserts)
@@ -193,5 +192,21 @@ int main(int argc, char *argv[])
   }
 
   graphEngine.close_graph();
+}
+
+int main(int argc, char *argv[])
+{
+  InsertOpts test_params(argc, argv);
+  if (!test_params.parse_args())
+  {
+    test_params.print_help();
+    return -1;
+  }
+
+  graph_opts opts = test_params.make_graph_opts();
+  for (size_t batch_size : BATCH_SIZES)
+  {
+    run_batch_size(opts, batch_size);
+  }
   return (EXIT_SUCCESS);
-}
\ No newline at end of file
+}
@@ -120,143 +120,63 @@ class Preprocess:
             print(key + ":" + str(value) + "\n")
 
     def preprocess(self):
-        ##############################
-        # sort the graph
-        ##############################
-
-        self.log("Sorting the graph")
-        sort_cmd = (f"sort -g -k1,1 -k2,2 --parallel=10 -S 10G {self.config_data['graph_path']} > "
-                    f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_sorted")
-
-        self.config_data['sorted_graph'] = f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_sorted"
-        self.log(f"Running sort command: {sort_cmd}\n")
-        if (not self.config_data['dry_run']):
-            st = time.time()
-            os.system(sort_cmd)
-            et = time.time()
-            print(f"Time taken to sort the graph: {et - st}\n")
-
-        ##############################
-        # determine num_edges from the graph
-        ##############################
-        self.log(
-            "Get the number of edges from the graph using awk")
-        # cmd = f"parallel awk -f count.awk ::: {self.config_data['output_dir']}/{self.config_data['dataset_name']}_a*" + \
-        #       "| awk '{sum += $1} END {print sum}'"
-        cmd = f"wc -l {self.config_data['output_dir']}/{self.config_data['dataset_name']}_sorted"
-        self.log(f"Running command: {cmd}\n")
-        if (not self.config_data['dry_run']):
-            st = time.time()
-            found_edges = int(check_output(cmd, shell=True).split()[0])
-            et = time.time()
-            print(f"Time taken to count the edges: {et - st}\n")
-            self.config_data['num_edges'] = found_edges
-            self.log(f"The graph has {found_edges} edges")
-            print("Found edges: " + str(found_edges))
-            self.num_edges = found_edges
-
-        ##############################
-        # Split the graph into NUM_THREADS files
-        ##############################
-        self.log(
-            f"Splitting the graph into NUM_THREAD({self.config_data['num_threads']}) files")
-        split_cmd = (
-            f"split --number=l/{self.config_data['num_threads']} {self.config_data['sorted_graph']} "
-            f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_")
-        self.log(f"Running split command: {split_cmd}\n")
-        if (not self.config_data['dry_run']):
-            st = time.time()
-            os.system(split_cmd)
-            et = time.time()
-            print(f"Time taken to split the graph: {et - st}\n")
+        out_prefix = f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}"
+        self.config_data['sorted_graph'] = f"{out_prefix}_sorted"
 
         ##############################
         # compute num_nodes from the graph
         ##############################
+        # --make-map only collects the node IDs, the edges keep their IDs
         self.log("Constructing the nodes file")
-        cmd = (
-            f"find {self.config_data['output_dir']} -type f -regex '.*/{self.config_data['dataset_name']}_\\w\\w$' -print | "
-            "parallel awk -f nodes.awk {} | "
-            f"sort -u -n > {self.config_data['output_dir']}/{self.config_data['dataset_name']}_nodes"
-        )
-        # cmd = f"ls {self.config_data['output_dir']} | grep -E '{self.config_data['dataset_name']}_\w\w$' | parallel awk -f nodes.awk " + \
-        #     "{}" + \
-        #     f" | sort -u -n >  {self.config_data['output_dir']}/{self.config_data['dataset_name']}_nodes"
-        print(cmd)
+        cmd = (f"{self.config_data['cmd_root']}/preprocess/dense_vertexranges "
+               f"--file {self.config_data['graph_path']} --make-map")
         self.log(f"Running command: {cmd}\n")
         if (not self.config_data['dry_run']):
             st = time.time()
             os.system(cmd)
             et = time.time()
             print(f"Time taken to construct the nodes file: {et - st}\n")
-        st = time.time()
-        found_nodes = int(check_output(
-            ["wc", "-l", f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_nodes"]).split()[0])
-        et = time.time()
-        print(f"Time taken to count the nodes: {et - st}\n")
-        self.config_data['num_nodes'] = found_nodes
-        self.log(f"Counting the number of nodes {found_nodes}")
-        print("Found nodes: " + str(found_nodes))
-        self.num_nodes = found_nodes
-
-        ##################################
-        # reverse the graph
-        ##################################
-        self.log("Reversing the graph")
-        reverse_cmd = (f"awk '{{print $2\"\\t\"$1}}' {self.config_data['graph_path']} > "
-                       f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse")
-        print(reverse_cmd)
-
-        self.log(
-            f"Generating the reverse graph (dst, src): {reverse_cmd}\n")
-        if not self.config_data['dry_run']:
-            st = time.time()
-            os.system(reverse_cmd)
-            et = time.time()
-            print(f"Time taken to reverse the graph: {et - st}\n")
-
-        sort_cmd = (f"sort -g -k1,1 -k2,2 --parallel=10 -S 10G "
-                    f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse > "
-                    f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse_sorted")
-        self.log(f"Running sort command: {sort_cmd}\n")
-        if not self.config_data['dry_run']:
-            st = time.time()
-            os.system(sort_cmd)
-            et = time.time()
-            print(f"Time taken to sort the reverse graph: {et - st}\n")
-
-        rename_cmd = (f"mv {self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse_sorted "
-                      f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse")
-        self.log(f"Renaming reverse graph: {rename_cmd}\n")
-        if (not self.config_data['dry_run']):
-            os.system(rename_cmd)
-
-        self.config_data[
-            'reverse_graph'] = f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse"
+            found_nodes = int(check_output(
+                ["wc", "-l", f"{self.config_data['graph_path']}_nodes"]).split()[0])
+            self.config_data['num_nodes'] = found_nodes
+            self.log(f"Counting the number of nodes {found_nodes}")
+            print("Found nodes: " + str(found_nodes))
+            self.num_nodes = found_nodes
 
         ##############################
-        # Split the reverse graph into NUM_THREADS files
+        # sort the graph and its reverse into NUM_THREADS binary files each
         ##############################
         self.log(
-            f"Splitting the graph into NUM_THREAD({self.config_data['num_threads']}) files")
-        split_cmd = (f"split --number=l/{self.config_data['num_threads']} {self.config_data['reverse_graph']} "
-                     f"{self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse_")
-        self.log(f"Running split command: {split_cmd}\n")
+            f"Sorting the graph into NUM_THREAD({self.config_data['num_threads']}) binary files")
+        sort_cmd = (
+            f"{self.config_data['cmd_root']}/preprocess/sort_edges --out {self.config_data['sorted_graph']} "
+            f"--parts {self.config_data['num_threads']} --threads {self.config_data['num_threads']} "
+            f"{self.config_data['graph_path']}")
+        self.log(f"Running sort command: {sort_cmd}\n")
         if (not self.config_data['dry_run']):
             st = time.time()
-            os.system(split_cmd)
+            sort_out = check_output(sort_cmd, shell=True).decode()
             et = time.time()
-            print(f"Time taken to split the reverse graph: {et - st}\n")
+            print(sort_out)
+            print(f"Time taken to sort the graph: {et - st}\n")
+            # the edge count without the repeated edges
+            for line in sort_out.splitlines():
+                if line.startswith("Edges written:"):
+                    found_edges = int(line.split(":")[1])
+            self.config_data['num_edges'] = found_edges
+            self.log(f"The graph has {found_edges} edges")
+            print("Found edges: " + str(found_edges))
+            self.num_edges = found_edges
 
         ##############################
         # Now construct the adjacency list files
         ##############################
+        # -x reads the binary split files and writes the binary out_xx and
+        # in_xx files that bulk_insert_low_mem reads
         self.log("Constructing the adjacency list files")
-        graph_type = "adj"  # not needed really, but including because getopts expects it
         cmd = (
-            f"{self.config_data['cmd_root']}/preprocess/mk_adjlists -d {self.config_data['dataset_name']} -e {self.config_data['num_edges']} "
-            f"-n {self.config_data['num_nodes']} -f {self.config_data['output_dir']}/{self.config_data['dataset_name']} -t {graph_type} "
-            f"-p {self.config_data['db_dir']} -l {self.config_data['log_dir']}/{graph_type}_rd_{self.config_data['dataset_name']}.log "
+            f"{self.config_data['cmd_root']}/preprocess/mk_adjlists -x -e {self.config_data['num_edges']} "
+            f"-n {self.config_data['num_nodes']} -f {self.config_data['sorted_graph']} "
             f"-m {self.config_data['num_threads']}")
         if self.config_data['directed']:
             cmd += " -D"
@@ -273,19 +193,7 @@ class Preprocess:
     def cleanup(self):
         # remove all the intermediate files
         self.log("Cleaning up")
-        cmd = f"rm {self.config_data['output_dir']}/{self.config_data['dataset_name']}_a*"
-        self.log(f"Running command: {cmd}\n")
-        if not self.config_data['dry_run']:
-            os.system(cmd)
-        cmd = f"rm {self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse_a*"
-        self.log(f"Running command: {cmd}\n")
-        if not self.config_data['dry_run']:
-            os.system(cmd)
-        cmd = f"rm {self.config_data['output_dir']}/{self.config_data['dataset_name']}_sorted"
-        self.log(f"Running command: {cmd}\n")
-        if not self.config_data['dry_run']:
-            os.system(cmd)
-        cmd = f"rm {self.config_data['output_dir']}/{self.config_data['dataset_name']}_reverse"
+        cmd = f"rm {self.config_data['output_dir']}/{self.config_data['dataset_name']}_sorted_*"
         self.log(f"Running command: {cmd}\n")
         if not self.config_data['dry_run']:
             os.system(cmd)
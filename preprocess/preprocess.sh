@@ -83,19 +83,26 @@ if [ $preprocess -eq 1 ]
 then
     ##remove all lines that begin with a comment
     #cp ${graph} ${graph}_orig
-    sed -e 's/\t/\n/g' ${graph} | sort -u -g > ${graph}_nodes
+    edgecnt=$(wc -l ${graph} | cut -d' '  -f1)
+
+    #CREATE NODEID MAP: writes dense_map.bin, the nodes file and the binary
+    #remapped edges files
+    ${RELEASE_PATH}/preprocess/dense_vertexranges -e ${edgecnt} -f ${graph} --binary
     nodecnt=$(wc -l ${graph}_nodes | cut -d' '  -f1)
-    edgecnt=$(wc -l ${graph})
 
-    #CREATE NODEID MAP
-    ${RELEASE_PATH}/preprocess/dense_vertexranges -n ${nodecnt} -e ${edgecnt} -f ${graph}
-    
-    #Create a nodes file
-    cut -d':' -f2 ${graph_dir}/dense_map.txt | sort -u -g  > ${graph}_nodes
     split --number=l/${NUM_FILES} ${graph}_nodes ${graph}_nodes
 
-    #construct sorted graph by merging edges files
-    sort -g ${graph}_edges* > ${graph}_sorted
+    #sort and deduplicate the edges files into the binary split files
+    #${graph}_sorted_xx and the transposed ${graph}_sorted_reverse_xx that
+    #mk_adjlists -x reads
+    sort_out=$(${RELEASE_PATH}/preprocess/sort_edges --out ${graph}_sorted --parts ${NUM_FILES} --threads ${NUM_THREADS} ${graph}_edges*)
+    echo "${sort_out}"
+    #the repeated edges are gone, so count what sort_edges kept
+    edgecnt=$(echo "${sort_out}" | awk '/Edges written/ {print $3}')
+
+    #CREATE ADJLISTS: writes the binary out_xx and in_xx files next to
+    #${graph} that bulk_insert_low_mem reads
+    ${RELEASE_PATH}/preprocess/mk_adjlists -x -f ${graph}_sorted -e ${edgecnt} -n ${nodecnt} -m ${NUM_FILES}
 fi
 
 if [ $insert -eq 1 ]
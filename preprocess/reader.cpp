@@ -15,39 +15,31 @@ namespace reader
 std::vector<edge> parse_edge_entries(std::string filename)
 {
   std::vector<edge> edges;
-  std::ifstream newfile(filename);
   std::cout << filename << std::endl;
-  if (newfile.is_open())
+  try
   {
-    std::string tp;
-    while (getline(newfile, tp))
+    MappedText text(filename);
+    // comment and empty lines are skipped by the parser
+    LineParser lines(text.begin(), text.end());
+    while (lines.next_line())
     {
-      if ((tp.compare(0, 1, "#") == 0) or (tp.compare(0, 1, "%") == 0) or
-          (tp.empty()))
+      node_id_t a, b;
+      if (!lines.next(a) || !lines.next(b))
       {
         continue;
       }
+      edge to_insert = {0};
+      to_insert.src_id = a;
+      to_insert.dst_id = b;
 
-      else
-      {
-        node_id_t a, b;
-        std::stringstream s_stream(tp);
-        s_stream >> a;
-        s_stream >> b;
-        edge to_insert = {0};
-        to_insert.src_id = a;
-        to_insert.dst_id = b;
-
-        edges.push_back(to_insert);
-        lock.lock();
-        in_adjlist[b].push_back(a);   // insert a in b's in_adjlist
-        out_adjlist[a].push_back(b);  // insert b in a's out_adjlist
-        lock.unlock();
-      }
+      edges.push_back(to_insert);
+      lock.lock();
+      in_adjlist[b].push_back(a);   // insert a in b's in_adjlist
+      out_adjlist[a].push_back(b);  // insert b in a's out_adjlist
+      lock.unlock();
     }
-    newfile.close();
   }
-  else
+  catch (const GraphException &)
   {
     std::cout << "**could not open " << filename << std::endl;
   }
@@ -57,48 +49,41 @@ std::vector<edge> parse_edge_entries(std::string filename)
 std::vector<node> parse_node_entries(std::string filename)
 {
   std::vector<node> nodes;
-  std::ifstream newfile(filename);
   std::cout << filename << std::endl;
-  if (newfile.is_open())
+  try
   {
-    std::string tp;
-    while (getline(newfile, tp))
+    MappedText text(filename);
+    LineParser lines(text.begin(), text.end());
+    while (lines.next_line())
     {
-      if ((tp.compare(0, 1, "#") == 0) or (tp.compare(0, 1, "%") == 0) or
-          (tp.empty()))
+      node to_insert;
+      if (!lines.next(to_insert.id))
       {
         continue;
       }
-      else
-      {
-        node to_insert;
-        std::stringstream s_str(tp);
-        s_str >> to_insert.id;
 
-        try
-        {
-          to_insert.in_degree = in_adjlist.at(to_insert.id).size();
-        }
-        catch (const std::out_of_range &oor)
-        {
-          to_insert.in_degree = 0;
-        }
-
-        try
-        {
-          to_insert.out_degree = out_adjlist.at(to_insert.id).size();
-        }
-        catch (const std::out_of_range &oor)
-        {
-          to_insert.out_degree = 0;
-        }
+      try
+      {
+        to_insert.in_degree = in_adjlist.at(to_insert.id).size();
+      }
+      catch (const std::out_of_range &oor)
+      {
+        to_insert.in_degree = 0;
+      }
 
-        nodes.push_back(to_insert);
+      try
+      {
+        to_insert.out_degree = out_adjlist.at(to_insert.id).size();
       }
+      catch (const std::out_of_range &oor)
+      {
+        to_insert.out_degree = 0;
+      }
+
+      nodes.push_back(to_insert);
     }
-    newfile.close();
   }
-  else
+  catch (const GraphException &)
   {
     std::cout << "** could not open " << filename << std::endl;
   }
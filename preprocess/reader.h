@@ -10,6 +10,8 @@
 #include "bulk_insert.h"
 #include "common_defs.h"
 #include "common_util.h"
+#include "graph_file.h"
+#include "mapped_text.h"
 namespace reader
 {
 
@@ -22,7 +24,7 @@ class EdgeReader
   std::string filename;
   int beg_offset;
   int num_per_chunk;
-  std::ifstream edge_file;
+  MappedText edge_text;
   std::ofstream adj_file, edge_file_txt;
   adjlist node_adj_list, first_conflict, last_conflict;
   node_id_t last_node_id = 0;
@@ -35,18 +37,13 @@ class EdgeReader
              int _beg,
              int _num,
              const std::string& adj_type)
+      : edge_text(_filename)
   {
     filename = _filename;
     beg_offset = _beg;
     cur_pos = beg_offset;
     num_per_chunk = _num;
     std::ios::sync_with_stdio(false);
-        edge_file = std::ifstream(filename, std::ifstream::in);
-        //check if the file is open
-        if (!edge_file.is_open())
-        {
-            throw GraphException("Failed to open the edge file for " + filename);
-        }
 
         std::string dirname = filename.substr(0, filename.find_last_of('/'));
         // strip the filename of anything after_
@@ -69,12 +66,13 @@ class EdgeReader
   void mk_adjlist()
   {
     edge e;
-    std::string line;
-    while (getline(edge_file, line))
+    LineParser lines(edge_text.begin(), edge_text.end());
+    while (lines.next_line())
     {
-      std::stringstream s_stream(line);
-      s_stream >> e.src_id;
-      s_stream >> e.dst_id;
+      if (!lines.next(e.src_id) || !lines.next(e.dst_id))
+      {
+        continue;
+      }
 
       if (cur_pos == beg_offset)
       {
@@ -110,7 +108,6 @@ class EdgeReader
     last_conflict.edgelist = std::move(node_adj_list.edgelist);
     node_adj_list.clear();
 
-    edge_file.close();
     edge_file_txt.close();
     adj_file.close();
   }
@@ -137,107 +134,94 @@ class EdgeReader
     conflict.second = last_conflict;
     return conflict;
   }
-  ~EdgeReader()
-  {
-    edge_file.close();
-    adj_file.close();
-  }
+  ~EdgeReader() { adj_file.close(); }
 };
 
-// read from boost archive file
+// Reads the text adjacency files, or their binary AdjLists form
 class AdjReader
 {
  private:
-  std::ifstream adj_file;
-  int length = 0;
+  std::unique_ptr<GraphFileReader> adj_bin;
+  std::unique_ptr<MappedText> adj_text;
+  LineParser lines{nullptr, nullptr};
 
  public:
   explicit AdjReader(const std::string& filename)
   {
-    adj_file = std::ifstream(filename, std::ifstream::in);
-    if (!adj_file.is_open())
+    if (GraphFileReader::is_graph_file(filename))
     {
-      throw GraphException("Failed to open the adjacency file for " + filename);
+      adj_bin =
+          std::make_unique<GraphFileReader>(filename, GraphFileKind::AdjLists);
+    }
+    else
+    {
+      adj_text = std::make_unique<MappedText>(filename);
+      lines = LineParser(adj_text->begin(), adj_text->end());
     }
   }
 
   // each line has a node id, it's degree, and the list of neighbors, all
-  // separated by spaces getline from file and parse the line
+  // separated by spaces or commas. A binary file can also carry weights.
   int get_next_adjlist(adjlist& adj)
   {
-    std::string line;
-    if (getline(adj_file, line))
+    if (adj_bin != nullptr)
     {
-      std::istringstream iss(line);
-      if (iss >> adj.node_id)
-      {
-        iss >> adj.degree;
-        node_id_t n;
-        while (iss >> n)
-        {
-          adj.edgelist.push_back(n);
-          if (iss.peek() == ',')
-          {
-            iss.ignore();
-          }
-        }
-      }
-      else
-      {
-        adj_file.close();
-        std::cerr << "Error reading from file" << std::endl;
-        return -1;
-      }
-      // adj.degree = adj.edgelist.size();n
-      return 0;
+      return adj_bin->next_adjlist(adj) ? 0 : -1;
     }
-    else
+    if (!lines.next_line())
+    {
+      return -1;
+    }
+    if (!lines.next(adj.node_id))
     {
-      adj_file.close();
+      std::cerr << "Error reading from file" << std::endl;
       return -1;
     }
+    lines.next(adj.degree);
+    adj.edgelist.reserve(adj.edgelist.size() + adj.degree);
+    node_id_t n;
+    while (lines.next(n))
+    {
+      adj.edgelist.push_back(n);
+    }
+    return 0;
   }
 };
 
+// Reads a text node file, one ID per line, or its binary IdList form
 class NodeReader
 {
  private:
   std::string filename;
-  std::ifstream node_file;
-  node n;
-  int length = 0;
+  std::unique_ptr<GraphFileReader> node_bin;
+  std::unique_ptr<MappedText> node_text;
+  LineParser lines{nullptr, nullptr};
 
  public:
-  NodeReader(std::string _filename)
+  NodeReader(std::string _filename) : filename(std::move(_filename))
   {
-    filename = _filename;
-    node_file = std::ifstream(_filename, std::ifstream::in);
-    if (!node_file.is_open())
+    if (GraphFileReader::is_graph_file(filename))
+    {
+      node_bin =
+          std::make_unique<GraphFileReader>(filename, GraphFileKind::IdList);
+    }
+    else
     {
-      throw GraphException("Failed to open the node file for " + filename);
+      node_text = std::make_unique<MappedText>(filename);
+      lines = LineParser(node_text->begin(), node_text->end());
     }
-    node_file.seekg(0, node_file.end);
-    length = node_file.tellg();
-    node_file.seekg(0, node_file.beg);
   }
 
   int get_next_node(node& n)
   {
-    std::string line;
-    if ((node_file.tellg() < length))
-    {
-      getline(node_file, line);
-      std::stringstream s_str(line);
-      s_str >> n.id;
-      n.in_degree = 0;
-      n.out_degree = 0;
-      return 0;
-    }
-    else
+    if (node_bin != nullptr ? !node_bin->next_id(n.id)
+                            : !lines.next_line() || !lines.next(n.id))
     {
-      node_file.close();
       return -1;
     }
+    n.in_degree = 0;
+    n.out_degree = 0;
+    return 0;
   }
 };
 
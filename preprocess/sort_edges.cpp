@@ -0,0 +1,92 @@
+#include <getopt.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "edge_sort.h"
+
+void help()
+{
+  std::cout << "Usage: ./sort_edges --out <prefix> [--parts <n>] [--threads "
+               "<n>] [--memory <MB>] [--tmp <dir>] [--weighted] <edge "
+               "files>..."
+            << std::endl;
+  std::cout << "Sorts and deduplicates the edges of the text or binary edge "
+               "files. Writes the binary split files <prefix>_aa, ... sorted "
+               "by (src, dst) and <prefix>_reverse_aa, ... sorted by (dst, "
+               "src), as read by mk_adjlists -x. Edges beyond the memory "
+               "budget are sorted in runs under --tmp and merged."
+            << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  edge_sort_opts opts;
+  static struct option long_opts[] = {{"out", required_argument, 0, 'o'},
+                                      {"parts", required_argument, 0, 'p'},
+                                      {"threads", required_argument, 0, 'm'},
+                                      {"memory", required_argument, 0, 'M'},
+                                      {"tmp", required_argument, 0, 't'},
+                                      {"weighted", no_argument, 0, 'w'},
+                                      {0, 0, 0, 0}};
+  int option_idx = 0;
+  int c;
+  while ((c = getopt_long(
+              argc, argv, "o:p:m:M:t:w", long_opts, &option_idx)) != -1)
+  {
+    switch (c)
+    {
+      case 'o':
+        opts.out_prefix = optarg;
+        break;
+      case 'p':
+        opts.parts = atoi(optarg);
+        break;
+      case 'm':
+        opts.threads = atoi(optarg);
+        break;
+      case 'M':
+        opts.memory_mb = strtoul(optarg, nullptr, 10);
+        break;
+      case 't':
+        opts.tmp_dir = optarg;
+        break;
+      case 'w':
+        opts.text_weights = true;
+        break;
+      case ':':
+      /* missing option argument */
+      case '?':
+      default:
+        help();
+        exit(-1);
+    }
+  }
+  for (int i = optind; i < argc; i++)
+  {
+    opts.inputs.emplace_back(argv[i]);
+  }
+  if (opts.out_prefix.empty() || opts.inputs.empty() || opts.parts < 1 ||
+      opts.parts > 26 * 26 || opts.threads < 1)
+  {
+    help();
+    exit(-1);
+  }
+
+  try
+  {
+    edge_sort_stats stats = sort_edges(opts);
+    std::cout << "Edges read: " << stats.edges_read << std::endl;
+    std::cout << "Edges written: " << stats.edges_written << std::endl;
+    std::cout << "Runs: " << stats.num_runs << std::endl;
+    std::cout << "Load time: " << stats.load_secs << std::endl;
+    std::cout << "Sort and write time: " << stats.finish_secs << std::endl;
+  }
+  catch (GraphException& e)
+  {
+    std::cerr << e.what() << std::endl;
+    exit(1);
+  }
+  return (EXIT_SUCCESS);
+}
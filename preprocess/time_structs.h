@@ -33,8 +33,8 @@ class InsertOpts
   int argc_;
   char **argv_;
   std::string argstr_ =
-      "d:p:l:e:n:f:t:rDm:w";  //! Construct this after you
-                              //! finish the rest of this thing
+      "d:p:l:e:n:f:t:rDm:wC:kgbx";  //! Construct this after you
+                                   //! finish the rest of this thing
   std::vector<std::string> help_strings_;
 
   std::string db_name;
@@ -48,6 +48,9 @@ class InsertOpts
   };
   std::string logdir;
   bool read_optimize = false;
+  bool write_csr = false;
+  bool bulk_cursors = false;
+  bool binary_io = false;
 
   void add_help_message(char opt,
                         const std::string &opt_arg,
@@ -76,6 +79,12 @@ class InsertOpts
     add_help_message('D', "directed", "The graph is DIRECTED");
     add_help_message('m', "mt", "number of threads to use");
     add_help_message('w', "weighted", "The graph is weighted");
+    add_help_message(
+        'C', "codec", "adjlist codec: raw, delta, bitpack or weighted");
+    add_help_message('k', "csr", "Write mmap-able CSR sidecar files");
+    add_help_message('g', "degrees", "Write the split_ekey degree table");
+    add_help_message('b', "bulk", "Load empty tables through bulk cursors");
+    add_help_message('x', "binary", "Exchange binary graph files");
   }
 
   bool virtual parse_args()
@@ -91,7 +100,7 @@ class InsertOpts
     while ((opt_c = (signed char)getopt(argc_, argv_, argstr_.c_str())) != -1)
 
     {
-      handle_args(opt_c, optarg);
+      if (!handle_args(opt_c, optarg)) parse_result = false;
     }
     return parse_result;
   }
@@ -141,6 +150,33 @@ class InsertOpts
       case 'w':
         opts.is_weighted = true;
         break;
+      case 'C':
+        if (strcmp(opt_arg, "delta") == 0)
+          opts.adjlist_codec = AdjListCodec::DeltaVarint;
+        else if (strcmp(opt_arg, "bitpack") == 0)
+          opts.adjlist_codec = AdjListCodec::BitPacked;
+        else if (strcmp(opt_arg, "weighted") == 0)
+          opts.adjlist_codec = AdjListCodec::Weighted;
+        else if (strcmp(opt_arg, "raw") == 0)
+          opts.adjlist_codec = AdjListCodec::Raw;
+        else
+        {
+          std::cerr << "Unrecognized adjlist codec " << opt_arg << std::endl;
+          ret_val = false;
+        }
+        break;
+      case 'k':
+        write_csr = true;
+        break;
+      case 'g':
+        opts.degree_table = true;
+        break;
+      case 'b':
+        bulk_cursors = true;
+        break;
+      case 'x':
+        binary_io = true;
+        break;
       case ':':
       /* missing option argument */
       case '?':
@@ -215,6 +251,12 @@ class InsertOpts
     }
   }
 
+  [[nodiscard]] bool get_write_csr() const { return write_csr; }
+
+  [[nodiscard]] bool get_bulk_cursors() const { return bulk_cursors; }
+
+  [[nodiscard]] bool get_binary_io() const { return binary_io; }
+
   [[nodiscard]] const graph_opts &make_graph_opts()
 
   {
@@ -1,6 +1,7 @@
 #include "adj_list.h"
 
 #include <algorithm>
+#include <tuple>
 
 #include "common_util.h"
 
@@ -12,6 +13,24 @@ AdjList::AdjList(graph_opts &opt_params, WT_CONNECTION *conn)
     : GraphBase(opt_params, conn)
 
 {
+  // The compressed codecs delta encode, so they need sorted adjlists
+  if (opts.adjlist_codec == AdjListCodec::DeltaVarint ||
+      opts.adjlist_codec == AdjListCodec::BitPacked)
+  {
+    opts.sorted_adjlist = true;
+  }
+  // A weighted value holds the whole list, so it cannot be chunked
+  if (opts.adjlist_codec == AdjListCodec::Weighted &&
+      (!opts.is_weighted || is_chunked()))
+  {
+    throw GraphException(
+        "The Weighted adjlist codec needs a weighted graph in the Blob layout");
+  }
+  if (is_chunked() && opts.adjlist_chunk_size == 0)
+  {
+    throw GraphException("Chunked adjlists need a chunk size above 0");
+  }
+  batched_edge_writes = true;
   init_cursors();
 }
 
@@ -110,6 +129,13 @@ void AdjList::create_wt_tables(graph_opts &opts, WT_CONNECTION *conn)
       "Iu";  // uint32_t for in/out degree, and a variable length byte array
              // for the adjacency list. This HAS to be u. S does not work. s
              // needs the number.
+  // The Chunked layout keys every chunk by (node_id, chunk_no). The degree
+  // column then holds the number of IDs in that chunk.
+  bool chunked = (opts.adjlist_layout == AdjListLayout::Chunked);
+  if (chunked)
+  {
+    adjlist_key_format = "uu";
+  }
 
   /**
    * We only make the in_adjlist table if the graph is directed.
@@ -119,6 +145,8 @@ void AdjList::create_wt_tables(graph_opts &opts, WT_CONNECTION *conn)
   {
     // Create adjlist_in_edges table for a directed graph
     vector<string> in_adjlist_columns = {ID, IN_DEGREE, IN_ADJLIST};
+    if (chunked)
+      in_adjlist_columns.insert(in_adjlist_columns.begin() + 1, CHUNK_NO);
     CommonUtil::set_table(sess,
                           IN_ADJLIST,
                           in_adjlist_columns,
@@ -128,6 +156,8 @@ void AdjList::create_wt_tables(graph_opts &opts, WT_CONNECTION *conn)
 
   // Create adjlist_out_edges table
   vector<string> out_adjlist_columns = {ID, OUT_DEGREE, OUT_ADJLIST};
+  if (chunked)
+    out_adjlist_columns.insert(out_adjlist_columns.begin() + 1, CHUNK_NO);
   CommonUtil::set_table(sess,
                         OUT_ADJLIST,
                         out_adjlist_columns,
@@ -276,6 +306,7 @@ int AdjList::add_node(node to_insert, bool is_bulk)
 
   session->commit_transaction(session, nullptr);
   GraphBase::increment_nodes(1);
+  note_node_id(to_insert.id);
   return ret;
 }
 
@@ -368,6 +399,7 @@ int AdjList::add_node_in_txn(node to_insert, bool ignore_duplicate)
   add_adjlist(out_adjlist_cursor, to_insert, outlist);
 
   GraphBase::increment_nodes(1);
+  note_node_id(to_insert);
 }
 
 /**
@@ -385,7 +417,9 @@ int AdjList::add_adjlist(WT_CURSOR *cursor, node_id_t node_id)
     throw GraphException("Uninitiated Cursor passed to add_adjlist call");
   }
 
-  CommonUtil::set_key(cursor, node_id);
+  // In the Chunked layout, chunk 0 always exists for a node.
+  is_chunked() ? CommonUtil::set_key(cursor, node_id, 0)
+               : CommonUtil::set_key(cursor, node_id);
 
   // Now, initialize the in/out degree to 0 and adjlist to empty list
   WT_ITEM item = {.data = {}, .size = 0};  // todo: check
@@ -396,9 +430,13 @@ int AdjList::add_adjlist(WT_CURSOR *cursor, node_id_t node_id)
 
 // TODO: Clarify use case of this method, may result in inconsistencies between
 // in/out adjlist tables and in/out degree within node table
+// If opts.sorted_adjlist is set, list is sorted in place before it is written.
+// The Weighted codec needs weights, one per ID in list, which are stored and
+// sorted along with it; the other codecs ignore them.
 void AdjList::add_adjlist(WT_CURSOR *cursor,
                           node_id_t node_id,
-                          std::vector<node_id_t> &list)
+                          std::vector<node_id_t> &list,
+                          std::vector<edgeweight_t> *weights)
 {
   // Check if the cursor is not NULL, else throw exception
   if (cursor == nullptr)
@@ -406,13 +444,66 @@ void AdjList::add_adjlist(WT_CURSOR *cursor,
     throw GraphException("Uninitiated Cursor passed to add_adjlist call");
   }
 
+  bool with_weights =
+      opts.adjlist_codec == AdjListCodec::Weighted && !list.empty();
+  if (with_weights && (weights == nullptr || weights->size() != list.size()))
+  {
+    throw GraphException("The Weighted adjlist codec needs a weight for every "
+                         "neighbour of node " +
+                         std::to_string(node_id));
+  }
+
+  if (opts.sorted_adjlist)
+  {
+    if (with_weights)
+    {
+      AdjCodec::sort_weighted(list, *weights);
+    }
+    else
+    {
+      std::sort(list.begin(), list.end());
+    }
+  }
+
+  if (is_chunked())
+  {
+    // Write the list out as full chunks, chunk 0 is written even if empty.
+    // Sorted chunks are keyed by their lowest ID instead of a sequence number.
+    degree_t chunk_size = opts.adjlist_chunk_size;
+    node_id_t chunk_no = 0;
+    size_t offset = 0;
+    std::vector<uint8_t> buf;
+    do
+    {
+      size_t count = std::min<size_t>(chunk_size, list.size() - offset);
+      WT_ITEM chunk =
+          AdjCodec::encode(opts.adjlist_codec, list.data() + offset, count, buf);
+      if (opts.sorted_adjlist && offset > 0)
+      {
+        chunk_no = list[offset];
+      }
+      CommonUtil::set_key(cursor, node_id, chunk_no++);
+      cursor->set_value(cursor, static_cast<degree_t>(count), &chunk);
+      if (cursor->insert(cursor) != 0)
+      {
+        throw GraphException("Failed to add node_id" +
+                             std::to_string(node_id));
+      }
+      offset += count;
+    } while (offset < list.size());
+    return;
+  }
+
   CommonUtil::set_key(cursor, node_id);
 
   // Now, initialize the in/out degree to 0 and adjlist to empty list
-  WT_ITEM item;
   // item.data = CommonUtil::pack_int_vector_wti(session, list, &item.size);
-  item.data = list.data();
-  item.size = list.size() * sizeof(node_id_t);
+  std::vector<uint8_t> buf;
+  WT_ITEM item = AdjCodec::encode(opts.adjlist_codec,
+                                  list.data(),
+                                  list.size(),
+                                  buf,
+                                  with_weights ? weights->data() : nullptr);
   cursor->set_value(cursor,
                     list.size(),
                     &item);  // serialize the vector and send ""
@@ -436,6 +527,11 @@ int AdjList::delete_adjlist(WT_CURSOR *cursor, node_id_t node_id)
     throw GraphException("Uninitiated Cursor passed to delete_adjlist");
   }
 
+  if (is_chunked())
+  {
+    return delete_adjlist_chunks(cursor, node_id);
+  }
+
   CommonUtil::set_key(cursor, node_id);
   ret = error_check_remove_txn(cursor->remove(cursor));
   if (ret)
@@ -530,7 +626,10 @@ int AdjList::add_edge(edge to_insert, bool is_bulk)
   }
   // Insert the nodes into the adjacency list tables. We assume that there are
   // no duplicate edges.
-  ret = add_to_adjlists(out_adjlist_cursor, to_insert.src_id, to_insert.dst_id);
+  ret = add_to_adjlists(out_adjlist_cursor,
+                        to_insert.src_id,
+                        to_insert.dst_id,
+                        to_insert.edge_weight);
   if (ret != 0)
   {
     return ret;
@@ -538,7 +637,10 @@ int AdjList::add_edge(edge to_insert, bool is_bulk)
 
   // Update the in_adj table if the graph is directed (or the out_table for
   // the reverse edge is the graph is undirected)
-  ret = add_to_adjlists(in_adjlist_cursor, to_insert.dst_id, to_insert.src_id);
+  ret = add_to_adjlists(in_adjlist_cursor,
+                        to_insert.dst_id,
+                        to_insert.src_id,
+                        to_insert.edge_weight);
   if (ret)
   {
     return ret;
@@ -561,20 +663,152 @@ int AdjList::add_edge(edge to_insert, bool is_bulk)
     }
   }
   session->commit_transaction(session, nullptr);
-  std::cout << "number of nodes before:" << GraphBase::get_num_nodes()
-            << std::endl;
-  std::cout << "number of nodes added: " << num_nodes_added << std::endl;
-  std::cout << "number of nodes after:" << GraphBase::get_num_nodes()
-            << std::endl;
+  LOG_MSG("Added edge ({}, {}) and {} nodes",
+          to_insert.src_id,
+          to_insert.dst_id,
+          num_nodes_added);
   GraphBase::increment_nodes(num_nodes_added);
   GraphBase::increment_edges(1);
   if (!opts.is_directed)
   {
     GraphBase::increment_edges(1);
   }
+  note_node_id(to_insert.src_id);
+  note_node_id(to_insert.dst_id);
   return ret;
 }
 
+/**
+ * @brief Inserts a batch of edges sorted by (src, dst) in one transaction.
+ * Each endpoint is created at most once, every adjacency list the batch
+ * touches is rewritten once and, in read optimized graphs, every degree is
+ * updated once. Called through GraphBase::add_edges().
+ *
+ * @returns 0 if the batch was committed
+ * @returns WT_ROLLBACK or WT_DUPLICATE_KEY (an edge already exists) if the
+ * transaction was rolled back
+ */
+int AdjList::add_edge_batch(std::span<const edge> batch)
+{
+  int ret;
+  std::vector<node_id_t> ids;
+  ids.reserve(batch.size() * 2);
+  for (const edge &e : batch)
+  {
+    ids.push_back(e.src_id);
+    ids.push_back(e.dst_id);
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  session->begin_transaction(session, "isolation=snapshot");
+  /*****Insert the endpoints that don't exist yet.*****/
+  int num_nodes_added = 0;
+  for (node_id_t id : ids)
+  {
+    node to_add{.id = id};
+    ret = add_node_in_txn(to_add, true);  // ok to have duplicate key
+    if (ret == 0)
+    {
+      num_nodes_added++;
+    }
+    else if (ret != WT_DUPLICATE_KEY)
+    {
+      return ret;  // rolled back
+    }
+  }
+
+  /***** Insert edges *****/
+  auto insert_edge = [&](node_id_t src, node_id_t dst, edgeweight_t weight)
+  {
+    CommonUtil::set_key(edge_cursor, src, dst);
+    edge_cursor->set_value(edge_cursor, opts.is_weighted ? weight : 0);
+    return error_check_insert_txn(edge_cursor->insert(edge_cursor), false);
+  };
+  for (const edge &e : batch)
+  {
+    if ((ret = insert_edge(e.src_id, e.dst_id, e.edge_weight)))
+    {
+      return ret;
+    }
+    if (!opts.is_directed &&
+        (ret = insert_edge(e.dst_id, e.src_id, e.edge_weight)))
+    {
+      return ret;
+    }
+  }
+
+  // Degree changes, indexed like ids
+  std::vector<int32_t> in_change(ids.size(), 0), out_change(ids.size(), 0);
+  auto id_index = [&](node_id_t id)
+  { return std::lower_bound(ids.begin(), ids.end(), id) - ids.begin(); };
+
+  /***** Append to the out adjlists, one run of sources at a time *****/
+  std::vector<node_id_t> nbrs;
+  std::vector<edgeweight_t> weights;
+  for (size_t i = 0; i < batch.size();)
+  {
+    node_id_t src = batch[i].src_id;
+    nbrs.clear();
+    weights.clear();
+    for (; i < batch.size() && batch[i].src_id == src; i++)
+    {
+      nbrs.push_back(batch[i].dst_id);
+      weights.push_back(batch[i].edge_weight);
+    }
+    if ((ret = add_to_adjlists(out_adjlist_cursor, src, nbrs, weights)))
+    {
+      return ret;
+    }
+    out_change[id_index(src)] += (int32_t)nbrs.size();
+  }
+
+  /***** Append to the in adjlists (the reverse lists if undirected) *****/
+  std::vector<std::tuple<node_id_t, node_id_t, edgeweight_t>> reversed;
+  reversed.reserve(batch.size());
+  for (const edge &e : batch)
+  {
+    reversed.emplace_back(e.dst_id, e.src_id, e.edge_weight);
+  }
+  std::sort(reversed.begin(), reversed.end());
+  for (size_t i = 0; i < reversed.size();)
+  {
+    node_id_t dst = std::get<0>(reversed[i]);
+    nbrs.clear();
+    weights.clear();
+    for (; i < reversed.size() && std::get<0>(reversed[i]) == dst; i++)
+    {
+      nbrs.push_back(std::get<1>(reversed[i]));
+      weights.push_back(std::get<2>(reversed[i]));
+    }
+    if ((ret = add_to_adjlists(in_adjlist_cursor, dst, nbrs, weights)))
+    {
+      return ret;
+    }
+    in_change[id_index(dst)] += (int32_t)nbrs.size();
+  }
+
+  if (this->opts.read_optimize)
+  {
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      if ((ret = update_node_degree(
+               node_cursor, ids[i], in_change[i], out_change[i])))
+      {
+        return ret;
+      }
+    }
+  }
+  session->commit_transaction(session, nullptr);
+  GraphBase::increment_nodes(num_nodes_added);
+  GraphBase::increment_edges(
+      (int)(opts.is_directed ? batch.size() : 2 * batch.size()));
+  // ids is sorted, so its ends are the only IDs that can move the bounds
+  note_node_id(ids.front());
+  note_node_id(ids.back());
+  return 0;
+}
+
 node AdjList::get_random_node()
 {
   node found = {0};
@@ -665,6 +899,7 @@ int AdjList::delete_node(node_id_t to_delete)
   session->commit_transaction(session, nullptr);
   GraphBase::increment_nodes(-1);
   GraphBase::increment_edges(-num_deleted_edges);
+  counters->node_deleted(to_delete);
   return ret;
 }
 
@@ -694,6 +929,10 @@ uint32_t AdjList::get_in_degree(node_id_t node_id)
     node_cursor->reset(node_cursor);
     return found.in_degree;
   }
+  else if (is_chunked())
+  {
+    return get_adjlist(in_adjlist_cursor, node_id).size();
+  }
   else
   {
     CommonUtil::set_key(in_adjlist_cursor, node_id);
@@ -707,7 +946,8 @@ uint32_t AdjList::get_in_degree(node_id_t node_id)
     }
     adjlist in_edges;
     in_edges.node_id = node_id;
-    CommonUtil::record_to_adjlist(in_adjlist_cursor, &in_edges);
+    CommonUtil::record_to_adjlist(
+        in_adjlist_cursor, &in_edges, opts.adjlist_codec);
     in_adjlist_cursor->reset(in_adjlist_cursor);
     return in_edges.degree;
   }
@@ -738,6 +978,10 @@ uint32_t AdjList::get_out_degree(node_id_t node_id)
     return found.out_degree;
   }
 
+  else if (is_chunked())
+  {
+    return get_adjlist(out_adjlist_cursor, node_id).size();
+  }
   else
   {
     CommonUtil::set_key(out_adjlist_cursor, node_id);
@@ -750,7 +994,8 @@ uint32_t AdjList::get_out_degree(node_id_t node_id)
     }
     adjlist out_edges;
     out_edges.node_id = node_id;
-    CommonUtil::record_to_adjlist(out_adjlist_cursor, &out_edges);
+    CommonUtil::record_to_adjlist(
+        out_adjlist_cursor, &out_edges, opts.adjlist_codec);
     out_adjlist_cursor->reset(out_adjlist_cursor);
     return out_edges.degree;
   }
@@ -868,12 +1113,257 @@ edge AdjList::get_edge(node_id_t src_id, node_id_t dst_id)
 bool AdjList::has_edge(node_id_t src_id, node_id_t dst_id)
 {
   int ret;
+  if (opts.sorted_adjlist)
+  {
+    return has_edge_in_adjlist(src_id, dst_id);
+  }
   CommonUtil::set_key(edge_cursor, src_id, dst_id);
   ret = edge_cursor->search(edge_cursor);
   edge_cursor->reset(edge_cursor);
   return (ret == 0);  // true if found :)
 }
 
+/**
+ * @brief Looks for dst_id in the (sorted) out adjacency list of src_id with a
+ * binary search over the WT value buffer. The list is not copied unless it
+ * has to be decoded first.
+ */
+bool AdjList::has_edge_in_adjlist(node_id_t src_id, node_id_t dst_id)
+{
+  int ret;
+  if (is_chunked())
+  {
+    // The chunk that can hold dst_id is keyed by the largest fence <= dst_id
+    int status;
+    CommonUtil::set_key(out_adjlist_cursor, src_id, dst_id);
+    ret = out_adjlist_cursor->search_near(out_adjlist_cursor, &status);
+    if (ret == 0 && status > 0)
+    {
+      ret = out_adjlist_cursor->prev(out_adjlist_cursor);
+    }
+    if (ret == 0)
+    {
+      node_id_t found_id, fence;
+      CommonUtil::get_key(out_adjlist_cursor, &found_id, &fence);
+      ret = (found_id == src_id) ? 0 : WT_NOTFOUND;
+    }
+  }
+  else
+  {
+    CommonUtil::set_key(out_adjlist_cursor, src_id);
+    ret = out_adjlist_cursor->search(out_adjlist_cursor);
+  }
+
+  bool found = false;
+  if (ret == 0)
+  {
+    degree_t degree;
+    WT_ITEM item;
+    out_adjlist_cursor->get_value(out_adjlist_cursor, &degree, &item);
+    if (AdjCodec::has_raw_ids(opts.adjlist_codec))
+    {
+      std::span<const node_id_t> ids =
+          AdjCodec::raw_ids(opts.adjlist_codec, item);
+      found = std::binary_search(ids.begin(), ids.end(), dst_id);
+    }
+    else
+    {
+      std::vector<node_id_t> list;
+      AdjCodec::decode(opts.adjlist_codec, item, list);
+      found = std::binary_search(list.begin(), list.end(), dst_id);
+    }
+  }
+  out_adjlist_cursor->reset(out_adjlist_cursor);
+  return found;
+}
+
+void AdjList::visit_out_neighbors(node_id_t node_id,
+                                  nbr_visitor visit,
+                                  void *ctx)
+{
+  visit_adjlist(out_adjlist_cursor, node_id, visit, ctx);
+}
+
+void AdjList::visit_in_neighbors(node_id_t node_id,
+                                 nbr_visitor visit,
+                                 void *ctx)
+{
+  visit_adjlist(in_adjlist_cursor, node_id, visit, ctx);
+}
+
+/**
+ * @brief Calls visit for every ID in node_id's adjacency list, reading the IDs
+ * straight out of the WT value (or a reused decode buffer) one chunk at a
+ * time. Stops early if visit returns false.
+ */
+void AdjList::visit_adjlist(WT_CURSOR *cursor,
+                            node_id_t node_id,
+                            nbr_visitor visit,
+                            void *ctx)
+{
+  is_chunked() ? CommonUtil::set_key(cursor, node_id, 0)
+               : CommonUtil::set_key(cursor, node_id);
+  int ret = cursor->search(cursor);
+  bool more = true;
+  while (ret == 0 && more)
+  {
+    degree_t count;
+    WT_ITEM item;
+    cursor->get_value(cursor, &count, &item);
+    const node_id_t *begin, *end;
+    if (AdjCodec::has_raw_ids(opts.adjlist_codec))
+    {
+      std::span<const node_id_t> ids =
+          AdjCodec::raw_ids(opts.adjlist_codec, item);
+      begin = ids.data();
+      end = begin + ids.size();
+    }
+    else
+    {
+      visit_buf.clear();
+      AdjCodec::decode(opts.adjlist_codec, item, visit_buf);
+      begin = visit_buf.data();
+      end = begin + visit_buf.size();
+    }
+    for (const node_id_t *nbr = begin; nbr != end && more; nbr++)
+    {
+      more = visit(ctx, *nbr);
+    }
+    if (!is_chunked())
+    {
+      break;
+    }
+    // move on to the next chunk of node_id, if there is one
+    node_id_t found_id, chunk_no;
+    if ((ret = cursor->next(cursor)) == 0)
+    {
+      CommonUtil::get_key(cursor, &found_id, &chunk_no);
+      ret = (found_id == node_id) ? 0 : WT_NOTFOUND;
+    }
+  }
+  cursor->reset(cursor);
+}
+
+/**
+ * @brief Walks the out adjacency table once for the sorted node_ids. After a
+ * list is read the cursor sits on the following node's record, so a run of
+ * consecutive IDs needs a single search. Raw blob lists are passed straight
+ * out of the WT value; the other layouts go through visit_buf.
+ */
+void AdjList::visit_out_lists(std::span<const node_id_t> node_ids,
+                              list_visitor visit,
+                              void *ctx)
+{
+  WT_CURSOR *cursor = out_adjlist_cursor;
+  bool raw_view = !is_chunked() && AdjCodec::has_raw_ids(opts.adjlist_codec);
+  node_id_t curr_key = OutOfBand_ID_MAX;  // the record the cursor is on
+  int ret = 0;
+  for (node_id_t node_id : node_ids)
+  {
+    if (curr_key != node_id)
+    {
+      is_chunked() ? CommonUtil::set_key(cursor, node_id, 0)
+                   : CommonUtil::set_key(cursor, node_id);
+      if ((ret = cursor->search(cursor)) != 0)
+      {
+        curr_key = OutOfBand_ID_MAX;
+        if (!visit(ctx, node_id, {})) break;
+        continue;
+      }
+    }
+
+    std::span<const node_id_t> nbrs;
+    degree_t count;
+    WT_ITEM item;
+    cursor->get_value(cursor, &count, &item);
+    if (raw_view)
+    {
+      nbrs = AdjCodec::raw_ids(opts.adjlist_codec, item);
+    }
+    else
+    {
+      visit_buf.clear();
+      AdjCodec::decode(opts.adjlist_codec, item, visit_buf);
+      // the rest of a chunked list follows; this leaves the cursor on the
+      // next node
+      node_id_t chunk_no;
+      while (is_chunked() && (ret = cursor->next(cursor)) == 0)
+      {
+        CommonUtil::get_key(cursor, &curr_key, &chunk_no);
+        if (curr_key != node_id) break;
+        cursor->get_value(cursor, &count, &item);
+        AdjCodec::decode(opts.adjlist_codec, item, visit_buf);
+      }
+      nbrs = visit_buf;
+    }
+
+    // a raw view points into the cursor, so it moves on only after the visit
+    bool more = visit(ctx, node_id, nbrs);
+    if (!is_chunked() && (ret = cursor->next(cursor)) == 0)
+    {
+      CommonUtil::get_key(cursor, &curr_key);
+    }
+    if (ret != 0) curr_key = OutOfBand_ID_MAX;
+    if (!more) break;
+  }
+  cursor->reset(cursor);
+}
+
+/**
+ * @brief Walks the (node_id, dst) records of the edge table, which hold the
+ * weights, rather than looking every out neighbour up in it. With the
+ * Weighted codec the out adjlist record already has the weights, so the IDs
+ * and weights are read straight out of that one value.
+ */
+void AdjList::visit_out_edges(node_id_t node_id,
+                              edge_visitor visit,
+                              void *ctx)
+{
+  if (opts.adjlist_codec == AdjListCodec::Weighted)
+  {
+    CommonUtil::set_key(out_adjlist_cursor, node_id);
+    if (out_adjlist_cursor->search(out_adjlist_cursor) == 0)
+    {
+      degree_t degree;
+      WT_ITEM item;
+      out_adjlist_cursor->get_value(out_adjlist_cursor, &degree, &item);
+      std::span<const node_id_t> ids =
+          AdjCodec::raw_ids(opts.adjlist_codec, item);
+      std::span<const edgeweight_t> weights =
+          AdjCodec::raw_weights(opts.adjlist_codec, item);
+      for (size_t i = 0; i < ids.size(); i++)
+      {
+        if (!visit(ctx, ids[i], weights[i])) break;
+      }
+    }
+    out_adjlist_cursor->reset(out_adjlist_cursor);
+    return;
+  }
+
+  int status;
+  CommonUtil::set_key(edge_cursor, node_id, 0);
+  int ret = edge_cursor->search_near(edge_cursor, &status);
+  if (ret == 0 && status < 0)
+  {
+    ret = edge_cursor->next(edge_cursor);
+  }
+  while (ret == 0)
+  {
+    node_id_t src, dst;
+    edgeweight_t weight = 0;
+    CommonUtil::get_key(edge_cursor, &src, &dst);
+    if (src != node_id) break;
+    // Unweighted edge tables hold a one byte placeholder value
+    if (opts.is_weighted)
+    {
+      edge_cursor->get_value(edge_cursor, &weight);
+    }
+    if (!visit(ctx, dst, weight)) break;
+    ret = edge_cursor->next(edge_cursor);
+  }
+  edge_cursor->reset(edge_cursor);
+}
+
 /**
  * @brief update the in/out degree for the node identified by node_id
  . The key must already be set in the cursor.
@@ -903,7 +1393,10 @@ int AdjList::update_node_degree(WT_CURSOR *cursor,
   opts.is_directed ? found.in_degree += indeg_change
                    : found.out_degree += indeg_change;
 
-  CommonUtil::dump_node(found);
+  LOG_MSG("Node {} degrees now in: {} out: {}",
+          node_id,
+          found.in_degree,
+          found.out_degree);
 
   opts.is_directed
       ? cursor->set_value(cursor, found.in_degree, found.out_degree)
@@ -989,6 +1482,18 @@ std::vector<edge> AdjList::get_out_edges(node_id_t node_id)
   {
     throw GraphException("There is no node with ID " + to_string(node_id));
   }
+  if (opts.adjlist_codec == AdjListCodec::Weighted)
+  {
+    // the weights are stored next to the IDs, no edge table lookups needed
+    adjlist found = get_adjlist_record(out_adjlist_cursor, node_id);
+    for (size_t i = 0; i < found.edgelist.size(); i++)
+    {
+      out_edges.push_back({.src_id = node_id,
+                           .dst_id = found.edgelist[i],
+                           .edge_weight = found.weights[i]});
+    }
+    return out_edges;
+  }
   dst_nodes = get_adjlist(out_adjlist_cursor, node_id);
 
   for (auto dst : dst_nodes)
@@ -1070,6 +1575,17 @@ std::vector<edge> AdjList::get_in_edges(node_id_t node_id)
   std::vector<node_id_t> src_nodes;
   int ret;
 
+  if (opts.adjlist_codec == AdjListCodec::Weighted)
+  {
+    adjlist found = get_adjlist_record(in_adjlist_cursor, node_id);
+    for (size_t i = 0; i < found.edgelist.size(); i++)
+    {
+      in_edges.push_back({.src_id = found.edgelist[i],
+                          .dst_id = node_id,
+                          .edge_weight = found.weights[i]});
+    }
+    return in_edges;
+  }
   src_nodes = get_adjlist(in_adjlist_cursor, node_id);
 
   for (auto src : src_nodes)
@@ -1196,6 +1712,50 @@ int AdjList::delete_edge(node_id_t src_id, node_id_t dst_id)
                          std::to_string(src_id) + ", " +
                          std::to_string(dst_id) + ")");
   }
+  if (opts.adjlist_codec == AdjListCodec::Weighted)
+  {
+    // The in list of an undirected graph is dst's out list, which holds the
+    // reverse edge; that one is left alone like its edge table record.
+    if (set_adjlist_weight(out_adjlist_cursor, src_id, dst_id, edge_weight) ||
+        (opts.is_directed &&
+         set_adjlist_weight(in_adjlist_cursor, dst_id, src_id, edge_weight)))
+    {
+      throw GraphException("Could not update the adjlist weight of edge (" +
+                           std::to_string(src_id) + ", " +
+                           std::to_string(dst_id) + ")");
+    }
+  }
+}
+
+/**
+ * @brief Sets the weight stored with nbr in the Weighted adjlist of node_id.
+ * @return 0 on success, WT_NOTFOUND if nbr is not in the list, or the error
+ * from reading or writing the record
+ */
+int AdjList::set_adjlist_weight(WT_CURSOR *cursor,
+                                node_id_t node_id,
+                                node_id_t nbr,
+                                edgeweight_t weight)
+{
+  int ret;
+  CommonUtil::set_key(cursor, node_id);
+  if ((ret = cursor->search(cursor)) != 0)
+  {
+    cursor->reset(cursor);
+    return ret;
+  }
+  adjlist found;
+  found.node_id = node_id;
+  CommonUtil::record_to_adjlist(cursor, &found, opts.adjlist_codec);
+  auto pos = std::find(found.edgelist.begin(), found.edgelist.end(), nbr);
+  if (pos == found.edgelist.end())
+  {
+    cursor->reset(cursor);
+    return WT_NOTFOUND;
+  }
+  found.weights[pos - found.edgelist.begin()] = weight;
+  return CommonUtil::adjlist_to_record(
+      session, cursor, found, opts.adjlist_codec);
 }
 
 /**
@@ -1209,11 +1769,21 @@ int AdjList::delete_edge(node_id_t src_id, node_id_t dst_id)
  */
 std::vector<node_id_t> AdjList::get_adjlist(WT_CURSOR *cursor,
                                             node_id_t node_id)
+{
+  return get_adjlist_record(cursor, node_id).edgelist;
+}
+
+/**
+ * @brief Same as get_adjlist(), but returns the whole record, including the
+ * weights of a Weighted adjlist. An empty adjlist if node_id has no record.
+ */
+adjlist AdjList::get_adjlist_record(WT_CURSOR *cursor, node_id_t node_id)
 {
   int ret;
   adjlist adj_list;
 
-  CommonUtil::set_key(cursor, node_id);
+  is_chunked() ? CommonUtil::set_key(cursor, node_id, 0)
+               : CommonUtil::set_key(cursor, node_id);
   ret = cursor->search(cursor);
   if (ret == WT_NOTFOUND)
   {
@@ -1221,16 +1791,48 @@ std::vector<node_id_t> AdjList::get_adjlist(WT_CURSOR *cursor,
     return {};
   }
 
-  CommonUtil::record_to_adjlist(cursor, &adj_list);
+  is_chunked() ? (void)CommonUtil::record_to_adjlist_chunks(
+                     cursor, &adj_list, opts.adjlist_codec)
+               : CommonUtil::record_to_adjlist(
+                     cursor, &adj_list, opts.adjlist_codec);
   cursor->reset(cursor);
-  return adj_list.edgelist;
+  return adj_list;
 }
 
 int AdjList::add_to_adjlists(WT_CURSOR *cursor,
                              node_id_t node_id,
-                             node_id_t to_insert)
+                             node_id_t to_insert,
+                             edgeweight_t weight)
+{
+  return add_to_adjlists(cursor,
+                         node_id,
+                         std::span<const node_id_t>(&to_insert, 1),
+                         std::span<const edgeweight_t>(&weight, 1));
+}
+
+/**
+ * @brief Appends all of to_insert to the adjacency list of node_id with one
+ * read and one write of the record. Chunked adjlists take one append per ID.
+ * weights[i] is the weight of the edge to to_insert[i]; only the Weighted
+ * codec stores it. Must be called inside a transaction.
+ */
+int AdjList::add_to_adjlists(WT_CURSOR *cursor,
+                             node_id_t node_id,
+                             std::span<const node_id_t> to_insert,
+                             std::span<const edgeweight_t> weights)
 {
   int ret;
+  if (is_chunked())
+  {
+    for (node_id_t id : to_insert)
+    {
+      if ((ret = add_to_adjlist_chunks(cursor, node_id, id)))
+      {
+        return ret;
+      }
+    }
+    return 0;
+  }
   CommonUtil::set_key(cursor, node_id);
   ret = cursor->search(cursor);
   if (error_check_read_txn(ret))
@@ -1239,11 +1841,29 @@ int AdjList::add_to_adjlists(WT_CURSOR *cursor,
   }
   adjlist found = adjlist();
   found.node_id = node_id;
-  CommonUtil::record_to_adjlist(cursor, &found);  //<-- This works just fine.
-  found.edgelist.emplace_back(to_insert);  // this needs to be converted first.
-  found.degree += 1;
+  CommonUtil::record_to_adjlist(
+      cursor, &found, opts.adjlist_codec);  //<-- This works just fine.
+  size_t old_size = found.edgelist.size();
+  found.edgelist.insert(
+      found.edgelist.end(), to_insert.begin(), to_insert.end());
+  if (opts.adjlist_codec == AdjListCodec::Weighted)
+  {
+    found.weights.insert(found.weights.end(), weights.begin(), weights.end());
+    if (opts.sorted_adjlist)
+    {
+      AdjCodec::sort_weighted(found.edgelist, found.weights);
+    }
+  }
+  else if (opts.sorted_adjlist)
+  {
+    auto added = found.edgelist.begin() + (long)old_size;
+    std::sort(added, found.edgelist.end());
+    std::inplace_merge(found.edgelist.begin(), added, found.edgelist.end());
+  }
+  found.degree += to_insert.size();
   ret = error_check_insert_txn(
-      CommonUtil::adjlist_to_record(session, cursor, found), true);
+      CommonUtil::adjlist_to_record(session, cursor, found, opts.adjlist_codec),
+      true);
   if (ret != 0)
   {
     DEBUG_MSG("Could not insert adjlist for " + std::to_string(node_id) +
@@ -1259,6 +1879,10 @@ int AdjList::delete_from_adjlists(WT_CURSOR *cursor,
 {
   // Not checking for directional or undirectional that would be taken
   // care by the caller.
+  if (is_chunked())
+  {
+    return delete_from_adjlist_chunks(cursor, node_id, to_delete);
+  }
 
   int ret;
 
@@ -1270,21 +1894,235 @@ int AdjList::delete_from_adjlists(WT_CURSOR *cursor,
 
   adjlist found;
   found.node_id = node_id;
-  CommonUtil::record_to_adjlist(cursor, &found);
-  for (size_t i = 0; i < found.edgelist.size(); i++)
+  CommonUtil::record_to_adjlist(cursor, &found, opts.adjlist_codec);
+  // found.weights is empty unless the codec is Weighted
+  auto erase_at = [&](size_t i)
+  {
+    found.edgelist.erase(found.edgelist.begin() + (long)i);
+    if (!found.weights.empty())
+    {
+      found.weights.erase(found.weights.begin() + (long)i);
+    }
+  };
+  if (opts.sorted_adjlist)
   {
-    if (found.edgelist.at(i) == to_delete)
+    auto pos = std::lower_bound(
+        found.edgelist.begin(), found.edgelist.end(), to_delete);
+    if (pos != found.edgelist.end() && *pos == to_delete)
     {
-      found.edgelist.erase(found.edgelist.begin() + i);
+      erase_at(pos - found.edgelist.begin());
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < found.edgelist.size(); i++)
+    {
+      if (found.edgelist.at(i) == to_delete)
+      {
+        erase_at(i);
+      }
     }
   }
 
   found.degree = found.edgelist.size();
 
-  if ((ret = CommonUtil::adjlist_to_record(session, cursor, found)))
+  if ((ret = CommonUtil::adjlist_to_record(
+          session, cursor, found, opts.adjlist_codec)))
+  {
+    return ret;
+  }
+  cursor->reset(cursor);
+  return 0;
+}
+
+/**
+ * @brief Appends to_insert to the adjacency list of node_id in the Chunked
+ * layout. Only the tail chunk is read and rewritten; a new chunk is started
+ * once the tail holds adjlist_chunk_size IDs.
+ *
+ * With opts.sorted_adjlist, chunks are keyed (node_id, lowest ID in chunk)
+ * and to_insert goes into the chunk whose range covers it. A chunk that
+ * grows past adjlist_chunk_size is split in two.
+ *
+ * @param cursor A cursor to the in/out adjlist table
+ * @param node_id The node whose adjacency list is extended
+ * @param to_insert The ID to append
+ * @return 0 on success, WT_ROLLBACK or WT_NOTFOUND if the transaction was
+ * rolled back.
+ */
+int AdjList::add_to_adjlist_chunks(WT_CURSOR *cursor,
+                                   node_id_t node_id,
+                                   node_id_t to_insert)
+{
+  int ret, status;
+  // Position on the target chunk: the largest key <= (node_id, upper)
+  node_id_t upper = opts.sorted_adjlist ? to_insert : OutOfBand_ID_MAX;
+  CommonUtil::set_key(cursor, node_id, upper);
+  if (error_check_read_txn(ret = cursor->search_near(cursor, &status)))
+  {
+    return ret;
+  }
+  if (status > 0 && error_check_read_txn(ret = cursor->prev(cursor)))
+  {
+    return ret;
+  }
+  node_id_t found_id, chunk_no;
+  CommonUtil::get_key(cursor, &found_id, &chunk_no);
+  if (found_id != node_id)
+  {
+    return error_check_read_txn(WT_NOTFOUND);
+  }
+
+  degree_t count;
+  WT_ITEM item;
+  cursor->get_value(cursor, &count, &item);
+  std::vector<node_id_t> chunk;
+  if (opts.sorted_adjlist || count < opts.adjlist_chunk_size)
+  {
+    chunk.reserve(count + 1);
+    AdjCodec::decode(opts.adjlist_codec, item, chunk);
+  }
+  else
+  {
+    chunk_no++;  // the tail is full, start a new chunk
+  }
+
+  std::vector<node_id_t> split;
+  if (opts.sorted_adjlist)
+  {
+    chunk.insert(std::upper_bound(chunk.begin(), chunk.end(), to_insert),
+                 to_insert);
+    if (chunk.size() > opts.adjlist_chunk_size)
+    {
+      split.assign(chunk.begin() + chunk.size() / 2, chunk.end());
+      chunk.resize(chunk.size() / 2);
+    }
+  }
+  else
+  {
+    chunk.push_back(to_insert);
+  }
+
+  std::vector<uint8_t> buf;
+  WT_ITEM chunk_item = AdjCodec::encode(opts.adjlist_codec, chunk, buf);
+  CommonUtil::set_key(cursor, node_id, chunk_no);
+  cursor->set_value(cursor, static_cast<degree_t>(chunk.size()), &chunk_item);
+  ret = error_check_insert_txn(cursor->insert(cursor), false);
+  if (ret == 0 && !split.empty())
+  {
+    chunk_item = AdjCodec::encode(opts.adjlist_codec, split, buf);
+    CommonUtil::set_key(cursor, node_id, split.front());
+    cursor->set_value(
+        cursor, static_cast<degree_t>(split.size()), &chunk_item);
+    ret = error_check_insert_txn(cursor->insert(cursor), false);
+  }
+  if (ret != 0)
+  {
+    DEBUG_MSG("Could not insert adjlist chunk for " + std::to_string(node_id));
+  }
+  cursor->reset(cursor);
+  return ret;
+}
+
+/**
+ * @brief Removes to_delete from the adjacency list of node_id in the Chunked
+ * layout. Only the chunk that held to_delete is rewritten. A chunk other than
+ * chunk 0 that becomes empty is removed. Sorted chunks are found directly by
+ * their fence key, unsorted ones are scanned in order.
+ */
+int AdjList::delete_from_adjlist_chunks(WT_CURSOR *cursor,
+                                        node_id_t node_id,
+                                        node_id_t to_delete)
+{
+  int ret, status;
+  CommonUtil::set_key(
+      cursor, node_id, opts.sorted_adjlist ? to_delete : OutOfBand_ID_MIN);
+  if (error_check_read_txn(ret = cursor->search_near(cursor, &status)))
+  {
+    return ret;
+  }
+  if (status > 0 && opts.sorted_adjlist &&
+      error_check_read_txn(ret = cursor->prev(cursor)))
+  {
+    return ret;
+  }
+
+  node_id_t found_id, chunk_no;
+  CommonUtil::get_key(cursor, &found_id, &chunk_no);
+  if (found_id != node_id)
+  {
+    return error_check_read_txn(WT_NOTFOUND);
+  }
+  while (found_id == node_id)
+  {
+    degree_t count;
+    WT_ITEM item;
+    cursor->get_value(cursor, &count, &item);
+    std::vector<node_id_t> chunk;
+    AdjCodec::decode(opts.adjlist_codec, item, chunk);
+    auto pos = opts.sorted_adjlist
+                   ? std::lower_bound(chunk.begin(), chunk.end(), to_delete)
+                   : std::find(chunk.begin(), chunk.end(), to_delete);
+    if (pos != chunk.end() && *pos == to_delete)
+    {
+      chunk.erase(pos);
+      if (chunk.empty() && chunk_no != 0)
+      {
+        ret = error_check_remove_txn(cursor->remove(cursor));
+      }
+      else
+      {
+        std::vector<uint8_t> buf;
+        WT_ITEM new_item = AdjCodec::encode(opts.adjlist_codec, chunk, buf);
+        cursor->set_value(
+            cursor, static_cast<degree_t>(chunk.size()), &new_item);
+        ret = error_check_insert_txn(cursor->update(cursor), false);
+      }
+      cursor->reset(cursor);
+      return ret;
+    }
+    if (opts.sorted_adjlist || cursor->next(cursor) != 0)
+    {
+      break;
+    }
+    CommonUtil::get_key(cursor, &found_id, &chunk_no);
+  }
+  cursor->reset(cursor);
+  return 0;
+}
+
+/**
+ * @brief Removes every chunk of node_id's adjacency list from the table
+ * pointed to by the cursor.
+ */
+int AdjList::delete_adjlist_chunks(WT_CURSOR *cursor, node_id_t node_id)
+{
+  int ret;
+  node_id_t found_id, chunk_no;
+  CommonUtil::set_key(cursor, node_id, 0);
+  if ((ret = cursor->search(cursor)) == WT_NOTFOUND)
+  {
+    cursor->reset(cursor);
+    return 0;  // nothing to delete
+  }
+  if ((ret = error_check_remove_txn(ret)))
   {
     return ret;
   }
+  do
+  {
+    if ((ret = error_check_remove_txn(cursor->remove(cursor))))
+    {
+      DEBUG_MSG("Failed to delete adjlist for node_id " +
+                std::to_string(node_id) + "; TX rolled back.");
+      return ret;
+    }
+    if (cursor->next(cursor) != 0)
+    {
+      break;
+    }
+    CommonUtil::get_key(cursor, &found_id, &chunk_no);
+  } while (found_id == node_id);
   cursor->reset(cursor);
   return 0;
 }
@@ -1301,57 +2139,45 @@ int AdjList::delete_from_adjlists(WT_CURSOR *cursor,
   WT_CURSOR *in_cursor = nullptr;
   _get_table_cursor(
       IN_ADJLIST, &in_cursor, session, false, false, opts.checkpoint_name);
-  CommonUtil::set_key(in_cursor, node_id);
+  WT_CURSOR *out_cursor = nullptr;
+  _get_table_cursor(
+      OUT_ADJLIST, &out_cursor, session, false, false, opts.checkpoint_name);
 
-  if (in_cursor->search(in_cursor) != 0)
+  // A chunked list is found by its first chunk
+  for (WT_CURSOR *cursor : {in_cursor, out_cursor})
   {
-    throw GraphException("Could not find " + std::to_string(node_id) +
-                         " in the AdjList Table");
+    is_chunked() ? CommonUtil::set_key(cursor, node_id, 0)
+                 : CommonUtil::set_key(cursor, node_id);
+    if (cursor->search(cursor) != 0)
+    {
+      throw GraphException("Could not find " + std::to_string(node_id) +
+                           " in the AdjList Table");
+    }
+    cursor->reset(cursor);
   }
 
-  in_edgelist = get_adjlist(in_cursor, node_id);
   // Iterate through the in_edgelist in the OUT_ADJLIST and delete the
   // node_id from its neighbors
-
-  WT_CURSOR *out_cursor = nullptr;
-  _get_table_cursor(
-      OUT_ADJLIST, &out_cursor, session, false, false, opts.checkpoint_name);
-
+  in_edgelist = get_adjlist(in_cursor, node_id);
   for (auto neighbor : in_edgelist)
   {
     delete_from_adjlists(out_cursor, neighbor, node_id);
   }
 
-  // Now, get the out_edgelist from the OUTLIST Table to delete from the
-  // IN_Table
-
-  CommonUtil::set_key(out_cursor, node_id);
-  if (out_cursor->search(out_cursor) != 0)
-  {
-    throw GraphException("Could not find " + std::to_string(node_id) +
-                         " in the AdjList Table");
-  }
-
-  out_edgelist = get_adjlist(out_cursor, node_id);
-
   // Now, go to IN_TABLE and delete node_id from its tables in edgelist
+  out_edgelist = get_adjlist(out_cursor, node_id);
   for (auto neighbor : out_edgelist)
   {
     delete_from_adjlists(in_cursor, neighbor, node_id);
   }
 
-  // Now, remove the node from both the tables
-  CommonUtil::set_key(out_cursor, node_id);
-
-  if (out_cursor->remove(out_cursor) != 0)
+  // Now, remove the node, every chunk of it, from both the tables
+  if (delete_adjlist(out_cursor, node_id) != 0)
   {
     throw GraphException("Could not delete node with ID " + to_string(node_id) +
                          " from the OUT_ADJLIST");
   }
-
-  CommonUtil::set_key(in_cursor, node_id);
-
-  if (in_cursor->remove(in_cursor) != 0)
+  if (delete_adjlist(in_cursor, node_id) != 0)
   {
     throw GraphException("Could not delete node with ID " + to_string(node_id) +
                          " from the IN_ADJLIST");
@@ -1482,7 +2308,11 @@ OutCursor *AdjList::get_outnbd_iter()
   OutCursor *toReturn = new AdjOutCursor(get_new_out_adjlist_cursor(),
                                          session,
                                          opts.is_directed,
-                                         opts.read_optimize);
+                                         opts.read_optimize,
+                                         is_chunked(),
+                                         opts.adjlist_codec);
+  toReturn->set_sorted(opts.sorted_adjlist);
+  toReturn->set_weighted(opts.adjlist_codec == AdjListCodec::Weighted);
   toReturn->set_key_range({OutOfBand_ID_MAX, OutOfBand_ID_MAX});
   return toReturn;
 }
@@ -1492,7 +2322,10 @@ InCursor *AdjList::get_innbd_iter()
   InCursor *toReturn = new AdjInCursor(get_new_in_adjlist_cursor(),
                                        session,
                                        opts.is_directed,
-                                       opts.read_optimize);
+                                       opts.read_optimize,
+                                       is_chunked(),
+                                       opts.adjlist_codec);
+  toReturn->set_sorted(opts.sorted_adjlist);
   toReturn->set_key_range({OutOfBand_ID_MAX, OutOfBand_ID_MAX});
   return toReturn;
 }
@@ -1744,31 +2577,46 @@ WT_CURSOR *AdjList::get_new_random_outadj_cursor()
   else if (table_name == OUT_ADJLIST)
   {
     std::ofstream outfile("outadj_dump.txt");
-    out_adjlist_cursor->reset(out_adjlist_cursor);
-    while (out_adjlist_cursor->next(out_adjlist_cursor) == 0 && num_records > 0)
-    {
-      adjlist found;
-      // found.edgelist.reserve(15000);
-      num_records--;
-      CommonUtil::get_key(out_adjlist_cursor, &found.node_id);
-      //      std::cout << "Node ID: " << found.node_id << std::endl;
-      CommonUtil::record_to_adjlist(out_adjlist_cursor, &found);
-      CommonUtil::dump_adjlist(found, outfile);
-    }
+    dump_adjlist_table(out_adjlist_cursor, outfile, num_records);
   }
   else if (table_name == IN_ADJLIST)
   {
-    std::ofstream outfile("outadj_dump.txt");
-    in_adjlist_cursor->reset(in_adjlist_cursor);
-    while (in_adjlist_cursor->next(in_adjlist_cursor) == 0 && num_records > 0)
+    std::ofstream outfile("inadj_dump.txt");
+    dump_adjlist_table(in_adjlist_cursor, outfile, num_records);
+  }
+}
+
+/**
+ * @brief Writes the first num_records adjacency lists of the table under
+ * cursor to outfile. A chunked list is stitched together and written once.
+ */
+void AdjList::dump_adjlist_table(WT_CURSOR *cursor,
+                                 std::ofstream &outfile,
+                                 int num_records)
+{
+  cursor->reset(cursor);
+  int ret = cursor->next(cursor);
+  while (ret == 0 && num_records > 0)
+  {
+    adjlist found;
+    num_records--;
+    if (is_chunked())
     {
-      adjlist found;
-      num_records--;
-      CommonUtil::get_key(in_adjlist_cursor, &found.node_id);
-      CommonUtil::record_to_adjlist(in_adjlist_cursor, &found);
-      CommonUtil::dump_adjlist(found, outfile);
+      node_id_t chunk_no;
+      CommonUtil::get_key(cursor, &found.node_id, &chunk_no);
+      // reads every chunk and moves on to the next node
+      ret = CommonUtil::record_to_adjlist_chunks(
+          cursor, &found, opts.adjlist_codec);
     }
+    else
+    {
+      CommonUtil::get_key(cursor, &found.node_id);
+      CommonUtil::record_to_adjlist(cursor, &found, opts.adjlist_codec);
+      ret = cursor->next(cursor);
+    }
+    CommonUtil::dump_adjlist(found, outfile);
   }
+  cursor->reset(cursor);
 }
 
 /**
@@ -1849,26 +2697,45 @@ int AdjList::error_check_remove_txn(int return_val)
   return return_val;
 }
 
+/**
+ * @brief The largest and smallest node IDs. Served from the bounds the
+ * inserts maintain (see graph_counters.h); the node table is only read when
+ * they are unknown, i.e. once after opening the DB or after a node on a bound
+ * was deleted, and by read-only handles, which see a checkpoint.
+ */
 node_id_t AdjList::get_max_node_id()
 {
-  WT_CURSOR *cursor = get_new_node_cursor();
-  node_id_t to_return = 0;
-  assert(cursor != nullptr);
-  cursor->prev(cursor);
-  CommonUtil::get_key(cursor, &to_return);
-  std::cout << "Max node id: " << to_return << std::endl;
-  cursor->close(cursor);
-  return to_return;
+  node_id_t min_id, max_id;
+  if (opts.read_only || !counters->node_bounds(&min_id, &max_id))
+  {
+    seek_node_bounds(&min_id, &max_id);
+  }
+  return max_id;
 }
 
 node_id_t AdjList::get_min_node_id()
+{
+  node_id_t min_id, max_id;
+  if (opts.read_only || !counters->node_bounds(&min_id, &max_id))
+  {
+    seek_node_bounds(&min_id, &max_id);
+  }
+  return min_id;
+}
+
+void AdjList::seek_node_bounds(node_id_t *min_id, node_id_t *max_id)
 {
   WT_CURSOR *cursor = get_new_node_cursor();
-  node_id_t to_return = 0;
   assert(cursor != nullptr);
-  cursor->next(cursor);
-  CommonUtil::get_key(cursor, &to_return);
-  std::cout << "Min node id: " << to_return << std::endl;
+  *min_id = 0;
+  *max_id = 0;
+  if (cursor->next(cursor) == 0)
+  {
+    CommonUtil::get_key(cursor, min_id);
+    cursor->reset(cursor);
+    cursor->prev(cursor);
+    CommonUtil::get_key(cursor, max_id);
+    if (!opts.read_only) counters->set_node_bounds(*min_id, *max_id);
+  }
   cursor->close(cursor);
-  return to_return;
 }
@@ -17,6 +17,9 @@ class AdjInCursor : public InCursor
 {
  private:
   bool all_nodes = false;
+  bool chunked = false;  // adjlists are stored in the Chunked layout
+  AdjListCodec codec = AdjListCodec::Raw;
+  bool advance_pending = false;  // next_view() left the cursor on its record
 
  public:
   void setAllNodes(bool allNodes) { all_nodes = allNodes; }
@@ -30,12 +33,16 @@ class AdjInCursor : public InCursor
   AdjInCursor(WT_CURSOR *cur,
               WT_SESSION *sess,
               bool is_directed,
-              bool read_optimized)
+              bool read_optimized,
+              bool is_chunked = false,
+              AdjListCodec adj_codec = AdjListCodec::Raw)
   {
     cursor = cur;
     session = sess;
     directed = is_directed;
     read_opt = read_optimized;
+    chunked = is_chunked;
+    codec = adj_codec;
   }
   ~AdjInCursor() override = default;
 
@@ -43,12 +50,14 @@ class AdjInCursor : public InCursor
   {
     keys = _key;
     is_first = false;
+    advance_pending = false;
 
     // Advances the cursor to the first valid record in range
     if (keys.start != OutOfBand_ID_MAX)
     {
       int status;
-      CommonUtil::set_key(cursor, keys.start);
+      chunked ? CommonUtil::set_key(cursor, keys.start, 0)
+              : CommonUtil::set_key(cursor, keys.start);
       cursor->search_near(cursor, &status);
       if (status < 0)
       {
@@ -78,16 +87,18 @@ class AdjInCursor : public InCursor
 
   void next(adjlist *found) override
   {
+    advance_if_pending();
     if (!has_next)
     {
       no_next(found);
       return;
     }
 
-    node_id_t curr_key;
+    node_id_t curr_key, chunk_no;
     do
     {
-      CommonUtil::get_key(cursor, &curr_key);
+      chunked ? CommonUtil::get_key(cursor, &curr_key, &chunk_no)
+              : CommonUtil::get_key(cursor, &curr_key);
 
       if (keys.end != OutOfBand_ID_MAX &&
           curr_key > keys.end)  // there is an end key and we have passed it
@@ -96,23 +107,105 @@ class AdjInCursor : public InCursor
         return;
       }
 
-      CommonUtil::record_to_adjlist(cursor, found);
       found->node_id = curr_key;
+      if (chunked)
+      {
+        // stitches the chunks together and advances to the next node
+        if (CommonUtil::record_to_adjlist_chunks(cursor, found, codec) != 0)
+        {
+          has_next = false;
+        }
+        continue;
+      }
+
+      CommonUtil::record_to_adjlist(cursor, found, codec);
 
       if (cursor->next(cursor) != 0)
       {
         has_next = false;
       }
-    } while (found->degree == 0 && all_nodes == false);
+    } while (found->degree == 0 && all_nodes == false && has_next);
+
+    // the table ran out while skipping empty adjlists
+    if (found->degree == 0 && all_nodes == false)
+    {
+      no_next(found);
+    }
   }
 
   void next(adjlist *found, node_id_t key) override {}
+
+  void next_view(adjlist_view *found) override
+  {
+    if (chunked || !AdjCodec::has_raw_ids(codec))
+    {
+      // the list has to be stitched together or decoded, so it is copied
+      InCursor::next_view(found);
+      return;
+    }
+
+    advance_if_pending();
+    while (has_next)
+    {
+      node_id_t curr_key;
+      CommonUtil::get_key(cursor, &curr_key);
+      if (keys.end != OutOfBand_ID_MAX && curr_key > keys.end)
+      {
+        break;
+      }
+
+      degree_t degree;
+      WT_ITEM item;
+      cursor->get_value(cursor, &degree, &item);
+      found->node_id = curr_key;
+      found->edgelist = AdjCodec::raw_ids(codec, item);
+      found->weights = AdjCodec::raw_weights(codec, item);
+      found->degree = found->edgelist.size();
+      if (found->degree != 0 || all_nodes)
+      {
+        // stay on this record so that item.data remains valid
+        advance_pending = true;
+        return;
+      }
+      if (cursor->next(cursor) != 0)
+      {
+        has_next = false;
+      }
+    }
+    found->node_id = OutOfBand_ID_MAX;
+    found->degree = UINT32_MAX;
+    found->edgelist = {};
+    found->weights = {};
+    has_next = false;
+  }
+
+  void reset() override
+  {
+    advance_pending = false;
+    table_iterator::reset();
+  }
+
+ private:
+  void advance_if_pending()
+  {
+    if (advance_pending)
+    {
+      advance_pending = false;
+      if (cursor->next(cursor) != 0)
+      {
+        has_next = false;
+      }
+    }
+  }
 };
 
 class AdjOutCursor : public OutCursor
 {
  private:
   bool all_nodes = false;
+  bool chunked = false;  // adjlists are stored in the Chunked layout
+  AdjListCodec codec = AdjListCodec::Raw;
+  bool advance_pending = false;  // next_view() left the cursor on its record
 
  public:
   AdjOutCursor(WT_CURSOR *cur, WT_SESSION *sess)
@@ -124,12 +217,16 @@ class AdjOutCursor : public OutCursor
   AdjOutCursor(WT_CURSOR *cur,
                WT_SESSION *sess,
                bool is_directed,
-               bool read_optimized)
+               bool read_optimized,
+               bool is_chunked = false,
+               AdjListCodec adj_codec = AdjListCodec::Raw)
   {
     cursor = cur;
     session = sess;
     directed = is_directed;
     read_opt = read_optimized;
+    chunked = is_chunked;
+    codec = adj_codec;
   }
   ~AdjOutCursor() override = default;
   void setAllNodes(bool allNodes) { all_nodes = allNodes; }
@@ -149,11 +246,13 @@ class AdjOutCursor : public OutCursor
   {
     keys = _keys;
     is_first = false;
+    advance_pending = false;
 
     if (keys.start != OutOfBand_ID_MAX)
     {
       int status;
-      CommonUtil::set_key(cursor, keys.start);
+      chunked ? CommonUtil::set_key(cursor, keys.start, 0)
+              : CommonUtil::set_key(cursor, keys.start);
       cursor->search_near(cursor, &status);
       if (status < 0)
       {
@@ -175,16 +274,18 @@ class AdjOutCursor : public OutCursor
   }
   void next(adjlist *found) override
   {
+    advance_if_pending();
     if (!has_next)
     {
       no_next(found);
       return;
     }
 
-    node_id_t curr_key;
+    node_id_t curr_key, chunk_no;
     do
     {
-      CommonUtil::get_key(cursor, &curr_key);
+      chunked ? CommonUtil::get_key(cursor, &curr_key, &chunk_no)
+              : CommonUtil::get_key(cursor, &curr_key);
 
       if (keys.end != OutOfBand_ID_MAX && curr_key > keys.end)
       {
@@ -192,17 +293,138 @@ class AdjOutCursor : public OutCursor
         return;
       }
 
-      CommonUtil::record_to_adjlist(cursor, found);
       found->node_id = curr_key;
+      if (chunked)
+      {
+        // stitches the chunks together and advances to the next node
+        if (CommonUtil::record_to_adjlist_chunks(cursor, found, codec) != 0)
+        {
+          has_next = false;
+        }
+        continue;
+      }
+
+      CommonUtil::record_to_adjlist(cursor, found, codec);
 
       if (cursor->next(cursor) != 0)
       {
         has_next = false;
       }
-    } while (found->degree == 0 && all_nodes == false);
+    } while (found->degree == 0 && all_nodes == false && has_next);
+
+    // the table ran out while skipping empty adjlists
+    if (found->degree == 0 && all_nodes == false)
+    {
+      no_next(found);
+    }
   }
 
   void next(adjlist *found, node_id_t key) override {}
+
+  void next_view(adjlist_view *found) override
+  {
+    if (chunked || !AdjCodec::has_raw_ids(codec))
+    {
+      // the list has to be stitched together or decoded, so it is copied
+      OutCursor::next_view(found);
+      return;
+    }
+
+    advance_if_pending();
+    while (has_next)
+    {
+      node_id_t curr_key;
+      CommonUtil::get_key(cursor, &curr_key);
+      if (keys.end != OutOfBand_ID_MAX && curr_key > keys.end)
+      {
+        break;
+      }
+
+      degree_t degree;
+      WT_ITEM item;
+      cursor->get_value(cursor, &degree, &item);
+      found->node_id = curr_key;
+      found->edgelist = AdjCodec::raw_ids(codec, item);
+      found->weights = AdjCodec::raw_weights(codec, item);
+      found->degree = found->edgelist.size();
+      if (found->degree != 0 || all_nodes)
+      {
+        // stay on this record so that item.data remains valid
+        advance_pending = true;
+        return;
+      }
+      if (cursor->next(cursor) != 0)
+      {
+        has_next = false;
+      }
+    }
+    found->node_id = OutOfBand_ID_MAX;
+    found->degree = UINT32_MAX;
+    found->edgelist = {};
+    found->weights = {};
+    has_next = false;
+  }
+
+  // Decodes each value straight into the flat neighbour array of the batch
+  size_t next_batch(adjlist_batch &batch,
+                    size_t max_nodes,
+                    size_t max_edges) override
+  {
+    if (chunked)
+    {
+      // a list spans several records, which next() stitches together
+      return OutCursor::next_batch(batch, max_nodes, max_edges);
+    }
+
+    batch.clear();
+    advance_if_pending();
+    while (has_next && batch.size() < max_nodes &&
+           batch.edges.size() < max_edges)
+    {
+      node_id_t curr_key;
+      CommonUtil::get_key(cursor, &curr_key);
+      if (keys.end != OutOfBand_ID_MAX && curr_key > keys.end)
+      {
+        has_next = false;
+        break;
+      }
+
+      degree_t degree;
+      WT_ITEM item;
+      cursor->get_value(cursor, &degree, &item);
+      size_t start = batch.edges.size();
+      AdjCodec::decode(codec, item, batch.edges);
+      AdjCodec::decode_weights(codec, item, batch.weights);
+      if (batch.edges.size() > start || all_nodes)
+      {
+        batch.end_list(curr_key);
+      }
+      if (cursor->next(cursor) != 0)
+      {
+        has_next = false;
+      }
+    }
+    return batch.size();
+  }
+
+  void reset() override
+  {
+    advance_pending = false;
+    table_iterator::reset();
+  }
+
+ private:
+  void advance_if_pending()
+  {
+    if (advance_pending)
+    {
+      advance_pending = false;
+      if (cursor->next(cursor) != 0)
+      {
+        has_next = false;
+      }
+    }
+  }
 };
 
 class AdjNodeCursor : public NodeCursor
@@ -449,6 +671,7 @@ class AdjList : public GraphBase
   std::vector<node> get_in_nodes(node_id_t node_id) override;
   std::vector<node_id_t> get_in_nodes_id(node_id_t node_id) override;
   std::vector<node_id_t> get_adjlist(WT_CURSOR *cursor, node_id_t node_id);
+  adjlist get_adjlist_record(WT_CURSOR *cursor, node_id_t node_id);
 
   node_id_t get_max_node_id() override;
   node_id_t get_min_node_id() override;
@@ -479,7 +702,8 @@ class AdjList : public GraphBase
   // making this public because needed for graferee
   void add_adjlist(WT_CURSOR *cursor,
                    node_id_t node_id,
-                   std::vector<node_id_t> &list);
+                   std::vector<node_id_t> &list,
+                   std::vector<edgeweight_t> *weights = nullptr);
   [[maybe_unused]] void dump_table(std::string &table_name, int limit = 0);
 
  private:
@@ -490,6 +714,7 @@ class AdjList : public GraphBase
   WT_CURSOR *edge_cursor = nullptr;
   WT_CURSOR *in_adjlist_cursor = nullptr;
   WT_CURSOR *out_adjlist_cursor = nullptr;
+  std::vector<node_id_t> visit_buf;  // decoded list for visit_adjlist
 
   // AdjList specific internal methods:
   [[maybe_unused]] node get_next_node(WT_CURSOR *n_cur);
@@ -500,7 +725,49 @@ class AdjList : public GraphBase
   [[maybe_unused]] void delete_node_from_adjlists(node_id_t node_id);
   int add_to_adjlists(WT_CURSOR *cursor,
                       node_id_t node_id,
-                      node_id_t to_insert);
+                      node_id_t to_insert,
+                      edgeweight_t weight);
+  int add_to_adjlists(WT_CURSOR *cursor,
+                      node_id_t node_id,
+                      std::span<const node_id_t> to_insert,
+                      std::span<const edgeweight_t> weights);
+  int set_adjlist_weight(WT_CURSOR *cursor,
+                         node_id_t node_id,
+                         node_id_t nbr,
+                         edgeweight_t weight);
+  int add_edge_batch(std::span<const edge> batch) override;
+  void seek_node_bounds(node_id_t *min_id, node_id_t *max_id);
+  int add_to_adjlist_chunks(WT_CURSOR *cursor,
+                            node_id_t node_id,
+                            node_id_t to_insert);
+  int delete_from_adjlist_chunks(WT_CURSOR *cursor,
+                                 node_id_t node_id,
+                                 node_id_t to_delete);
+  int delete_adjlist_chunks(WT_CURSOR *cursor, node_id_t node_id);
+  void dump_adjlist_table(WT_CURSOR *cursor,
+                          std::ofstream &outfile,
+                          int num_records);
+  bool has_edge_in_adjlist(node_id_t src_id, node_id_t dst_id);
+  void visit_out_neighbors(node_id_t node_id,
+                           nbr_visitor visit,
+                           void *ctx) override;
+  void visit_in_neighbors(node_id_t node_id,
+                          nbr_visitor visit,
+                          void *ctx) override;
+  void visit_adjlist(WT_CURSOR *cursor,
+                     node_id_t node_id,
+                     nbr_visitor visit,
+                     void *ctx);
+  void visit_out_lists(std::span<const node_id_t> node_ids,
+                       list_visitor visit,
+                       void *ctx) override;
+  void visit_out_edges(node_id_t node_id,
+                       edge_visitor visit,
+                       void *ctx) override;
+  [[nodiscard]] bool is_chunked() const
+  {
+    return opts.adjlist_layout == AdjListLayout::Chunked;
+  }
   int delete_from_adjlists(WT_CURSOR *cursor,
                            node_id_t node_id,
                            node_id_t to_delete);
@@ -0,0 +1,302 @@
+#ifndef ADJLIST_CODEC_H
+#define ADJLIST_CODEC_H
+
+#include <wiredtiger.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "common_defs.h"
+
+/**
+ * @brief Encoders for the value ("u" column) of the AdjList in/out adjacency
+ * tables. The input must be sorted: both compressed codecs store the gaps
+ * between consecutive IDs.
+ *
+ * DeltaVarint: every gap is written as a LEB128 varint.
+ *
+ * BitPacked: StreamVByte layout. A varint count is followed by one control
+ * byte per group of four gaps (2 bits per gap giving its byte length) and
+ * then the gap bytes. Keeping the lengths apart from the data means a group
+ * can be decoded with a single shuffle; the decoder below is the scalar
+ * version of that loop.
+ *
+ * Weighted: the Raw IDs followed by one edgeweight_t per ID, i.e.
+ * {ids[n], weights[n]} in one value. The IDs are a prefix of the value, so
+ * readers that only want neighbours can still view them in place. The input
+ * does not have to be sorted.
+ */
+class AdjCodec
+{
+ public:
+  /**
+   * @brief Encodes ids into the on-disk form for codec and returns a WT_ITEM
+   * pointing to it. For Raw the item points to ids, otherwise to buf, so
+   * whichever one is used must outlive the cursor operation. weights is only
+   * read by the Weighted codec, which writes zero weights if it is null.
+   */
+  static WT_ITEM encode(AdjListCodec codec,
+                        const node_id_t *ids,
+                        size_t count,
+                        std::vector<uint8_t> &buf,
+                        const edgeweight_t *weights = nullptr)
+  {
+    WT_ITEM item;
+    if (codec == AdjListCodec::Raw || count == 0)
+    {
+      item.data = ids;
+      item.size = count * sizeof(node_id_t);
+      return item;
+    }
+    buf.clear();
+    if (codec == AdjListCodec::DeltaVarint)
+    {
+      encode_delta_varint(ids, count, buf);
+    }
+    else if (codec == AdjListCodec::BitPacked)
+    {
+      encode_stream_vbyte(ids, count, buf);
+    }
+    else
+    {
+      encode_weighted(ids, weights, count, buf);
+    }
+    item.data = buf.data();
+    item.size = buf.size();
+    return item;
+  }
+
+  static WT_ITEM encode(AdjListCodec codec,
+                        const std::vector<node_id_t> &ids,
+                        std::vector<uint8_t> &buf)
+  {
+    return encode(codec, ids.data(), ids.size(), buf);
+  }
+
+  // Encodes list.edgelist, with list.weights if it has one per neighbour
+  static WT_ITEM encode(AdjListCodec codec,
+                        const adjlist &list,
+                        std::vector<uint8_t> &buf)
+  {
+    const edgeweight_t *weights =
+        list.weights.size() == list.edgelist.size() ? list.weights.data()
+                                                    : nullptr;
+    return encode(
+        codec, list.edgelist.data(), list.edgelist.size(), buf, weights);
+  }
+
+  /**
+   * @brief Decodes the value in item and appends the IDs to out.
+   */
+  static void decode(AdjListCodec codec,
+                     const WT_ITEM &item,
+                     std::vector<node_id_t> &out)
+  {
+    const auto *begin = (const uint8_t *)item.data;
+    if (codec == AdjListCodec::Raw)
+    {
+      out.insert(out.end(),
+                 (const node_id_t *)begin,
+                 (const node_id_t *)begin + item.size / sizeof(node_id_t));
+    }
+    else if (codec == AdjListCodec::DeltaVarint)
+    {
+      decode_delta_varint(begin, begin + item.size, out);
+    }
+    else if (codec == AdjListCodec::BitPacked)
+    {
+      if (item.size != 0) decode_stream_vbyte(begin, out);
+    }
+    else
+    {
+      std::span<const node_id_t> ids = raw_ids(codec, item);
+      out.insert(out.end(), ids.begin(), ids.end());
+    }
+  }
+
+  // Appends the weights in item to out; values without weights add nothing
+  static void decode_weights(AdjListCodec codec,
+                             const WT_ITEM &item,
+                             std::vector<edgeweight_t> &out)
+  {
+    std::span<const edgeweight_t> weights = raw_weights(codec, item);
+    out.insert(out.end(), weights.begin(), weights.end());
+  }
+
+  // True if the IDs of a value can be read in place with raw_ids()
+  static bool has_raw_ids(AdjListCodec codec)
+  {
+    return codec == AdjListCodec::Raw || codec == AdjListCodec::Weighted;
+  }
+
+  /**
+   * @brief The IDs of a Raw or Weighted value, pointing into item. Only
+   * valid while item is.
+   */
+  static std::span<const node_id_t> raw_ids(AdjListCodec codec,
+                                            const WT_ITEM &item)
+  {
+    size_t entry = codec == AdjListCodec::Weighted ? weighted_entry_size
+                                                   : sizeof(node_id_t);
+    return {(const node_id_t *)item.data, item.size / entry};
+  }
+
+  // The weights of a Weighted value, pointing into item; empty otherwise
+  static std::span<const edgeweight_t> raw_weights(AdjListCodec codec,
+                                                   const WT_ITEM &item)
+  {
+    if (codec != AdjListCodec::Weighted) return {};
+    size_t count = item.size / weighted_entry_size;
+    return {(const edgeweight_t *)((const uint8_t *)item.data +
+                                   count * sizeof(node_id_t)),
+            count};
+  }
+
+  // Sorts ids ascending and permutes weights along with them
+  static void sort_weighted(std::vector<node_id_t> &ids,
+                            std::vector<edgeweight_t> &weights)
+  {
+    std::vector<std::pair<node_id_t, edgeweight_t>> pairs(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) pairs[i] = {ids[i], weights[i]};
+    std::sort(pairs.begin(), pairs.end());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      ids[i] = pairs[i].first;
+      weights[i] = pairs[i].second;
+    }
+  }
+
+ private:
+  static constexpr size_t weighted_entry_size =
+      sizeof(node_id_t) + sizeof(edgeweight_t);
+
+  // Byte lengths selected by the 2-bit StreamVByte codes
+#ifdef B64
+  static constexpr uint8_t code_len[4] = {1, 2, 4, 8};
+#else
+  static constexpr uint8_t code_len[4] = {1, 2, 3, 4};
+#endif
+
+  static void put_varint(uint64_t val, std::vector<uint8_t> &buf)
+  {
+    while (val >= 0x80)
+    {
+      buf.push_back((uint8_t)(val | 0x80));
+      val >>= 7;
+    }
+    buf.push_back((uint8_t)val);
+  }
+
+  static const uint8_t *get_varint(const uint8_t *p, uint64_t *val)
+  {
+    uint64_t result = 0;
+    int shift = 0;
+    while (*p & 0x80)
+    {
+      result |= (uint64_t)(*p++ & 0x7f) << shift;
+      shift += 7;
+    }
+    *val = result | ((uint64_t)*p++ << shift);
+    return p;
+  }
+
+  static uint8_t code_for(node_id_t gap)
+  {
+    uint8_t code = 0;
+    while (code < 3 && gap >> (8 * code_len[code]) != 0)
+    {
+      code++;
+    }
+    return code;
+  }
+
+  static void encode_delta_varint(const node_id_t *ids,
+                                  size_t count,
+                                  std::vector<uint8_t> &buf)
+  {
+    buf.reserve(count + 8);
+    node_id_t prev = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      put_varint(ids[i] - prev, buf);
+      prev = ids[i];
+    }
+  }
+
+  static void decode_delta_varint(const uint8_t *p,
+                                  const uint8_t *end,
+                                  std::vector<node_id_t> &out)
+  {
+    node_id_t prev = 0;
+    while (p < end)
+    {
+      uint64_t gap;
+      p = get_varint(p, &gap);
+      prev += (node_id_t)gap;
+      out.push_back(prev);
+    }
+  }
+
+  static void encode_weighted(const node_id_t *ids,
+                              const edgeweight_t *weights,
+                              size_t count,
+                              std::vector<uint8_t> &buf)
+  {
+    size_t id_bytes = count * sizeof(node_id_t);
+    buf.assign(count * weighted_entry_size, 0);
+    std::memcpy(buf.data(), ids, id_bytes);
+    if (weights != nullptr)
+    {
+      std::memcpy(buf.data() + id_bytes, weights, count * sizeof(edgeweight_t));
+    }
+  }
+
+  static void encode_stream_vbyte(const node_id_t *ids,
+                                  size_t count,
+                                  std::vector<uint8_t> &buf)
+  {
+    put_varint(count, buf);
+    size_t ctrl_start = buf.size();
+    size_t data_pos = ctrl_start + (count + 3) / 4;
+    buf.resize(data_pos + count * sizeof(node_id_t));
+
+    node_id_t prev = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      node_id_t gap = ids[i] - prev;
+      prev = ids[i];
+      uint8_t code = code_for(gap);
+      buf[ctrl_start + i / 4] |= code << (2 * (i % 4));
+      std::memcpy(&buf[data_pos], &gap, code_len[code]);  // little endian
+      data_pos += code_len[code];
+    }
+    buf.resize(data_pos);
+  }
+
+  static void decode_stream_vbyte(const uint8_t *p,
+                                  std::vector<node_id_t> &out)
+  {
+    uint64_t count;
+    p = get_varint(p, &count);
+    const uint8_t *ctrl = p;
+    const uint8_t *data = ctrl + (count + 3) / 4;
+
+    size_t pos = out.size();
+    out.resize(pos + count);
+    node_id_t prev = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      uint8_t code = (ctrl[i / 4] >> (2 * (i % 4))) & 0x3;
+      node_id_t gap = 0;
+      std::memcpy(&gap, data, code_len[code]);
+      data += code_len[code];
+      prev += gap;
+      out[pos + i] = prev;
+    }
+  }
+};
+
+#endif  // ADJLIST_CODEC_H
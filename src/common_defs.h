@@ -1,6 +1,7 @@
 #ifndef COMMON_DEFS_H
 #define COMMON_DEFS_H
 
+#include <span>
 #include <string>
 #include <vector>
 #define MAKE_EKEY(x) ((x) + 1)
@@ -17,18 +18,34 @@ typedef enum MetadataKey
   num_nodes,
   num_edges,
   max_node_id,
-  min_node_id
+  min_node_id,
+  adjlist_layout,
+  adjlist_chunk_size,
+  sorted_adjlist,
+  adjlist_codec,
+  partition_bounds,
+  last_checkpoint,
+  degree_table,
+  checkpoint_seq
 } MetadataKey;
 
-const std::string MetadataKeyNames[9] = {"db_name",
-                                         "db_dir",
-                                         "is_weighted",
-                                         "read_optimize",
-                                         "is_directed",
-                                         "num_nodes",
-                                         "num_edges",
-                                         "max_node_id",
-                                         "min_node_id"};
+const std::string MetadataKeyNames[17] = {"db_name",
+                                          "db_dir",
+                                          "is_weighted",
+                                          "read_optimize",
+                                          "is_directed",
+                                          "num_nodes",
+                                          "num_edges",
+                                          "max_node_id",
+                                          "min_node_id",
+                                          "adjlist_layout",
+                                          "adjlist_chunk_size",
+                                          "sorted_adjlist",
+                                          "adjlist_codec",
+                                          "partition_bounds",
+                                          "last_checkpoint",
+                                          "degree_table",
+                                          "checkpoint_seq"};
 
 const std::string METADATA = "metadata";
 // Read Optimize columns
@@ -53,9 +70,11 @@ const std::string DST_SRC_INDEX = "IX_edge_" + DST + SRC;
 // specific to AdjList implementation
 const std::string OUT_ADJLIST = "adjlistout";
 const std::string IN_ADJLIST = "adjlistin";
+const std::string CHUNK_NO = "chunk_no";
 // specific to EdgeKeySplit implementation
 const std::string OUT_EDGES = "edge_out";
 const std::string IN_EDGES = "edge_in";
+const std::string DEGREE_TABLE = "degrees";
 const std::string node_count = "nNodes";
 const std::string edge_count = "nEdges";
 
@@ -78,6 +97,11 @@ const node_id_t OutOfBand_ID_MAX = UINT64_MAX;
 const degree_t OutOfBand_ID_MAX = UINT32_MAX;
 #endif
 
+// Most edges GraphBase::add_edges writes in one transaction
+const size_t EDGE_BATCH_TXN_MAX = 4096;
+// Attempts add_edges makes for a single edge that keeps hitting WT_ROLLBACK
+const int EDGE_BATCH_MAX_RETRIES = 8;
+
 typedef enum GraphType
 {
   Adj,
@@ -86,6 +110,45 @@ typedef enum GraphType
   META
 } GraphType;
 
+/**
+ * @brief On-disk layout of the AdjList in/out adjacency tables.
+ * Blob keeps one record per node holding the whole list. Chunked splits the
+ * list into records keyed (node_id, chunk_no) of at most adjlist_chunk_size
+ * IDs each, so an insert only rewrites the tail chunk.
+ */
+typedef enum AdjListLayout
+{
+  Blob,
+  Chunked
+} AdjListLayout;
+
+/**
+ * @brief Encoding of the IDs in an AdjList adjacency record (see
+ * adjlist_codec.h). The compressed codecs store gaps between sorted IDs, so
+ * DeltaVarint and BitPacked imply sorted_adjlist. Weighted stores the Raw IDs
+ * followed by the weight of every edge, so a weighted graph gets neighbours
+ * and weights without probing the edge table.
+ */
+typedef enum AdjListCodec
+{
+  Raw,
+  DeltaVarint,
+  BitPacked,
+  Weighted
+} AdjListCodec;
+
+/**
+ * @brief How GraphEngine::calculate_thread_offsets splits the node ID space.
+ * IdRange cuts [min_node_id, max_node_id] into ranges of equal width.
+ * DegreeBalanced cuts at the out-degree prefix sums so that every range holds
+ * roughly the same number of edges.
+ */
+typedef enum PartitionMode
+{
+  IdRange,
+  DegreeBalanced
+} PartitionMode;
+
 struct graph_opts
 {
   bool read_only = false;
@@ -104,6 +167,12 @@ struct graph_opts
   std::string dataset;
   int num_threads = 1;
   std::string checkpoint_name;
+  AdjListLayout adjlist_layout = AdjListLayout::Blob;
+  degree_t adjlist_chunk_size = 1024;  // only used with the Chunked layout
+  bool sorted_adjlist = false;  // keep AdjList adjacency lists sorted by ID
+  AdjListCodec adjlist_codec = AdjListCodec::Raw;
+  PartitionMode partition_mode = PartitionMode::IdRange;
+  bool degree_table = false;  // keep a dense degree table (split_ekey only)
   ~graph_opts() = default;
   // dump the options
   void print_config(const std::string &filename)
@@ -123,6 +192,12 @@ struct graph_opts
     out << "DATASET: " << dataset << std::endl;
     out << "NUM_NODES" << num_nodes << std::endl;
     out << "NUM_EDGES" << num_edges << std::endl;
+    out << "ADJLIST_LAYOUT: " << adjlist_layout << std::endl;
+    out << "ADJLIST_CHUNK_SIZE: " << adjlist_chunk_size << std::endl;
+    out << "SORTED_ADJLIST: " << sorted_adjlist << std::endl;
+    out << "ADJLIST_CODEC: " << adjlist_codec << std::endl;
+    out << "PARTITION_MODE: " << partition_mode << std::endl;
+    out << "DEGREE_TABLE: " << degree_table << std::endl;
     out.close();
   }
 };
@@ -177,6 +252,8 @@ typedef struct adjlist
   node_id_t node_id{};
   degree_t degree{};
   std::vector<node_id_t> edgelist;
+  // weights[i] belongs to edgelist[i]; only filled by weighted adjlists
+  std::vector<edgeweight_t> weights;
   // This could be dynamic, but this is a good starting point.
   adjlist() { edgelist.reserve(1000); }
   adjlist(node_id_t id, degree_t deg) : node_id(id), degree(deg)
@@ -186,8 +263,59 @@ typedef struct adjlist
   void clear()
   {
     edgelist.clear();
+    weights.clear();
     node_id = 0;
     degree = 0;
   }
 } adjlist;
+
+/**
+ * @brief Read-only adjlist returned by OutCursor/InCursor::next_view(). The
+ * edgelist may point into memory owned by WiredTiger and is only valid until
+ * the cursor is advanced, reset or closed.
+ */
+typedef struct adjlist_view
+{
+  node_id_t node_id{};
+  degree_t degree{};
+  std::span<const node_id_t> edgelist;
+  std::span<const edgeweight_t> weights;  // empty unless the list has weights
+} adjlist_view;
+
+/**
+ * @brief A run of adjacency lists in CSR form, filled by
+ * OutCursor::next_batch(). The neighbours of node_ids[i] are
+ * edges[offsets[i]] up to edges[offsets[i + 1]]. If the cursor has weights,
+ * weights runs parallel to edges; otherwise it stays empty.
+ */
+typedef struct adjlist_batch
+{
+  std::vector<node_id_t> node_ids;
+  std::vector<edge_id_t> offsets{0};
+  std::vector<node_id_t> edges;
+  std::vector<edgeweight_t> weights;
+
+  [[nodiscard]] size_t size() const { return node_ids.size(); }
+  [[nodiscard]] std::span<const node_id_t> neighbors(size_t i) const
+  {
+    return {edges.data() + offsets[i], edges.data() + offsets[i + 1]};
+  }
+  [[nodiscard]] std::span<const edgeweight_t> neighbor_weights(size_t i) const
+  {
+    return {weights.data() + offsets[i], weights.data() + offsets[i + 1]};
+  }
+  void clear()
+  {
+    node_ids.clear();
+    offsets.assign(1, 0);
+    edges.clear();
+    weights.clear();
+  }
+  // Closes a list whose neighbours were appended to edges
+  void end_list(node_id_t node_id)
+  {
+    node_ids.push_back(node_id);
+    offsets.push_back(edges.size());
+  }
+} adjlist_batch;
 #endif
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "adjlist_codec.h"
 #include "common_defs.h"
 #include "graph_exception.h"
 #include "iterator.h"
@@ -100,8 +101,14 @@ class CommonUtil
   static void read_from_edge_idx(WT_CURSOR *idx_cursor, edge *e_idx);
   static int adjlist_to_record(WT_SESSION *session,
                                WT_CURSOR *cursor,
-                               const adjlist &to_insert);
-  static void record_to_adjlist(WT_CURSOR *cursor, adjlist *found);
+                               const adjlist &to_insert,
+                               AdjListCodec codec = AdjListCodec::Raw);
+  static void record_to_adjlist(WT_CURSOR *cursor,
+                                adjlist *found,
+                                AdjListCodec codec = AdjListCodec::Raw);
+  static int record_to_adjlist_chunks(WT_CURSOR *cursor,
+                                      adjlist *found,
+                                      AdjListCodec codec = AdjListCodec::Raw);
 
   static void ekey_set_key(WT_CURSOR *cursor, node_id_t key1, node_id_t key2);
   static int ekey_get_key(WT_CURSOR *cursor, node_id_t *key1, node_id_t *key2);
@@ -294,19 +301,20 @@ inline void CommonUtil::get_val_idx(WT_CURSOR *idx_cursor,
  * @param cursor A cursor to the in/out adjlist table
  * @param to_insert The adjlist struct to be inserted into the table pointed
  * to by the cursor.
+ * @param codec The encoding used for the edgelist
  * @throws GraphException If insertion into the table fails
  */
 inline int CommonUtil::adjlist_to_record(WT_SESSION *session,
                                          WT_CURSOR *cursor,
-                                         const adjlist &to_insert)
+                                         const adjlist &to_insert,
+                                         AdjListCodec codec)
 {
   cursor->reset(cursor);
   CommonUtil::set_key(cursor, to_insert.node_id);
   int ret = cursor->search(cursor);
 
-  WT_ITEM item;
-  item.data = to_insert.edgelist.data();
-  item.size = to_insert.edgelist.size() * sizeof(node_id_t);
+  std::vector<uint8_t> buf;
+  WT_ITEM item = AdjCodec::encode(codec, to_insert, buf);
 
   cursor->set_value(cursor, to_insert.degree, &item);
 
@@ -325,16 +333,20 @@ inline int CommonUtil::adjlist_to_record(WT_SESSION *session,
  * a adjlist struct
  *
  * @param cursor the cursor set to the record which needs to be read
+ * @param codec The encoding used for the edgelist
  * @return adjlist the found adjlist struct.
  */
-inline void CommonUtil::record_to_adjlist(WT_CURSOR *cursor, adjlist *found)
+inline void CommonUtil::record_to_adjlist(WT_CURSOR *cursor,
+                                          adjlist *found,
+                                          AdjListCodec codec)
 {
   int32_t degree;
   WT_ITEM item;
   cursor->get_value(cursor, &degree, &item);
-  found->edgelist.assign(
-      (node_id_t *)item.data,
-      (node_id_t *)item.data + item.size / sizeof(node_id_t));
+  found->edgelist.clear();
+  found->weights.clear();
+  AdjCodec::decode(codec, item, found->edgelist);
+  AdjCodec::decode_weights(codec, item, found->weights);
   if (degree == 1 && found->edgelist.empty())
   {
     found->degree = 0;
@@ -344,6 +356,42 @@ inline void CommonUtil::record_to_adjlist(WT_CURSOR *cursor, adjlist *found)
     found->degree = degree;
   }
 }
+/**
+ * @brief This function reads an adjacency list stored in the Chunked layout.
+ * The cursor must be positioned on the first chunk (chunk_no 0) of the node.
+ * All chunks of that node are appended to found->edgelist and the cursor is
+ * left on the first chunk of the next node.
+ *
+ * @param cursor the cursor set to chunk 0 of the adjlist to be read
+ * @param found the adjlist struct to populate
+ * @param codec The encoding used for each chunk
+ * @return 0 if the cursor is positioned on the next node, the return value
+ * of WT_CURSOR::next otherwise (WT_NOTFOUND at the end of the table).
+ */
+inline int CommonUtil::record_to_adjlist_chunks(WT_CURSOR *cursor,
+                                                adjlist *found,
+                                                AdjListCodec codec)
+{
+  node_id_t node_id, curr_id, chunk_no;
+  CommonUtil::get_key(cursor, &node_id, &chunk_no);
+  found->edgelist.clear();
+  int ret;
+  do
+  {
+    degree_t count;
+    WT_ITEM item;
+    cursor->get_value(cursor, &count, &item);
+    AdjCodec::decode(codec, item, found->edgelist);
+    if ((ret = cursor->next(cursor)) != 0)
+    {
+      break;
+    }
+    CommonUtil::get_key(cursor, &curr_id, &chunk_no);
+  } while (curr_id == node_id);
+  found->degree = found->edgelist.size();
+  return ret;
+}
+
 // Get and Set data from/to an edge table cursor
 /**
  * @brief This function converts the record the cursor points to into a node
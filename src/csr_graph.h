@@ -0,0 +1,296 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "common_defs.h"
+#include "graph_exception.h"
+#include "iterator.h"
+
+/**
+ * @brief Which adjacency a CSRGraph holds: the out-neighbours or the
+ * in-neighbours of every node.
+ */
+typedef enum CSRDirection
+{
+  OutEdges,
+  InEdges
+} CSRDirection;
+
+/**
+ * @brief Immutable compressed sparse row snapshot of one direction of a graph.
+ *
+ * Node IDs index the offsets array directly, so the ID space is
+ * [0, num_nodes) and IDs without a record have degree 0. The neighbours of n
+ * are nbrs[offsets[n], offsets[n + 1]) and, if the snapshot is weighted,
+ * weights holds the matching edge weights. Offsets are 64 bit since the edge
+ * count can pass 4B.
+ *
+ * The arrays are either allocated here, 64 byte aligned, or point into memory
+ * owned by someone else (see the storage handle), so a snapshot can be served
+ * straight from a mapped file. Built by GraphEngine::materialize_csr().
+ */
+class CSRGraph
+{
+ public:
+  static constexpr size_t ALIGNMENT = 64;
+
+  // Allocates uninitialised arrays for num_edges edges
+  CSRGraph(CSRDirection _direction,
+           node_id_t _num_nodes,
+           uint64_t _num_edges,
+           bool _weighted)
+      : direction(_direction),
+        num_nodes(_num_nodes),
+        num_edges(_num_edges)
+  {
+    auto *owned = new aligned_storage();
+    storage = std::shared_ptr<void>(
+        owned, [](void *p) { delete static_cast<aligned_storage *>(p); });
+    offsets = owned->alloc<uint64_t>(num_nodes + 1);
+    nbrs = owned->alloc<node_id_t>(num_edges);
+    if (_weighted) weights = owned->alloc<edgeweight_t>(num_edges);
+  }
+
+  // Wraps arrays kept alive by _storage
+  CSRGraph(CSRDirection _direction,
+           node_id_t _num_nodes,
+           uint64_t _num_edges,
+           uint64_t *_offsets,
+           node_id_t *_nbrs,
+           edgeweight_t *_weights,
+           degree_t *_opposite_degrees,
+           bool _sorted,
+           std::shared_ptr<void> _storage)
+      : direction(_direction),
+        num_nodes(_num_nodes),
+        num_edges(_num_edges),
+        offsets(_offsets),
+        nbrs(_nbrs),
+        weights(_weights),
+        opposite_degrees(_opposite_degrees),
+        storage(std::move(_storage)),
+        sorted(_sorted)
+  {
+  }
+
+  [[nodiscard]] CSRDirection get_direction() const { return direction; }
+  [[nodiscard]] node_id_t get_num_nodes() const { return num_nodes; }
+  [[nodiscard]] uint64_t get_num_edges() const { return num_edges; }
+  [[nodiscard]] bool is_weighted() const { return weights != nullptr; }
+  // True if every row is in ascending ID order
+  [[nodiscard]] bool is_sorted() const { return sorted; }
+
+  [[nodiscard]] degree_t get_degree(node_id_t node_id) const
+  {
+    if (node_id >= num_nodes) return 0;
+    return offsets[node_id + 1] - offsets[node_id];
+  }
+
+  [[nodiscard]] std::span<const node_id_t> get_neighbors(
+      node_id_t node_id) const
+  {
+    if (node_id >= num_nodes) return {};
+    return {nbrs + offsets[node_id], nbrs + offsets[node_id + 1]};
+  }
+
+  /**
+   * @brief The degree of node_id in the other direction (the out-degree for
+   * an InEdges snapshot), if the snapshot carries it. PageRank needs both.
+   */
+  [[nodiscard]] bool has_opposite_degrees() const
+  {
+    return opposite_degrees != nullptr;
+  }
+  [[nodiscard]] degree_t get_opposite_degree(node_id_t node_id) const
+  {
+    if (opposite_degrees == nullptr || node_id >= num_nodes) return 0;
+    return opposite_degrees[node_id];
+  }
+
+  [[nodiscard]] std::span<const edgeweight_t> get_weights(
+      node_id_t node_id) const
+  {
+    if (weights == nullptr || node_id >= num_nodes) return {};
+    return {weights + offsets[node_id], weights + offsets[node_id + 1]};
+  }
+
+  [[nodiscard]] const uint64_t *get_offsets() const { return offsets; }
+  [[nodiscard]] const node_id_t *get_nbrs() const { return nbrs; }
+  [[nodiscard]] const edgeweight_t *get_edge_weights() const
+  {
+    return weights;
+  }
+
+  // Bytes held by the offsets, neighbour and weight arrays
+  [[nodiscard]] size_t memory_bytes() const
+  {
+    size_t bytes = (num_nodes + 1) * sizeof(uint64_t);
+    bytes += num_edges * sizeof(node_id_t);
+    if (weights != nullptr) bytes += num_edges * sizeof(edgeweight_t);
+    if (opposite_degrees != nullptr) bytes += num_nodes * sizeof(degree_t);
+    return bytes;
+  }
+
+  [[nodiscard]] long double get_build_secs() const { return build_secs; }
+  void set_build_secs(long double secs) { build_secs = secs; }
+
+  OutCursor *get_outnbd_iter() const;
+  InCursor *get_innbd_iter() const;
+
+ private:
+  friend class GraphEngine;
+
+  // Owns the 64 byte aligned arrays of a snapshot built in memory
+  struct aligned_storage
+  {
+    std::vector<void *> blocks;
+    template <typename T>
+    T *alloc(size_t count)
+    {
+      void *p = ::operator new(std::max<size_t>(count, 1) * sizeof(T),
+                               std::align_val_t(ALIGNMENT));
+      blocks.push_back(p);
+      return static_cast<T *>(p);
+    }
+    ~aligned_storage()
+    {
+      for (void *p : blocks) ::operator delete(p, std::align_val_t(ALIGNMENT));
+    }
+  };
+
+  CSRDirection direction;
+  node_id_t num_nodes;
+  uint64_t num_edges;
+  uint64_t *offsets = nullptr;
+  node_id_t *nbrs = nullptr;
+  edgeweight_t *weights = nullptr;
+  degree_t *opposite_degrees = nullptr;
+  std::shared_ptr<void> storage;
+  bool sorted = false;
+  long double build_secs = 0;
+};
+
+/**
+ * @brief Walks the rows of a CSRGraph in ID order with the same semantics as
+ * the AdjList cursors: nodes with an empty list are skipped and the end of
+ * iteration returns node_id = OutOfBand_ID_MAX. next_view() points into the
+ * snapshot, so the view stays valid as long as the CSRGraph does. The rows of
+ * a weighted snapshot come with their weights, and OutCursor::next_batch()
+ * copies them through next_view().
+ */
+template <typename Base>
+class CSRCursor : public Base
+{
+ public:
+  explicit CSRCursor(const CSRGraph *_csr) : csr(_csr)
+  {
+    this->sorted = csr->is_sorted();
+    if constexpr (std::is_same_v<Base, OutCursor>)
+    {
+      this->set_weighted(csr->is_weighted());
+    }
+    set_key_range({0, OutOfBand_ID_MAX});
+  }
+
+  void set_key_range(key_range _keys) override
+  {
+    this->keys = _keys;
+    pos = this->keys.start == OutOfBand_ID_MAX ? 0 : this->keys.start;
+    end = this->keys.end >= csr->get_num_nodes() ? csr->get_num_nodes()
+                                                   : this->keys.end + 1;
+    this->is_first = false;
+    this->has_next = pos < end;
+  }
+
+  void reset() override
+  {
+    pos = this->keys.start == OutOfBand_ID_MAX ? 0 : this->keys.start;
+    this->is_first = true;
+    this->has_next = pos < end;
+  }
+
+  void next_view(adjlist_view *found) override
+  {
+    while (pos < end && csr->get_degree(pos) == 0) pos++;
+    if (pos >= end)
+    {
+      this->has_next = false;
+      found->node_id = OutOfBand_ID_MAX;
+      found->degree = OutOfBand_ID_MAX;
+      found->edgelist = {};
+      found->weights = {};
+      return;
+    }
+    found->node_id = pos;
+    found->edgelist = csr->get_neighbors(pos);
+    found->weights = csr->get_weights(pos);
+    found->degree = found->edgelist.size();
+    pos++;
+  }
+
+  void next(adjlist *found) override
+  {
+    adjlist_view view;
+    next_view(&view);
+    copy_view(view, found);
+  }
+
+  void next(adjlist *found, node_id_t key) override
+  {
+    adjlist_view view;
+    if (key < pos || key >= end)
+    {
+      view.node_id = OutOfBand_ID_MAX;
+      view.degree = OutOfBand_ID_MAX;
+    }
+    else
+    {
+      view.node_id = key;
+      view.edgelist = csr->get_neighbors(key);
+      view.weights = csr->get_weights(key);
+      view.degree = view.edgelist.size();
+      pos = key + 1;
+    }
+    copy_view(view, found);
+  }
+
+ private:
+  const CSRGraph *csr;
+  node_id_t pos = 0;
+  node_id_t end = 0;
+
+  static void copy_view(const adjlist_view &view, adjlist *found)
+  {
+    found->node_id = view.node_id;
+    found->degree = view.degree;
+    found->edgelist.assign(view.edgelist.begin(), view.edgelist.end());
+    found->weights.assign(view.weights.begin(), view.weights.end());
+  }
+};
+
+inline OutCursor *CSRGraph::get_outnbd_iter() const
+{
+  if (direction != CSRDirection::OutEdges)
+  {
+    throw GraphException("CSR snapshot does not hold the out edges");
+  }
+  return new CSRCursor<OutCursor>(this);
+}
+
+inline InCursor *CSRGraph::get_innbd_iter() const
+{
+  if (direction != CSRDirection::InEdges)
+  {
+    throw GraphException("CSR snapshot does not hold the in edges");
+  }
+  return new CSRCursor<InCursor>(this);
+}
+
+#endif  // CSR_GRAPH_H
@@ -4,6 +4,7 @@
 #include "common_util.h"
 #include "graph.h"
 #include "graph_exception.h"
+#include "key_decode.h"
 
 using namespace std;
 
@@ -118,7 +119,7 @@ class EkeyOutCursor : public OutCursor
 {
  private:
   // bool is_weighted = false;
-  node_id_t curr_node{};
+  EKeyScanBuffer scan;  // keys are read ahead and decoded in batches
 
  public:
   EkeyOutCursor(WT_CURSOR *cur, WT_SESSION *sess)
@@ -128,6 +129,14 @@ class EkeyOutCursor : public OutCursor
     set_key_range({OutOfBand_ID_MIN, OutOfBand_ID_MAX});
   }
   ~EkeyOutCursor() override = default;
+  // Starts over at the beginning of the key range; whatever was read ahead
+  // is dropped
+  void reset() override
+  {
+    OutCursor::reset();
+    set_key_range(keys);
+  }
+
   void set_key_range(key_range _keys) override
   {
     keys.start = _keys.start;
@@ -144,6 +153,8 @@ class EkeyOutCursor : public OutCursor
     // Advance the cursor to the first record >= start
 
     int status;
+    scan.clear();
+    has_next = true;
     cursor->search_near(cursor, &status);
     if (status < 0)
     {
@@ -154,52 +165,68 @@ class EkeyOutCursor : public OutCursor
         return;
       }
     }
-    node_id_t temp_dst;
-    CommonUtil::ekey_get_key(cursor, &curr_node, &temp_dst);
   }
 
   void next(adjlist *found) override
   {
-    node_id_t src, dst;
+    found->edgelist.clear();
+    found->node_id = read_list(found->edgelist);
+    found->degree = found->node_id == OutOfBand_ID_MAX
+                        ? UINT32_MAX  // always u32
+                        : found->edgelist.size();
+  }
 
-    if (!has_next)
+  // Appends straight to the flat neighbour array of the batch
+  size_t next_batch(adjlist_batch &batch,
+                    size_t max_nodes,
+                    size_t max_edges) override
+  {
+    batch.clear();
+    while (batch.size() < max_nodes && batch.edges.size() < max_edges)
     {
-      found->node_id = OutOfBand_ID_MAX;
-      found->degree = UINT32_MAX;  // always u32
-      found->edgelist.clear();
-      return;
+      node_id_t node_id = read_list(batch.edges);
+      if (node_id == OutOfBand_ID_MAX) break;
+      batch.end_list(node_id);
     }
+    return batch.size();
+  }
 
-    // get edge
-    CommonUtil::ekey_get_key(cursor, &src, &dst);
-    if (dst == OutOfBand_ID_MIN) curr_node = src;
-    while (cursor->next(cursor) == 0)
+  void next(adjlist *found, node_id_t key) override {}
+
+ private:
+  /**
+   * @brief Appends the out list of the next node in range that has edges to
+   * out, skipping nodes without any, and leaves the scan on the first record
+   * of the node after it.
+   * @return the node's ID, or OutOfBand_ID_MAX past the end of the range
+   */
+  node_id_t read_list(std::vector<node_id_t> &out)
+  {
+    node_id_t src, dst;
+    if (!has_next || !scan.current(cursor, &src, &dst))
     {
-      CommonUtil::ekey_get_key(cursor, &src, &dst);
-      found->node_id = curr_node;
-      if (src == curr_node && dst != OutOfBand_ID_MIN)
-      {
-        found->edgelist.push_back(dst);
-        found->degree++;
-      }
-      else
+      has_next = false;
+      return OutOfBand_ID_MAX;
+    }
+    // The scan is on the first record of a node: its node record (dst is
+    // OutOfBand_ID_MIN) or, if it has none, its first edge
+    while (src <= keys.end)
+    {
+      node_id_t node_id = src;
+      size_t start = out.size();
+      if (dst != OutOfBand_ID_MIN) out.push_back(dst);
+      bool more;
+      while ((more = scan.advance(cursor, &src, &dst)) && src == node_id)
       {
-        curr_node = src;
-        if (found->degree == 0) continue;  // don't return empty nodes
-        if (curr_node > keys.end)
-        {
-          has_next = false;
-          return;
-        }
-        return;
+        out.push_back(dst);
       }
+      if (!more) has_next = false;
+      if (out.size() > start) return node_id;
+      if (!more) return OutOfBand_ID_MAX;
     }
-    // found->node_id = src;
-    found->node_id = OutOfBand_ID_MAX;
     has_next = false;
+    return OutOfBand_ID_MAX;
   }
-
-  void next(adjlist *found, node_id_t key) override {}
 };
 /**
  * @brief This class is used to iterate over the nodes of a graph.
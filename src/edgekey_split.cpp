@@ -14,6 +14,12 @@ SplitEdgeKey::SplitEdgeKey(graph_opts &opt_params, WT_CONNECTION *conn)
     : GraphBase(opt_params, conn)
 
 {
+  // The table mirrors the degrees kept in the node records
+  if (opts.degree_table && !opts.read_optimize)
+  {
+    throw GraphException("The degree table needs a read optimized graph");
+  }
+  batched_edge_writes = true;
   init_cursors();
 }
 
@@ -56,10 +62,27 @@ void SplitEdgeKey::create_wt_tables(graph_opts &opts, WT_CONNECTION *conn)
   {
     create_indices(sess);
   }
+  if (opts.degree_table)
+  {
+    create_degree_table(sess);
+  }
 
   sess->close(sess, nullptr);
 }
 
+/**
+ * @brief Creates the optional degree table: one fixed width (in, out) record
+ * per node in a column store keyed by MAKE_EKEY(node_id), as record numbers
+ * start at 1. The node records in edge_out are interleaved with the edges;
+ * this table packs the degrees together so that get_degrees() reads them in
+ * one short sequential pass.
+ */
+void SplitEdgeKey::create_degree_table(WT_SESSION *session)
+{
+  vector<string> degree_columns = {ID, IN_DEGREE, OUT_DEGREE};
+  CommonUtil::set_table(session, DEGREE_TABLE, degree_columns, "r", "II");
+}
+
 void SplitEdgeKey::init_cursors()
 {
   // metadata_cursor initialization
@@ -121,6 +144,18 @@ void SplitEdgeKey::init_cursors()
     throw GraphException("Could not get a cursor to the dst_src index" +
                          string(wiredtiger_strerror(ret)));
   }
+
+  if (opts.degree_table &&
+      (ret = _get_table_cursor(DEGREE_TABLE,
+                               &degree_cursor,
+                               session,
+                               false,
+                               false,
+                               opts.checkpoint_name)))
+  {
+    throw GraphException("Could not get a cursor to the degree table: " +
+                         string(wiredtiger_strerror(ret)));
+  }
 }
 
 /**
@@ -164,8 +199,15 @@ int SplitEdgeKey::add_node(node to_insert, bool is_bulk)
     }
     return out_ret;
   }
+  if (degree_cursor != nullptr &&
+      (out_ret = set_degree_record(
+           to_insert.id, to_insert.in_degree, to_insert.out_degree)))
+  {
+    return out_ret;
+  }
   session->commit_transaction(session, nullptr);
   GraphBase::increment_nodes(1);
+  note_node_id(to_insert.id);
   return 0;
 }
 
@@ -209,7 +251,13 @@ int SplitEdgeKey::add_node_txn(node to_insert,
     }
     int ret =
         error_check_insert_txn(out_edge_cursor->insert(out_edge_cursor), false);
-    if (!ret) num_nodes_added++;
+    if (!ret && degree_cursor != nullptr)
+    {
+      ret = set_degree_record(to_insert.id,
+                              std::max(indeg_change, 0),
+                              std::max(outdeg_change, 0));
+    }
+    if (!ret) (*num_nodes_added)++;
     return ret;
   }
 
@@ -309,8 +357,100 @@ int SplitEdgeKey::add_edge(edge to_insert, bool is_bulk)
   session->commit_transaction(session, nullptr);
   GraphBase::increment_nodes(num_nodes_to_add);
   GraphBase::increment_edges(num_edges_to_add);
+  note_node_id(to_insert.src_id);
+  note_node_id(to_insert.dst_id);
+  return 0;
+}
+/**
+ * Inserts a batch of edges sorted by (src, dst) in one transaction. The degree
+ * changes are summed per endpoint first, so every node record is read and
+ * written once, and the in-edge keys are written in (dst, src) order. Called
+ * through GraphBase::add_edges().
+ * @param batch
+ * @return 0 if the batch was committed, otherwise the error that rolled it
+ * back (WT_DUPLICATE_KEY if an edge already exists)
+ */
+int SplitEdgeKey::add_edge_batch(std::span<const edge> batch)
+{
+  struct degree_change
+  {
+    node_id_t id;
+    int32_t in;
+    int32_t out;
+  };
+  std::vector<degree_change> changes;
+  changes.reserve(batch.size() * 2);
+  for (const edge &e : batch)
+  {
+    opts.is_directed ? changes.push_back({e.src_id, 0, 1})
+                     : changes.push_back({e.src_id, 1, 1});
+    opts.is_directed ? changes.push_back({e.dst_id, 1, 0})
+                     : changes.push_back({e.dst_id, 1, 1});
+  }
+  std::sort(changes.begin(),
+            changes.end(),
+            [](const degree_change &a, const degree_change &b)
+            { return a.id < b.id; });
+
+  int num_nodes_to_add = 0;
+  int ret;
+  session->begin_transaction(session, "isolation=snapshot");
+  for (size_t i = 0; i < changes.size();)
+  {
+    degree_change sum = {changes[i].id, 0, 0};
+    for (; i < changes.size() && changes[i].id == sum.id; i++)
+    {
+      sum.in += changes[i].in;
+      sum.out += changes[i].out;
+    }
+    node to_add{.id = sum.id};
+    if ((ret = add_node_txn(to_add, &num_nodes_to_add, sum.in, sum.out)))
+    {
+      return ret;  // rolled back
+    }
+  }
+
+  for (const edge &e : batch)
+  {
+    CommonUtil::ekey_set_key(out_edge_cursor, e.src_id, e.dst_id);
+    out_edge_cursor->set_value(out_edge_cursor,
+                               opts.is_weighted ? e.edge_weight : 0,
+                               OutOfBand_ID_MAX);
+    if ((ret = error_check_insert_txn(out_edge_cursor->insert(out_edge_cursor),
+                                      false)))
+    {
+      return ret;
+    }
+  }
+
+  std::vector<edge> reversed(batch.begin(), batch.end());
+  std::sort(reversed.begin(),
+            reversed.end(),
+            [](const edge &a, const edge &b)
+            {
+              return a.dst_id < b.dst_id ||
+                     (a.dst_id == b.dst_id && a.src_id < b.src_id);
+            });
+  for (const edge &e : reversed)
+  {
+    CommonUtil::ekey_set_key(in_edge_cursor, e.dst_id, e.src_id);
+    in_edge_cursor->set_value(in_edge_cursor,
+                              opts.is_weighted ? e.edge_weight : 0,
+                              OutOfBand_ID_MAX);
+    if ((ret = error_check_insert_txn(in_edge_cursor->insert(in_edge_cursor),
+                                      false)))
+    {
+      return ret;
+    }
+  }
+  session->commit_transaction(session, nullptr);
+  GraphBase::increment_nodes(num_nodes_to_add);
+  GraphBase::increment_edges((int)batch.size());
+  note_node_id(changes.front().id);
+  note_node_id(changes.back().id);
   return 0;
 }
+
 /**
  * Check if the edge between src_id and dst_id exists in the graph.
  * @param src_id
@@ -445,9 +585,31 @@ node SplitEdgeKey::get_random_node()
   }
   return rando;
 }
+// Reads the degree table record of node_id; throws if the node does not exist
+void SplitEdgeKey::get_degree_record(node_id_t node_id,
+                                     degree_t *in,
+                                     degree_t *out)
+{
+  degree_cursor->set_key(degree_cursor, (uint64_t)MAKE_EKEY(node_id));
+  if (degree_cursor->search(degree_cursor) != 0)
+  {
+    degree_cursor->reset(degree_cursor);
+    throw GraphException("Node with ID " + std::to_string(node_id) +
+                         " does not exist");
+  }
+  degree_cursor->get_value(degree_cursor, in, out);
+  degree_cursor->reset(degree_cursor);
+}
+
 degree_t SplitEdgeKey::get_in_degree(node_id_t node_id)
 {
   degree_t in_deg = 0;
+  if (degree_cursor != nullptr)
+  {
+    degree_t out_deg;
+    get_degree_record(node_id, &in_deg, &out_deg);
+    return in_deg;
+  }
   if (opts.read_optimize)
   {
     CommonUtil::ekey_set_key(out_edge_cursor, node_id, OutOfBand_ID_MIN);
@@ -503,6 +665,12 @@ degree_t SplitEdgeKey::get_in_degree(node_id_t node_id)
 degree_t SplitEdgeKey::get_out_degree(node_id_t node_id)
 {
   degree_t out_deg = 0;
+  if (degree_cursor != nullptr)
+  {
+    degree_t in_deg;
+    get_degree_record(node_id, &in_deg, &out_deg);
+    return out_deg;
+  }
   CommonUtil::ekey_set_key(out_edge_cursor, node_id, OutOfBand_ID_MIN);
   int ret = out_edge_cursor->search(out_edge_cursor);
   if (ret == 0)  // The node exists
@@ -807,6 +975,123 @@ std::vector<node_id_t> SplitEdgeKey::get_in_nodes_id(node_id_t node_id)
   in_cur->close(in_cur);
   return in_nodes_id;
 }
+void SplitEdgeKey::visit_out_neighbors(node_id_t node_id,
+                                       nbr_visitor visit,
+                                       void *ctx)
+{
+  visit_edge_table(out_edge_cursor, node_id, visit, ctx);
+}
+
+void SplitEdgeKey::visit_in_neighbors(node_id_t node_id,
+                                      nbr_visitor visit,
+                                      void *ctx)
+{
+  // in_edge_cursor is on the OUT_EDGES table for undirected graphs
+  visit_edge_table(in_edge_cursor, node_id, visit, ctx);
+}
+
+/**
+ * @brief Walks the (node_id, nbr) records of an edge table with the handle's
+ * own cursor and calls visit for each nbr. Stops early if visit returns false.
+ */
+void SplitEdgeKey::visit_edge_table(WT_CURSOR *cursor,
+                                    node_id_t node_id,
+                                    nbr_visitor visit,
+                                    void *ctx)
+{
+  int status;
+  CommonUtil::ekey_set_key(cursor, node_id, OutOfBand_ID_MIN);
+  int ret = cursor->search_near(cursor, &status);
+  if (ret == 0 && status <= 0)
+  {
+    ret = cursor->next(cursor);  // step past the node record
+  }
+  while (ret == 0)
+  {
+    node_id_t first, nbr;
+    CommonUtil::ekey_get_key(cursor, &first, &nbr);
+    if (first != node_id || !visit(ctx, nbr))
+    {
+      break;
+    }
+    ret = cursor->next(cursor);
+  }
+  cursor->reset(cursor);
+}
+
+/**
+ * @brief Same walk as visit_edge_table, also reading the weight stored in
+ * every edge record.
+ */
+void SplitEdgeKey::visit_out_edges(node_id_t node_id,
+                                   edge_visitor visit,
+                                   void *ctx)
+{
+  int status;
+  CommonUtil::ekey_set_key(out_edge_cursor, node_id, OutOfBand_ID_MIN);
+  int ret = out_edge_cursor->search_near(out_edge_cursor, &status);
+  if (ret == 0 && status <= 0)
+  {
+    ret = out_edge_cursor->next(out_edge_cursor);  // step past the node record
+  }
+  while (ret == 0)
+  {
+    node_id_t src, dst;
+    edgeweight_t weight;
+    int unused;
+    CommonUtil::ekey_get_key(out_edge_cursor, &src, &dst);
+    if (src != node_id) break;
+    out_edge_cursor->get_value(out_edge_cursor, &weight, &unused);
+    if (!visit(ctx, dst, weight)) break;
+    ret = out_edge_cursor->next(out_edge_cursor);
+  }
+  out_edge_cursor->reset(out_edge_cursor);
+}
+
+/**
+ * @brief Walks the out edge table once for the sorted node_ids. Reading a
+ * list leaves the cursor on the next node's record, so a run of consecutive
+ * IDs needs a single search_near.
+ */
+void SplitEdgeKey::visit_out_lists(std::span<const node_id_t> node_ids,
+                                   list_visitor visit,
+                                   void *ctx)
+{
+  WT_CURSOR *cursor = out_edge_cursor;
+  node_id_t src = OutOfBand_ID_MAX, dst;  // the record the cursor is on
+  int ret = 0;
+  for (node_id_t node_id : node_ids)
+  {
+    if (src != node_id)
+    {
+      int status;
+      CommonUtil::ekey_set_key(cursor, node_id, OutOfBand_ID_MIN);
+      ret = cursor->search_near(cursor, &status);
+      if (ret == 0 && status < 0)
+      {
+        ret = cursor->next(cursor);
+      }
+      if (ret == 0)
+      {
+        CommonUtil::ekey_get_key(cursor, &src, &dst);
+      }
+    }
+
+    visit_buf.clear();
+    while (ret == 0 && src == node_id)
+    {
+      if (dst != OutOfBand_ID_MIN) visit_buf.push_back(dst);
+      if ((ret = cursor->next(cursor)) == 0)
+      {
+        CommonUtil::ekey_get_key(cursor, &src, &dst);
+      }
+    }
+    if (ret != 0) src = OutOfBand_ID_MAX;
+    if (!visit(ctx, node_id, visit_buf)) break;
+  }
+  cursor->reset(cursor);
+}
+
 /**
  * @brief This function accepts a node_id and two integers, in_change and
  * out_change and updates the in and out degree of the node in the in_Edge and
@@ -841,9 +1126,76 @@ int SplitEdgeKey::update_node_degree(node_id_t node_id,
             wiredtiger_strerror(ret));
   }
   out_cursor->close(out_cursor);
+  if ((ret = error_check_insert_txn(ret, false)) || degree_cursor == nullptr)
+  {
+    return ret;
+  }
+  return set_degree_record(node_id, in + in_change, out + out_change);
+}
+
+/**
+ * @brief Writes the degree table record of node_id. Must be called within a
+ * running transaction; rolls it back on failure.
+ */
+int SplitEdgeKey::set_degree_record(node_id_t node_id,
+                                    degree_t in,
+                                    degree_t out)
+{
+  degree_cursor->set_key(degree_cursor, (uint64_t)MAKE_EKEY(node_id));
+  degree_cursor->set_value(degree_cursor, in, out);
+  int ret = degree_cursor->insert(degree_cursor);
+  degree_cursor->reset(degree_cursor);
   return error_check_insert_txn(ret, false);
 }
 
+int SplitEdgeKey::remove_degree_record(node_id_t node_id)
+{
+  degree_cursor->set_key(degree_cursor, (uint64_t)MAKE_EKEY(node_id));
+  int ret = degree_cursor->remove(degree_cursor);
+  degree_cursor->reset(degree_cursor);
+  if (ret != 0) session->rollback_transaction(session, nullptr);
+  return ret;
+}
+
+/**
+ * @brief With a degree table, one forward pass over its records in keys;
+ * otherwise the adjacency walk of GraphBase::get_degrees().
+ */
+void SplitEdgeKey::get_degrees(key_range keys,
+                               std::span<degree_t> out_degrees,
+                               std::span<degree_t> in_degrees)
+{
+  if (degree_cursor == nullptr)
+  {
+    GraphBase::get_degrees(keys, out_degrees, in_degrees);
+    return;
+  }
+  std::fill(out_degrees.begin(), out_degrees.end(), 0);
+  std::fill(in_degrees.begin(), in_degrees.end(), 0);
+  size_t count = std::max(out_degrees.size(), in_degrees.size());
+  if (count == 0) return;
+  node_id_t last = std::min<node_id_t>(keys.end, keys.start + (count - 1));
+
+  degree_cursor->set_key(degree_cursor, (uint64_t)MAKE_EKEY(keys.start));
+  int exact;
+  int ret = degree_cursor->search_near(degree_cursor, &exact);
+  if (ret == 0 && exact < 0) ret = degree_cursor->next(degree_cursor);
+  while (ret == 0)
+  {
+    uint64_t recno;
+    degree_t in, out;
+    degree_cursor->get_key(degree_cursor, &recno);
+    node_id_t node_id = OG_KEY(recno);
+    if (node_id > last) break;
+    degree_cursor->get_value(degree_cursor, &in, &out);
+    size_t i = node_id - keys.start;
+    if (i < out_degrees.size()) out_degrees[i] = out;
+    if (i < in_degrees.size()) in_degrees[i] = in;
+    ret = degree_cursor->next(degree_cursor);
+  }
+  degree_cursor->reset(degree_cursor);
+}
+
 OutCursor *SplitEdgeKey::get_outnbd_iter()
 {
   OutCursor *toReturn = new SplitEKeyOutCursor(get_new_out_cursor(), session);
@@ -985,39 +1337,51 @@ int SplitEdgeKey::error_check_read_txn(int return_val)
   }
 }
 
+/**
+ * @brief The smallest and largest node IDs, served from the bounds the
+ * inserts maintain. The out table is only read when they are unknown, or by
+ * read-only handles, which see a checkpoint.
+ */
 node_id_t SplitEdgeKey::get_min_node_id()
 {
-  WT_CURSOR *cursor = get_new_out_cursor();
-  node_id_t src, dst;
-  int ret = cursor->next(cursor);
-  if (ret == 0)
+  node_id_t min_id, max_id;
+  if (opts.read_only || !counters->node_bounds(&min_id, &max_id))
   {
-    CommonUtil::ekey_get_key(cursor, &src, &dst);
-    assert(dst == OutOfBand_ID_MIN);
+    seek_node_bounds(&min_id, &max_id);
   }
-  else
+  return min_id;
+}
+
+node_id_t SplitEdgeKey::get_max_node_id()
+{
+  node_id_t min_id, max_id;
+  if (opts.read_only || !counters->node_bounds(&min_id, &max_id))
   {
-    throw GraphException("Could not get the minimum node ID");
+    seek_node_bounds(&min_id, &max_id);
   }
-  cursor->close(cursor);
-  return src;
+  return max_id;
 }
 
-node_id_t SplitEdgeKey::get_max_node_id()
+void SplitEdgeKey::seek_node_bounds(node_id_t *min_id, node_id_t *max_id)
 {
   WT_CURSOR *cursor = get_new_out_cursor();
-  node_id_t src, dst;
-  int ret = cursor->prev(cursor);
-  if (ret == 0)
+  node_id_t dst;
+  if (cursor->next(cursor) != 0)
   {
-    CommonUtil::ekey_get_key(cursor, &src, &dst);
+    cursor->close(cursor);
+    throw GraphException("Could not get the minimum node ID");
   }
-  else
+  CommonUtil::ekey_get_key(cursor, min_id, &dst);
+  assert(dst == OutOfBand_ID_MIN);
+  cursor->reset(cursor);
+  if (cursor->prev(cursor) != 0)
   {
+    cursor->close(cursor);
     throw GraphException("Could not get the maximum node ID");
   }
+  CommonUtil::ekey_get_key(cursor, max_id, &dst);
   cursor->close(cursor);
-  return src;
+  if (!opts.read_only) counters->set_node_bounds(*min_id, *max_id);
 }
 
 int SplitEdgeKey::delete_node(node_id_t node_id)
@@ -1033,6 +1397,7 @@ int SplitEdgeKey::delete_node(node_id_t node_id)
     session->commit_transaction(session, nullptr);
     GraphBase::increment_edges(num_edges_to_add);
     GraphBase::increment_nodes(-1);
+    counters->node_deleted(node_id);
   }
   return 0;
 }
@@ -1068,6 +1433,10 @@ int SplitEdgeKey::delete_node_and_related_edges(node_id_t node_id,
     session->rollback_transaction(session, nullptr);
     return ret;
   }
+  if (degree_cursor != nullptr && (ret = remove_degree_record(node_id)))
+  {
+    return ret;  // rolled back
+  }
 
   while (out_edge_cursor->next(out_edge_cursor) == 0)
   {
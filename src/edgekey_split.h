@@ -10,6 +10,7 @@
 #include "common_util.h"
 #include "graph.h"
 #include "graph_exception.h"
+#include "key_decode.h"
 
 class SplitEdgeKey : public GraphBase
 {
@@ -26,6 +27,9 @@ class SplitEdgeKey : public GraphBase
   void get_random_node_ids(std::vector<node_id_t> &ids, int num_nodes) override;
   degree_t get_in_degree(node_id_t node_id) override;
   degree_t get_out_degree(node_id_t node_id) override;
+  void get_degrees(key_range keys,
+                   std::span<degree_t> out_degrees,
+                   std::span<degree_t> in_degrees = {}) override;
   std::vector<node> get_nodes() override;
   int add_edge(edge to_insert, bool is_bulk) override;
   bool has_edge(node_id_t src_id, node_id_t dst_id) override;
@@ -68,6 +72,7 @@ class SplitEdgeKey : public GraphBase
   }
   WT_CURSOR *get_new_node_index_cursor();
   static void create_indices(WT_SESSION *session);
+  static void create_degree_table(WT_SESSION *session);
   void dump_table(std::string &table_name, int num_records);
 
  private:
@@ -75,17 +80,41 @@ class SplitEdgeKey : public GraphBase
   WT_CURSOR *random_node_cursor = nullptr;
   WT_CURSOR *in_edge_cursor = nullptr;
   WT_CURSOR *dst_src_idx_cursor = nullptr;
+  // Set if opts.degree_table; keyed by MAKE_EKEY(node_id)
+  WT_CURSOR *degree_cursor = nullptr;
+  std::vector<node_id_t> visit_buf;  // list for visit_out_lists
 
   // internal methods
   [[maybe_unused]] WT_CURSOR *get_metadata_cursor();
   int delete_node_and_related_edges(node_id_t node_id, int *num_edges_to_del);
   int update_node_degree(node_id_t node_id, int in_change, int out_change);
+  int set_degree_record(node_id_t node_id, degree_t in, degree_t out);
+  int remove_degree_record(node_id_t node_id);
+  void get_degree_record(node_id_t node_id, degree_t *in, degree_t *out);
   int add_node_txn(node to_insert,
                    int *num_nodes_added,
                    int32_t indeg_change,
                    int32_t outdeg_change);
   int error_check_insert_txn(int return_val, bool ignore_duplicate_key);
   int error_check_read_txn(int return_val);
+  int add_edge_batch(std::span<const edge> batch) override;
+  void seek_node_bounds(node_id_t *min_id, node_id_t *max_id);
+  void visit_out_neighbors(node_id_t node_id,
+                           nbr_visitor visit,
+                           void *ctx) override;
+  void visit_in_neighbors(node_id_t node_id,
+                          nbr_visitor visit,
+                          void *ctx) override;
+  void visit_edge_table(WT_CURSOR *cursor,
+                        node_id_t node_id,
+                        nbr_visitor visit,
+                        void *ctx);
+  void visit_out_lists(std::span<const node_id_t> node_ids,
+                       list_visitor visit,
+                       void *ctx) override;
+  void visit_out_edges(node_id_t node_id,
+                       edge_visitor visit,
+                       void *ctx) override;
 
   [[maybe_unused]] inline void close_all_cursors() override
   {
@@ -93,6 +122,7 @@ class SplitEdgeKey : public GraphBase
     random_node_cursor->close(random_node_cursor);
     in_edge_cursor->close(in_edge_cursor);
     dst_src_idx_cursor->close(dst_src_idx_cursor);
+    if (degree_cursor != nullptr) degree_cursor->close(degree_cursor);
   }
 };
 
@@ -107,6 +137,7 @@ class SplitEkeyInCursor : public InCursor
   {
     cursor = cur;
     session = sess;
+    sorted = true;  // edge keys are ordered by (dst, src)
     set_key_range({OutOfBand_ID_MIN, OutOfBand_ID_MAX});
   }
   SplitEkeyInCursor(WT_CURSOR *cur,
@@ -118,6 +149,7 @@ class SplitEkeyInCursor : public InCursor
     session = sess;
     directed = is_directed;
     read_opt = read_optimized;
+    sorted = true;
     set_key_range({OutOfBand_ID_MIN, OutOfBand_ID_MAX});
   }
   ~SplitEkeyInCursor() override = default;
@@ -215,16 +247,25 @@ class SplitEKeyOutCursor : public OutCursor
 {
  private:
   // bool is_weighted = false;
-  node_id_t curr_node{};
+  EKeyScanBuffer scan;  // keys are read ahead and decoded in batches
 
  public:
   SplitEKeyOutCursor(WT_CURSOR *cur, WT_SESSION *sess)
   {
     cursor = cur;
     session = sess;
+    sorted = true;  // edge keys are ordered by (src, dst)
     set_key_range({OutOfBand_ID_MIN, OutOfBand_ID_MAX});
   }
   ~SplitEKeyOutCursor() override = default;
+  // Starts over at the beginning of the key range; whatever was read ahead
+  // is dropped
+  void reset() override
+  {
+    OutCursor::reset();
+    set_key_range(keys);
+  }
+
   void set_key_range(key_range _keys) override
   {
     keys.start = _keys.start;
@@ -241,6 +282,8 @@ class SplitEKeyOutCursor : public OutCursor
     // Advance the cursor to the first record >= start
 
     int status;
+    scan.clear();
+    has_next = true;
     cursor->search_near(cursor, &status);
     if (status < 0)
     {
@@ -251,52 +294,68 @@ class SplitEKeyOutCursor : public OutCursor
         return;
       }
     }
-    node_id_t temp_dst;
-    CommonUtil::ekey_get_key(cursor, &curr_node, &temp_dst);
   }
 
   void next(adjlist *found) override
   {
-    node_id_t src, dst;
+    found->edgelist.clear();
+    found->node_id = read_list(found->edgelist);
+    found->degree = found->node_id == OutOfBand_ID_MAX
+                        ? UINT32_MAX
+                        : found->edgelist.size();
+  }
 
-    if (!has_next)
+  // Appends straight to the flat neighbour array of the batch
+  size_t next_batch(adjlist_batch &batch,
+                    size_t max_nodes,
+                    size_t max_edges) override
+  {
+    batch.clear();
+    while (batch.size() < max_nodes && batch.edges.size() < max_edges)
     {
-      found->node_id = OutOfBand_ID_MAX;
-      found->degree = UINT32_MAX;
-      found->edgelist.clear();
-      return;
+      node_id_t node_id = read_list(batch.edges);
+      if (node_id == OutOfBand_ID_MAX) break;
+      batch.end_list(node_id);
     }
+    return batch.size();
+  }
 
-    // get edge
-    CommonUtil::ekey_get_key(cursor, &src, &dst);
-    if (dst == OutOfBand_ID_MIN) curr_node = src;
-    while (cursor->next(cursor) == 0)
+  void next(adjlist *found, node_id_t key) override {}
+
+ private:
+  /**
+   * @brief Appends the out list of the next node in range that has edges to
+   * out, skipping nodes without any, and leaves the scan on the first record
+   * of the node after it.
+   * @return the node's ID, or OutOfBand_ID_MAX past the end of the range
+   */
+  node_id_t read_list(std::vector<node_id_t> &out)
+  {
+    node_id_t src, dst;
+    if (!has_next || !scan.current(cursor, &src, &dst))
     {
-      CommonUtil::ekey_get_key(cursor, &src, &dst);
-      found->node_id = curr_node;
-      if (src == curr_node && dst != OutOfBand_ID_MIN)
+      has_next = false;
+      return OutOfBand_ID_MAX;
+    }
+    // The scan is on the first record of a node: its node record (dst is
+    // OutOfBand_ID_MIN) or, if it has none, its first edge
+    while (src <= keys.end)
+    {
+      node_id_t node_id = src;
+      size_t start = out.size();
+      if (dst != OutOfBand_ID_MIN) out.push_back(dst);
+      bool more;
+      while ((more = scan.advance(cursor, &src, &dst)) && src == node_id)
       {
-        found->edgelist.push_back(dst);
-        found->degree++;
-      }
-      else
-      {
-        curr_node = src;
-        if (found->degree == 0) continue;  // don't return empty nodes
-        if (curr_node > keys.end)
-        {
-          has_next = false;
-          return;
-        }
-        return;
+        out.push_back(dst);
       }
+      if (!more) has_next = false;
+      if (out.size() > start) return node_id;
+      if (!more) return OutOfBand_ID_MAX;
     }
-    // found->node_id = src;
-    found->node_id = OutOfBand_ID_MAX;
     has_next = false;
+    return OutOfBand_ID_MAX;
   }
-
-  void next(adjlist *found, node_id_t key) override {}
 };
 
 class SplitEKeyNodeCursor : public NodeCursor
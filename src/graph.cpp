@@ -3,6 +3,7 @@
 
 #include <wiredtiger.h>
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <string>
@@ -11,13 +12,11 @@
 #include "graph_exception.h"
 using namespace std;
 
-std::atomic<node_id_t> GraphBase::local_nnodes(0);
-std::atomic<edge_id_t> GraphBase::local_nedges(0);
-
 GraphBase::GraphBase(graph_opts &opt_params, WT_CONNECTION *conn)
 {
   opts = opt_params;
   connection = conn;
+  counters = GraphCounters::for_connection(conn);
   if (CommonUtil::open_session(conn, &session) != 0)
   {
     throw GraphException("Cannot open session");
@@ -87,9 +86,10 @@ void GraphBase::create_metadata_table(graph_opts &opts, WT_CONNECTION *conn)
                              metadata_cursor);
 
   // NUM_EDGES = 0
+  edge_id_t temp_edges = 0;
   GraphBase::insert_metadata(MetadataKey::num_edges,
-                             (char *)&temp_num,
-                             sizeof(uint64_t),
+                             (char *)&temp_edges,
+                             sizeof(edge_id_t),
                              metadata_cursor);
 
   // Max_node_it =0
@@ -103,6 +103,34 @@ void GraphBase::create_metadata_table(graph_opts &opts, WT_CONNECTION *conn)
                              sizeof(node_id_t),
                              metadata_cursor);
 
+  // ADJLIST_LAYOUT and ADJLIST_CHUNK_SIZE
+  GraphBase::insert_metadata(MetadataKey::adjlist_layout,
+                             (char *)&opts.adjlist_layout,
+                             sizeof(AdjListLayout),
+                             metadata_cursor);
+  GraphBase::insert_metadata(MetadataKey::adjlist_chunk_size,
+                             (char *)&opts.adjlist_chunk_size,
+                             sizeof(degree_t),
+                             metadata_cursor);
+
+  // SORTED_ADJLIST
+  GraphBase::insert_metadata(MetadataKey::sorted_adjlist,
+                             (char *)(&opts.sorted_adjlist),
+                             sizeof(bool),
+                             metadata_cursor);
+
+  // ADJLIST_CODEC
+  GraphBase::insert_metadata(MetadataKey::adjlist_codec,
+                             (char *)(&opts.adjlist_codec),
+                             sizeof(AdjListCodec),
+                             metadata_cursor);
+
+  // DEGREE_TABLE
+  GraphBase::insert_metadata(MetadataKey::degree_table,
+                             (char *)(&opts.degree_table),
+                             sizeof(bool),
+                             metadata_cursor);
+
   metadata_cursor->close(metadata_cursor);
   session->close(session, nullptr);
 }
@@ -239,6 +267,11 @@ int GraphBase::_get_table_cursor(const std::string &table,
 void GraphBase::close(bool synchronize)
 {
   if (synchronize) sync_metadata();
+  if (count_slot != nullptr)
+  {
+    counters->release(count_slot);
+    count_slot = nullptr;
+  }
   int ret = session->close(session, nullptr);
   if (ret != 0)
   {
@@ -254,6 +287,7 @@ void GraphBase::_restore_from_db()
 
   int key;
   WT_ITEM item;
+  int64_t num_nodes = 0, num_edges = 0;
   while (cursor->next(cursor) == 0)
   {
     cursor->get_key(cursor, &key);
@@ -282,14 +316,45 @@ void GraphBase::_restore_from_db()
     else if (key == MetadataKey::num_nodes)
     {
       this->opts.num_nodes = *((node_id_t *)item.data);
-      GraphBase::local_nnodes.store(this->opts.num_nodes);
+      num_nodes = this->opts.num_nodes;
     }
     else if (key == MetadataKey::num_edges)
     {
-      this->opts.num_edges = *((uint64_t *)item.data);
-      GraphBase::local_nedges.store(this->opts.num_edges);
+      // Older DBs store this as 8 bytes, sync_metadata as an edge_id_t
+      uint64_t edges = 0;
+      std::memcpy(&edges, item.data, std::min(item.size, sizeof(edges)));
+      this->opts.num_edges = edges;
+      num_edges = (int64_t)edges;
+    }
+    else if (key == MetadataKey::adjlist_layout)
+    {
+      this->opts.adjlist_layout = *((AdjListLayout *)item.data);
+    }
+    else if (key == MetadataKey::adjlist_chunk_size)
+    {
+      // A chunk size of 0 would never fill a chunk
+      if (item.size != sizeof(degree_t) || *((degree_t *)item.data) == 0)
+      {
+        throw GraphException("Invalid adjlist_chunk_size in the metadata of " +
+                             opts.db_name);
+      }
+      this->opts.adjlist_chunk_size = *((degree_t *)item.data);
+    }
+    else if (key == MetadataKey::sorted_adjlist)
+    {
+      this->opts.sorted_adjlist = *((bool *)item.data);
+    }
+    else if (key == MetadataKey::adjlist_codec)
+    {
+      this->opts.adjlist_codec = *((AdjListCodec *)item.data);
+    }
+    else if (key == MetadataKey::degree_table)
+    {
+      this->opts.degree_table = *((bool *)item.data);
     }
   }
+  // A no-op if the engine or another handle loaded them first
+  counters->load(num_nodes, num_edges);
 }
 
 /**
@@ -331,14 +396,16 @@ int GraphBase::_get_index_cursor(const std::string &table_name,
 
 void GraphBase::sync_metadata()
 {
-  node_id_t temp = GraphBase::get_num_nodes();
+  int64_t num_nodes, num_edges;
+  fold_counts(&num_nodes, &num_edges);
+  node_id_t temp = num_nodes;
   insert_metadata(MetadataKey::num_nodes,
                   (char *)&temp,
                   sizeof(node_id_t),
                   metadata_cursor);
-  temp = GraphBase::get_num_edges();
+  edge_id_t temp_edges = num_edges;
   insert_metadata(MetadataKey::num_edges,
-                  (char *)&temp,
+                  (char *)&temp_edges,
                   sizeof(edge_id_t),
                   metadata_cursor);
 
@@ -359,20 +426,228 @@ void GraphBase::sync_metadata()
 #endif
 }
 
-node_id_t GraphBase::get_num_nodes() { return GraphBase::local_nnodes.load(); };
+// Copies the degrees cursor reports for [keys.start, keys.end] into degrees
+template <typename Cursor>
+static void fill_degrees(Cursor *cursor,
+                         key_range keys,
+                         std::span<degree_t> degrees)
+{
+  std::fill(degrees.begin(), degrees.end(), 0);
+  if (!degrees.empty())
+  {
+    cursor->set_key_range(keys);
+    adjlist_view found;
+    cursor->next_view(&found);
+    while (found.node_id != OutOfBand_ID_MAX && found.node_id <= keys.end)
+    {
+      node_id_t i = found.node_id - keys.start;
+      if (found.node_id >= keys.start && i < degrees.size())
+      {
+        degrees[i] = found.degree;
+      }
+      cursor->next_view(&found);
+    }
+  }
+  cursor->close();
+  delete cursor;
+}
+
+void GraphBase::get_degrees(key_range keys,
+                            std::span<degree_t> out_degrees,
+                            std::span<degree_t> in_degrees)
+{
+  size_t count = std::max(out_degrees.size(), in_degrees.size());
+  if (count == 0) return;
+  keys.end = std::min<node_id_t>(keys.end, keys.start + (count - 1));
+  if (!out_degrees.empty())
+  {
+    fill_degrees(get_outnbd_iter(), keys, out_degrees);
+  }
+  if (!in_degrees.empty())
+  {
+    fill_degrees(get_innbd_iter(), keys, in_degrees);
+  }
+}
+
+node_id_t GraphBase::get_num_nodes() { return counters->num_nodes(); };
 
 /**
  * This function is used to increment the number of nodes local to a connection.
- * Updates are atomic but NOT transactional.
+ * Updates go to this handle's counter slot; they are atomic but NOT
+ * transactional, so the count is exact only once the transactions that made
+ * them have committed.
  * @param increment
  */
 void GraphBase::increment_nodes(int increment)
 {
-  GraphBase::local_nnodes += increment;
+  get_count_slot()->add_nodes(increment);
 }
 
-edge_id_t GraphBase::get_num_edges() { return GraphBase::local_nedges.load(); };
+edge_id_t GraphBase::get_num_edges() { return counters->num_edges(); };
 void GraphBase::increment_edges(int increment)
 {
-  GraphBase::local_nedges += increment;
-}
\ No newline at end of file
+  get_count_slot()->add_edges(increment);
+}
+
+/**
+ * @brief Widens the cached min/max node IDs to include node_id. Called for
+ * every node an insert touches, including the endpoints of a new edge.
+ */
+void GraphBase::note_node_id(node_id_t node_id)
+{
+  get_count_slot()->add_id(node_id);
+}
+
+/**
+ * @brief Folds the pending per-handle deltas into the totals that get
+ * persisted and returns them. Used by the metadata syncs.
+ */
+void GraphBase::fold_counts(int64_t *num_nodes, int64_t *num_edges)
+{
+  counters->fold(num_nodes, num_edges);
+}
+/**
+ * @brief Inserts the edges in to_insert. The batch is sorted by (src, dst) and
+ * written in transactions of at most max_txn_edges edges, so the adjacency
+ * lists and degrees of a node are rewritten once per transaction rather than
+ * once per edge. Representations without a batched write path fall back to
+ * one transaction per edge.
+ *
+ * A transaction that fails is split in half and the halves retried, so a
+ * conflict or a duplicate edge only costs the sub-batch holding it. A single
+ * edge that keeps rolling back is tried EDGE_BATCH_MAX_RETRIES times.
+ *
+ * @param failed If not null, receives the edges that were not inserted.
+ * @return 0 if every edge was inserted, else the error of the last edge that
+ * was not: WT_DUPLICATE_KEY if it already exists, WT_ROLLBACK if it kept
+ * conflicting.
+ */
+int GraphBase::add_edges(std::span<const edge> to_insert,
+                         std::vector<edge> *failed,
+                         size_t max_txn_edges)
+{
+  std::vector<edge> sorted(to_insert.begin(), to_insert.end());
+  std::sort(sorted.begin(),
+            sorted.end(),
+            [](const edge &a, const edge &b)
+            {
+              return a.src_id < b.src_id ||
+                     (a.src_id == b.src_id && a.dst_id < b.dst_id);
+            });
+  size_t txn_edges =
+      batched_edge_writes ? std::max<size_t>(max_txn_edges, 1) : 1;
+
+  int ret = 0;
+  std::span<const edge> all(sorted);
+  for (size_t i = 0; i < all.size(); i += txn_edges)
+  {
+    int batch_ret = add_edge_batch_retry(
+        all.subspan(i, std::min(txn_edges, all.size() - i)), failed);
+    if (batch_ret != 0)
+    {
+      ret = batch_ret;
+    }
+  }
+  return ret;
+}
+
+int GraphBase::add_edge_batch_retry(std::span<const edge> batch,
+                                    std::vector<edge> *failed)
+{
+  int ret = add_edge_batch(batch);
+  if (batch.size() == 1)
+  {
+    for (int tries = 1; ret == WT_ROLLBACK && tries < EDGE_BATCH_MAX_RETRIES;
+         tries++)
+    {
+      ret = add_edge_batch(batch);
+    }
+    if (ret != 0 && failed != nullptr)
+    {
+      failed->push_back(batch[0]);
+    }
+    return ret;
+  }
+  if (ret == 0)
+  {
+    return 0;
+  }
+  size_t half = batch.size() / 2;
+  int first = add_edge_batch_retry(batch.first(half), failed);
+  int second = add_edge_batch_retry(batch.subspan(half), failed);
+  return second != 0 ? second : first;
+}
+
+/**
+ * @brief Default for representations that leave batched_edge_writes unset:
+ * add_edges() then only passes single edges.
+ */
+int GraphBase::add_edge_batch(std::span<const edge> batch)
+{
+  assert(batch.size() == 1);
+  return add_edge(batch[0], false);
+}
+
+/**
+ * @brief Fallback for for_each_out_neighbor on representations that do not
+ * walk their tables directly. This still materializes the list.
+ */
+void GraphBase::visit_out_neighbors(node_id_t node_id,
+                                    nbr_visitor visit,
+                                    void *ctx)
+{
+  for (node_id_t nbr : get_out_nodes_id(node_id))
+  {
+    if (!visit(ctx, nbr))
+    {
+      break;
+    }
+  }
+}
+
+void GraphBase::visit_in_neighbors(node_id_t node_id,
+                                   nbr_visitor visit,
+                                   void *ctx)
+{
+  for (node_id_t nbr : get_in_nodes_id(node_id))
+  {
+    if (!visit(ctx, nbr))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Fallback for for_each_out_edge; this still materializes the edges.
+ */
+void GraphBase::visit_out_edges(node_id_t node_id,
+                                edge_visitor visit,
+                                void *ctx)
+{
+  for (const edge &e : get_out_edges(node_id))
+  {
+    if (!visit(ctx, e.dst_id, e.edge_weight))
+    {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Fallback for get_out_nodes_multi: one lookup per ID, but in key
+ * order, which keeps consecutive lookups on the pages the last one loaded.
+ */
+void GraphBase::visit_out_lists(std::span<const node_id_t> node_ids,
+                                list_visitor visit,
+                                void *ctx)
+{
+  for (node_id_t node_id : node_ids)
+  {
+    std::vector<node_id_t> nbrs = get_out_nodes_id(node_id);
+    if (!visit(ctx, node_id, nbrs))
+    {
+      break;
+    }
+  }
+}
@@ -7,10 +7,15 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "common_util.h"
+#include "graph_counters.h"
 #include "graph_exception.h"
 
 class GraphBase
@@ -18,6 +23,7 @@ class GraphBase
  public:
   GraphBase() = default;
   GraphBase(graph_opts &opt_params, WT_CONNECTION *conn);
+  virtual ~GraphBase() = default;
 
   static void insert_metadata(int key,
                               const char *value,
@@ -36,6 +42,9 @@ class GraphBase
   virtual bool has_node(node_id_t node_id) = 0;
   virtual int delete_node(node_id_t node_id) = 0;
   virtual int add_edge(edge to_insert, bool is_bulk) = 0;
+  int add_edges(std::span<const edge> to_insert,
+                std::vector<edge> *failed = nullptr,
+                size_t max_txn_edges = EDGE_BATCH_TXN_MAX);
   virtual int delete_edge(node_id_t src_id, node_id_t dst_id) = 0;
   virtual edge get_edge(node_id_t src_id, node_id_t dst_id) = 0;
   // void update_edge(edge to_update); no need to implement.
@@ -45,12 +54,89 @@ class GraphBase
 
   virtual degree_t get_out_degree(node_id_t node_id) = 0;
   virtual degree_t get_in_degree(node_id_t node_id) = 0;
+  /**
+   * @brief Sets out_degrees[i], and in_degrees[i] if in_degrees is not empty,
+   * to the degrees of node keys.start + i, for every ID in keys that fits in
+   * the arrays. IDs without a node get 0. The default walks the adjacency
+   * cursors once; representations with a dense degree table read that.
+   */
+  virtual void get_degrees(key_range keys,
+                           std::span<degree_t> out_degrees,
+                           std::span<degree_t> in_degrees = {});
   virtual std::vector<edge> get_out_edges(node_id_t node_id) = 0;
   virtual std::vector<node> get_out_nodes(node_id_t node_id) = 0;
 
   virtual std::vector<node_id_t> get_out_nodes_id(node_id_t node_id) = 0;
   virtual std::vector<node_id_t> get_in_nodes_id(node_id_t node_id) = 0;
 
+  /**
+   * @brief Calls f(v) for each out neighbour v of node_id while walking the
+   * table, without building a vector. If f returns bool, returning false
+   * stops the walk. f must not call back into this graph handle.
+   */
+  template <typename F>
+  void for_each_out_neighbor(node_id_t node_id, F &&f)
+  {
+    visit_out_neighbors(
+        node_id,
+        &invoke_visitor<std::remove_reference_t<F>, node_id_t>,
+        (void *)&f);
+  }
+  template <typename F>
+  void for_each_in_neighbor(node_id_t node_id, F &&f)
+  {
+    visit_in_neighbors(
+        node_id,
+        &invoke_visitor<std::remove_reference_t<F>, node_id_t>,
+        (void *)&f);
+  }
+  /**
+   * @brief Calls f(v, w) for each out edge (node_id, v) of weight w, the
+   * same way for_each_out_neighbor() does, for callers that need the weights
+   * without the std::vector<edge> of get_out_edges().
+   */
+  template <typename F>
+  void for_each_out_edge(node_id_t node_id, F &&f)
+  {
+    visit_out_edges(
+        node_id,
+        &invoke_visitor<std::remove_reference_t<F>, node_id_t, edgeweight_t>,
+        (void *)&f);
+  }
+
+  /**
+   * @brief Calls f(u, nbrs) with the out neighbours of every distinct ID u in
+   * node_ids. The IDs are visited in ascending order rather than the order
+   * given, so the table is walked front to back: a node stored right after
+   * the previous one costs a cursor step instead of a B-tree descent, and
+   * the pages the walk needs are read in file order. Every ID must be a node.
+   * nbrs is only valid during the call; if f returns bool, returning false
+   * stops the walk. f must not call back into this graph handle.
+   */
+  template <typename F>
+  void get_out_nodes_multi(std::span<const node_id_t> node_ids, F &&f)
+  {
+    visit_out_lists(sort_multi_ids(node_ids),
+                    &invoke_visitor<std::remove_reference_t<F>,
+                                    node_id_t,
+                                    std::span<const node_id_t>>,
+                    (void *)&f);
+  }
+  /**
+   * @brief Same as get_out_nodes_multi(), but calls f(u, v, w) for every out
+   * edge (u, v) of weight w, through for_each_out_edge() in key order.
+   */
+  template <typename F>
+  void get_out_edges_multi(std::span<const node_id_t> node_ids, F &&f)
+  {
+    for (node_id_t node_id : sort_multi_ids(node_ids))
+    {
+      for_each_out_edge(node_id,
+                        [&](node_id_t dst, edgeweight_t weight)
+                        { f(node_id, dst, weight); });
+    }
+  }
+
   virtual std::vector<edge> get_in_edges(node_id_t node_id) = 0;
   virtual std::vector<node> get_in_nodes(node_id_t node_id) = 0;
 
@@ -65,10 +151,12 @@ class GraphBase
   virtual node_id_t get_max_node_id() = 0;
   virtual node_id_t get_min_node_id() = 0;
 
-  static node_id_t get_num_nodes();
-  static edge_id_t get_num_edges();
-  static void increment_nodes(int increment);
-  static void increment_edges(int increment);
+  node_id_t get_num_nodes();
+  edge_id_t get_num_edges();
+  void fold_counts(int64_t *num_nodes, int64_t *num_edges);
+  void increment_nodes(int increment);
+  void increment_edges(int increment);
+  void note_node_id(node_id_t node_id);
 
   [[nodiscard]] std::string get_db_name() const { return opts.db_name; };
 
@@ -78,8 +166,19 @@ class GraphBase
   WT_SESSION *session = nullptr;
   WT_CURSOR *metadata_cursor = nullptr;
 
-  static std::atomic<node_id_t> local_nnodes;
-  static std::atomic<edge_id_t> local_nedges;
+  // Statistics of the DB behind connection, shared with the engine and its
+  // other handles; this handle adds to its own slot (see graph_counters.h),
+  // taken on its first insert or delete
+  std::shared_ptr<GraphCounters> counters;
+  GraphCounters::slot *count_slot = nullptr;
+  GraphCounters::slot *get_count_slot()
+  {
+    if (count_slot == nullptr) count_slot = counters->acquire();
+    return count_slot;
+  }
+
+  // Set by representations that implement add_edge_batch()
+  bool batched_edge_writes = false;
 
   [[maybe_unused]] WT_CONNECTION *get_db_conn() { return this->connection; }
   [[maybe_unused]] WT_SESSION *get_db_session() { return this->session; }
@@ -97,6 +196,70 @@ class GraphBase
   [[maybe_unused]] void _restore_from_db();
   [[maybe_unused]] void sync_metadata();
   virtual void close_all_cursors() = 0;
+
+  /**
+   * @brief Inserts a batch of edges, sorted by (src, dst), in one
+   * transaction. Commits on success; on failure the transaction has been
+   * rolled back and nothing in the batch was applied.
+   * @return 0, WT_ROLLBACK, WT_DUPLICATE_KEY if an edge already exists, or
+   * another WT error
+   */
+  virtual int add_edge_batch(std::span<const edge> batch);
+  int add_edge_batch_retry(std::span<const edge> batch,
+                           std::vector<edge> *failed);
+
+  // Type erased for_each_*_neighbor callback; returns false to stop the walk
+  typedef bool (*nbr_visitor)(void *ctx, node_id_t nbr);
+  // The defaults go through get_{out,in}_nodes_id
+  virtual void visit_out_neighbors(node_id_t node_id,
+                                   nbr_visitor visit,
+                                   void *ctx);
+  virtual void visit_in_neighbors(node_id_t node_id,
+                                  nbr_visitor visit,
+                                  void *ctx);
+
+  // Type erased get_out_nodes_multi callback; returns false to stop the walk
+  typedef bool (*list_visitor)(void *ctx,
+                               node_id_t node_id,
+                               std::span<const node_id_t> nbrs);
+  // node_ids is sorted and free of duplicates. The default goes through
+  // get_out_nodes_id
+  virtual void visit_out_lists(std::span<const node_id_t> node_ids,
+                               list_visitor visit,
+                               void *ctx);
+  // Type erased for_each_out_edge callback; returns false to stop the walk
+  typedef bool (*edge_visitor)(void *ctx, node_id_t nbr, edgeweight_t weight);
+  // The default goes through get_out_edges
+  virtual void visit_out_edges(node_id_t node_id,
+                               edge_visitor visit,
+                               void *ctx);
+
+ private:
+  std::vector<node_id_t> multi_ids;  // sorted copy for the multi-gets
+
+  std::span<const node_id_t> sort_multi_ids(std::span<const node_id_t> ids)
+  {
+    multi_ids.assign(ids.begin(), ids.end());
+    std::sort(multi_ids.begin(), multi_ids.end());
+    multi_ids.erase(std::unique(multi_ids.begin(), multi_ids.end()),
+                    multi_ids.end());
+    return multi_ids;
+  }
+
+  template <typename F, typename... Args>
+  static bool invoke_visitor(void *ctx, Args... args)
+  {
+    F &f = *static_cast<F *>(ctx);
+    if constexpr (std::is_same_v<std::invoke_result_t<F &, Args...>, bool>)
+    {
+      return f(args...);
+    }
+    else
+    {
+      f(args...);
+      return true;
+    }
+  }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,255 @@
+#ifndef GRAPH_COUNTERS_H
+#define GRAPH_COUNTERS_H
+
+#include <wiredtiger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common_defs.h"
+
+/**
+ * @brief The statistics of one graph DB: its node and edge counts and its
+ * smallest and largest node IDs. There is one object per WT connection,
+ * shared by the GraphEngine that opened it and every handle on it, so graphs
+ * opened side by side in one process keep separate counts.
+ *
+ * The counts are kept as per-handle deltas on top of a base value. Every
+ * graph handle owns a slot on its own cache line, so the fetch_add an insert
+ * does never contends with other handles. Readers take the lock and add the
+ * slots to the base, which is cheap as long as reads are rare (partitioning,
+ * metadata syncs). fold() moves all pending deltas into the base; the base is
+ * what gets persisted in the metadata table.
+ *
+ * The node ID bounds are widened by every insert, so get_max_node_id() and
+ * get_min_node_id() need no table seek. Deleting a node on a bound, like
+ * opening an existing DB, leaves them unknown until the next seek.
+ */
+class GraphCounters
+{
+ public:
+  struct alignas(64) slot
+  {
+    std::atomic<int64_t> nodes{0};
+    std::atomic<int64_t> edges{0};
+    std::atomic<node_id_t> min_id{OutOfBand_ID_MAX};
+    std::atomic<node_id_t> max_id{0};
+
+    void add_nodes(int64_t delta)
+    {
+      nodes.fetch_add(delta, std::memory_order_relaxed);
+    }
+    void add_edges(int64_t delta)
+    {
+      edges.fetch_add(delta, std::memory_order_relaxed);
+    }
+    // Widens the bounds to include id; a CAS loop, but it only loops when the
+    // bound actually moves
+    void add_id(node_id_t id)
+    {
+      node_id_t cur = max_id.load(std::memory_order_relaxed);
+      while (id > cur &&
+             !max_id.compare_exchange_weak(cur, id, std::memory_order_relaxed))
+      {
+      }
+      cur = min_id.load(std::memory_order_relaxed);
+      while (id < cur &&
+             !min_id.compare_exchange_weak(cur, id, std::memory_order_relaxed))
+      {
+      }
+    }
+  };
+
+  /**
+   * @brief The statistics of the DB behind conn, created on first use. They
+   * live as long as someone holds the pointer; GraphEngine holds it while
+   * the connection is open.
+   */
+  static std::shared_ptr<GraphCounters> for_connection(WT_CONNECTION *conn)
+  {
+    std::lock_guard<std::mutex> guard(registry_lock);
+    std::shared_ptr<GraphCounters> counters = registry[conn].lock();
+    if (counters == nullptr)
+    {
+      counters = std::make_shared<GraphCounters>();
+      registry[conn] = counters;
+    }
+    return counters;
+  }
+
+  // Called when conn is closed, so a later connection at the same address
+  // starts afresh
+  static void forget_connection(WT_CONNECTION *conn)
+  {
+    std::lock_guard<std::mutex> guard(registry_lock);
+    registry.erase(conn);
+  }
+
+  slot *acquire()
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!free_slots.empty())
+    {
+      slot *s = free_slots.back();
+      free_slots.pop_back();
+      return s;
+    }
+    return &slots.emplace_back();
+  }
+
+  // Folds the slot's deltas into the base and makes it available again
+  void release(slot *s)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    fold_slot(*s);
+    free_slots.push_back(s);
+  }
+
+  int64_t num_nodes()
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    int64_t total = base_nodes;
+    for (slot &s : slots) total += s.nodes.load(std::memory_order_relaxed);
+    return total;
+  }
+
+  int64_t num_edges()
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    int64_t total = base_edges;
+    for (slot &s : slots) total += s.edges.load(std::memory_order_relaxed);
+    return total;
+  }
+
+  /**
+   * @brief Moves every pending delta into the base and returns the totals.
+   * Increments that race with the fold land in the next one.
+   */
+  void fold(int64_t *nodes, int64_t *edges)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    for (slot &s : slots) fold_slot(s);
+    loaded = true;
+    *nodes = base_nodes;
+    *edges = base_edges;
+  }
+
+  // True once the base holds the persisted counts (or the DB is new)
+  bool is_loaded()
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    return loaded;
+  }
+
+  /**
+   * @brief Seeds the base with the counts persisted in the metadata table.
+   * Only the first call has an effect, so a handle opened later does not
+   * reset what the others have counted.
+   */
+  void load(int64_t nodes, int64_t edges)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (loaded) return;
+    base_nodes = nodes;
+    base_edges = edges;
+    loaded = true;
+  }
+
+  // For a DB that was just created: the counts are zero and the bounds known
+  void set_new_graph()
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    loaded = true;
+    bounds_valid = true;
+  }
+
+  /**
+   * @brief The smallest and largest node IDs inserted so far.
+   * @return false if they are unknown and the caller has to seek
+   */
+  bool node_bounds(node_id_t *min_id, node_id_t *max_id)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    return node_bounds_locked(min_id, max_id);
+  }
+
+  // Records the bounds a table seek found, merged with later inserts
+  void set_node_bounds(node_id_t min_id, node_id_t max_id)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    base_min = std::min(base_min, min_id);
+    base_max = std::max(base_max, max_id);
+    bounds_valid = true;
+  }
+
+  // A deleted node on a bound leaves the bounds unknown until the next seek
+  void node_deleted(node_id_t id)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    node_id_t min_id, max_id;
+    if (node_bounds_locked(&min_id, &max_id) && (id <= min_id || id >= max_id))
+    {
+      // The slots may hold the deleted ID too; inserts from here on are
+      // merged with whatever the next seek finds
+      for (slot &s : slots) clear_bounds(s);
+      base_min = OutOfBand_ID_MAX;
+      base_max = 0;
+      bounds_valid = false;
+    }
+  }
+
+ private:
+  std::mutex lock;
+  std::deque<slot> slots;  // a deque never moves its elements
+  std::vector<slot *> free_slots;
+  int64_t base_nodes = 0;
+  int64_t base_edges = 0;
+  bool loaded = false;
+  node_id_t base_min = OutOfBand_ID_MAX;
+  node_id_t base_max = 0;
+  bool bounds_valid = false;
+
+  static inline std::mutex registry_lock;
+  static inline std::map<WT_CONNECTION *, std::weak_ptr<GraphCounters>>
+      registry;
+
+  // exchange() so that an add racing with the fold is not lost
+  void fold_slot(slot &s)
+  {
+    base_nodes += s.nodes.exchange(0, std::memory_order_relaxed);
+    base_edges += s.edges.exchange(0, std::memory_order_relaxed);
+    node_id_t min_id =
+        s.min_id.exchange(OutOfBand_ID_MAX, std::memory_order_relaxed);
+    node_id_t max_id = s.max_id.exchange(0, std::memory_order_relaxed);
+    base_min = std::min(base_min, min_id);
+    base_max = std::max(base_max, max_id);
+  }
+
+  static void clear_bounds(slot &s)
+  {
+    s.min_id.store(OutOfBand_ID_MAX, std::memory_order_relaxed);
+    s.max_id.store(0, std::memory_order_relaxed);
+  }
+
+  // A graph with no nodes has min > max and reports no bounds
+  bool node_bounds_locked(node_id_t *min_id, node_id_t *max_id)
+  {
+    if (!bounds_valid) return false;
+    *min_id = base_min;
+    *max_id = base_max;
+    for (slot &s : slots)
+    {
+      *min_id = std::min(*min_id, s.min_id.load(std::memory_order_relaxed));
+      *max_id = std::max(*max_id, s.max_id.load(std::memory_order_relaxed));
+    }
+    return *min_id <= *max_id;
+  }
+};
+
+#endif  // GRAPH_COUNTERS_H
@@ -1,10 +1,16 @@
 #include "graph_engine.h"
 
+#include <omp.h>
+
+#include <algorithm>
+#include <cstring>
+
 GraphEngine::GraphEngine(int _num_threads, graph_opts &engine_opts)
 {
   num_threads = _num_threads;
   // init with the engine_opts passed as args without copying
   opts = engine_opts;
+  thread_handles.assign(std::max(num_threads, omp_get_max_threads()), nullptr);
   //  opts.print_config("cmd_config.txt");
   if (opts.create_new)
   {
@@ -13,11 +19,59 @@ GraphEngine::GraphEngine(int _num_threads, graph_opts &engine_opts)
   else
   {
     open_connection();
+    std::vector<char> name;
+    if (get_engine_metadata(MetadataKey::last_checkpoint, name))
+    {
+      last_checkpoint.assign(name.begin(), name.end());
+    }
+    if (get_engine_metadata(MetadataKey::checkpoint_seq, name))
+    {
+      std::memcpy(&checkpoint_seq,
+                  name.data(),
+                  std::min(name.size(), sizeof(checkpoint_seq)));
+    }
   }
+  load_stats();
+}
+
+/**
+ * @brief Sets up the statistics shared by the handles of this engine. A new
+ * DB starts at zero with known ID bounds; an existing one starts from the
+ * counts in the metadata table and seeks its bounds on first use.
+ */
+void GraphEngine::load_stats()
+{
+  stats = GraphCounters::for_connection(conn);
+  if (opts.create_new)
+  {
+    stats->set_new_graph();
+    return;
+  }
+  std::vector<char> buf;
+  node_id_t num_nodes = 0;
+  uint64_t num_edges = 0;
+  if (get_engine_metadata(MetadataKey::num_nodes, buf))
+  {
+    std::memcpy(
+        &num_nodes, buf.data(), std::min(buf.size(), sizeof(num_nodes)));
+  }
+  // Older DBs store the edge count as 8 bytes
+  if (get_engine_metadata(MetadataKey::num_edges, buf))
+  {
+    std::memcpy(
+        &num_edges, buf.data(), std::min(buf.size(), sizeof(num_edges)));
+  }
+  stats->load(num_nodes, (int64_t)num_edges);
 }
 
 GraphEngine::~GraphEngine() { close_connection(); }
 
+/**
+ * @brief Takes a checkpoint named after the current time and a sequence number
+ * that only grows over the life of the DB, so two checkpoints taken within
+ * the same second still get different names and a sidecar stamped with the
+ * older one is seen as stale.
+ */
 std::string GraphEngine::make_checkpoint()
 {
   WT_SESSION *session;
@@ -25,19 +79,27 @@ std::string GraphEngine::make_checkpoint()
   auto now =
       std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
   std::tm localTime = *std::localtime(&now);
-  char cpt_name[27];
-  std::strftime(cpt_name, 27, "name=%Y_%m_%d_%H_%M_%S", &localTime);
+  char time_str[20];
+  std::strftime(time_str, sizeof(time_str), "%Y_%m_%d_%H_%M_%S", &localTime);
+  std::string name =
+      std::string(time_str) + "_" + std::to_string(++checkpoint_seq);
+  std::string cpt_config = "name=" + name;
 
-  std::cout << "Creating checkpoint " << cpt_name << std::endl;
+  std::cout << "Creating checkpoint " << cpt_config << std::endl;
   conn->open_session(conn, nullptr, nullptr, &session);
-  if (session->checkpoint(session, cpt_name))
+  if (session->checkpoint(session, cpt_config.c_str()))
   {
     throw GraphException("Failed to create checkpoint");
   }
-  // the checkpoint name without the name= prefix
-  std::strftime(cpt_name, 27, "%Y_%m_%d_%H_%M_%S", &localTime);
-  last_checkpoint = cpt_name;
+  last_checkpoint = name;
   session->close(session, nullptr);
+  // Persisted so sidecar files can be checked against it after a restart
+  set_engine_metadata(MetadataKey::last_checkpoint,
+                      last_checkpoint.c_str(),
+                      last_checkpoint.size());
+  set_engine_metadata(MetadataKey::checkpoint_seq,
+                      (const char *)&checkpoint_seq,
+                      sizeof(checkpoint_seq));
   return last_checkpoint;
 }
 
@@ -75,6 +137,28 @@ GraphBase *GraphEngine::create_graph_handle()
   return ptr;
 }
 
+/**
+ * @brief Returns the graph handle owned by thread tid, creating it on first
+ * use. The handle keeps its session and cursors open across calls, so hot
+ * loops can call this per vertex instead of create_graph_handle(). Each slot
+ * is only ever touched by its own thread. The handles are closed by
+ * close_graph(); callers must not close them.
+ * @param tid The OpenMP thread number (omp_get_thread_num())
+ */
+GraphBase *GraphEngine::thread_handle(int tid)
+{
+  if (tid < 0 || tid >= (int)thread_handles.size())
+  {
+    throw GraphException("No thread handle slot for thread " +
+                         std::to_string(tid));
+  }
+  if (thread_handles[tid] == nullptr)
+  {
+    thread_handles[tid] = create_graph_handle();
+  }
+  return thread_handles[tid];
+}
+
 void GraphEngine::create_indices()
 {
   WT_SESSION *sess;
@@ -89,14 +173,30 @@ void GraphEngine::create_indices()
   }
 }
 
-void GraphEngine::calculate_thread_offsets(bool make_edge)
+/**
+ * @brief Splits the node ID space into key ranges, one per partition.
+ * @param make_edge Also compute the per thread edge ranges
+ * @param num_partitions The number of node ranges to create. Defaults to the
+ * number of threads; pass a multiple of it to over-decompose for dynamic
+ * scheduling, and iterate up to get_num_partitions().
+ */
+void GraphEngine::calculate_thread_offsets(bool make_edge, int num_partitions)
 {
+  if (num_partitions <= 0) num_partitions = num_threads;
   // Create snapshot here first?
   GraphBase *graph_stats = create_graph_handle();
   //_calculate_thread_offsets(num_threads, graph_stats);
-  _calculate_thread_offsets_fast(num_threads, graph_stats);
+  if (opts.partition_mode == PartitionMode::DegreeBalanced)
+  {
+    _calculate_thread_offsets_degree(num_partitions, graph_stats);
+  }
+  else
+  {
+    _calculate_thread_offsets_fast(num_partitions, graph_stats);
+  }
   if (make_edge) _calculate_thread_offsets_edge(num_threads, graph_stats);
   graph_stats->close(false);
+  delete graph_stats;
 }
 
 /**
@@ -193,6 +293,228 @@ void GraphEngine::_calculate_thread_offsets_fast(int thread_max,
   //  }
 }
 
+/**
+ * This function balances the partitions by out-degree instead of by ID width.
+ * It takes prefix sums of (out_degree + 1) per node, read from the node table
+ * if the graph is read optimized and from the out adjlists otherwise, and cuts
+ * the ID space where the prefix sum crosses each multiple of total/thread_max.
+ * The +1 accounts for the cost of visiting a node with no edges.
+ *
+ * The boundaries are persisted in the metadata table, per partition count,
+ * together with the edge count, node count and largest node ID they were
+ * computed for, so reopening an unchanged DB skips the scan.
+ * @param thread_max The number of partitions to create the offsets for
+ * @param graph_stats The graph object to calculate the offsets from
+ */
+void GraphEngine::_calculate_thread_offsets_degree(int thread_max,
+                                                   GraphBase *graph_stats)
+{
+  node_id_t max_node_id = graph_stats->get_max_node_id();
+  if (load_partition_bounds(thread_max, max_node_id)) return;
+
+  std::vector<node_id_t> ids;
+  std::vector<uint64_t> prefix;  // prefix[i] = work of ids[0..i]
+  uint64_t total = 0;
+  if (opts.read_optimize)
+  {
+    NodeCursor *n_cur = graph_stats->get_node_iter();
+    node found;
+    n_cur->next(&found);
+    while (found.id != OutOfBand_ID_MAX)
+    {
+      total += found.out_degree + 1;
+      ids.push_back(found.id);
+      prefix.push_back(total);
+      n_cur->next(&found);
+    }
+    n_cur->close();
+    delete n_cur;
+  }
+  else
+  {
+    // Nodes without out edges are skipped here, they only add their +1
+    OutCursor *out_cur = graph_stats->get_outnbd_iter();
+    adjlist_view found;
+    out_cur->next_view(&found);
+    while (found.node_id != OutOfBand_ID_MAX)
+    {
+      total += found.degree + 1;
+      ids.push_back(found.node_id);
+      prefix.push_back(total);
+      out_cur->next_view(&found);
+    }
+    out_cur->close();
+    delete out_cur;
+  }
+
+  // Not enough nodes to give every partition its own start
+  if (ids.size() < (size_t)thread_max)
+  {
+    _calculate_thread_offsets_fast(thread_max, graph_stats);
+    return;
+  }
+
+  node_ranges.clear();
+  node_ranges.push_back(std::min(graph_stats->get_min_node_id(), ids.front()));
+  size_t prev = 0;
+  for (int i = 1; i < thread_max; ++i)
+  {
+    uint64_t target = total * i / thread_max;
+    // partition i - 1 ends at the first node reaching the target
+    size_t idx =
+        std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin();
+    idx = std::max(idx + 1, prev + 1);
+    idx = std::min(idx, ids.size() - (thread_max - i));
+    node_ranges.push_back(ids[idx]);
+    prev = idx;
+  }
+  node_ranges.push_back(std::max(max_node_id, ids.back()));
+
+  if (!opts.read_only) store_partition_bounds(max_node_id);
+}
+
+using bounds_record = std::pair<partition_bounds_header, std::vector<char>>;
+
+/**
+ * @brief Splits the partition_bounds metadata value into its records. Every
+ * partition count gets its own record: a partition_bounds_header with the
+ * count and the edge count, node count and largest node ID the bounds were
+ * computed for, then the thread_max + 1 boundary IDs. A kernel that calls
+ * both calculate_thread_offsets() and create_range_scheduler() keeps both.
+ * @return the records as (header, record bytes) pairs
+ */
+static std::vector<bounds_record> parse_bounds(const std::vector<char> &buf)
+{
+  std::vector<bounds_record> records;
+  size_t pos = 0;
+  while (pos + sizeof(partition_bounds_header) <= buf.size())
+  {
+    partition_bounds_header header;
+    std::memcpy(&header, buf.data() + pos, sizeof(partition_bounds_header));
+    size_t size = sizeof(partition_bounds_header) +
+                  ((size_t)header.parts + 1) * sizeof(node_id_t);
+    if (pos + size > buf.size()) break;  // not written by this version
+    records.emplace_back(
+        header,
+        std::vector<char>(buf.begin() + pos, buf.begin() + pos + size));
+    pos += size;
+  }
+  return records;
+}
+
+/**
+ * @brief Restores the boundaries saved by store_partition_bounds() for
+ * thread_max partitions. They are only used if the edge count, the node
+ * count and the largest node ID are all unchanged since they were computed;
+ * nodes added without edges would otherwise fall past the last range.
+ * @return true if node_ranges was restored
+ */
+bool GraphEngine::load_partition_bounds(int thread_max, node_id_t max_node_id)
+{
+  std::vector<char> buf;
+  if (!get_engine_metadata(MetadataKey::partition_bounds, buf))
+  {
+    return false;
+  }
+  for (const auto &[header, record] : parse_bounds(buf))
+  {
+    if (header.parts != (uint32_t)thread_max) continue;
+    if (header.num_edges != (edge_id_t)stats->num_edges() ||
+        header.num_nodes != (uint64_t)stats->num_nodes() ||
+        header.max_node_id != max_node_id)
+    {
+      return false;
+    }
+
+    node_ranges.resize(thread_max + 1);
+    std::memcpy(node_ranges.data(),
+                record.data() + sizeof(partition_bounds_header),
+                node_ranges.size() * sizeof(node_id_t));
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Saves node_ranges in the metadata table as the record of its
+ * partition count, replacing an older record for the same count and
+ * dropping the records of other counts that are out of date.
+ */
+void GraphEngine::store_partition_bounds(node_id_t max_node_id)
+{
+  partition_bounds_header header{};
+  header.parts = node_ranges.size() - 1;
+  header.num_edges = stats->num_edges();
+  header.num_nodes = stats->num_nodes();
+  header.max_node_id = max_node_id;
+  std::vector<char> record(sizeof(partition_bounds_header) +
+                           node_ranges.size() * sizeof(node_id_t));
+  std::memcpy(record.data(), &header, sizeof(partition_bounds_header));
+  std::memcpy(record.data() + sizeof(partition_bounds_header),
+              node_ranges.data(),
+              node_ranges.size() * sizeof(node_id_t));
+
+  std::vector<char> buf, old;
+  get_engine_metadata(MetadataKey::partition_bounds, old);
+  for (const auto &[old_header, old_record] : parse_bounds(old))
+  {
+    if (old_header.parts != header.parts &&
+        old_header.num_edges == header.num_edges &&
+        old_header.num_nodes == header.num_nodes &&
+        old_header.max_node_id == header.max_node_id)
+    {
+      buf.insert(buf.end(), old_record.begin(), old_record.end());
+    }
+  }
+  buf.insert(buf.end(), record.begin(), record.end());
+  set_engine_metadata(MetadataKey::partition_bounds, buf.data(), buf.size());
+}
+
+/**
+ * @brief Reads an optional metadata entry through a session of its own.
+ * @return false if the key (or the metadata table) does not exist
+ */
+bool GraphEngine::get_engine_metadata(int key, std::vector<char> &value)
+{
+  WT_SESSION *sess;
+  WT_CURSOR *cursor;
+  CommonUtil::open_session(conn, &sess);
+  if (sess->open_cursor(sess, "table:metadata", nullptr, nullptr, &cursor) !=
+      0)
+  {
+    sess->close(sess, nullptr);
+    return false;
+  }
+
+  bool found = false;
+  cursor->set_key(cursor, key);
+  WT_ITEM item;
+  if (cursor->search(cursor) == 0 && cursor->get_value(cursor, &item) == 0)
+  {
+    value.assign((const char *)item.data, (const char *)item.data + item.size);
+    found = true;
+  }
+  cursor->close(cursor);
+  sess->close(sess, nullptr);
+  return found;
+}
+
+void GraphEngine::set_engine_metadata(int key, const char *value, size_t size)
+{
+  WT_SESSION *sess;
+  WT_CURSOR *cursor;
+  CommonUtil::open_session(conn, &sess);
+  if (sess->open_cursor(sess, "table:metadata", nullptr, nullptr, &cursor) !=
+      0)
+  {
+    sess->close(sess, nullptr);
+    throw GraphException("Failed to open the metadata table");
+  }
+  GraphBase::insert_metadata(key, value, size, cursor);
+  cursor->close(cursor);
+  sess->close(sess, nullptr);
+}
+
 void GraphEngine::_calculate_thread_offsets_edge(int thread_max,
                                                  GraphBase *graph_stats)
 {
@@ -305,11 +627,28 @@ void GraphEngine::open_connection()
   };
 }
 
+void GraphEngine::close_thread_handles()
+{
+  for (GraphBase *&handle : thread_handles)
+  {
+    if (handle != nullptr)
+    {
+      handle->close(false);
+      delete handle;
+      handle = nullptr;
+    }
+  }
+}
+
 void GraphEngine::close_connection()
 {
   // CommonUtil::close_connection(conn);
+  // The pooled sessions must be closed before the connection goes away
+  close_thread_handles();
   if (conn != nullptr)
   {
+    GraphCounters::forget_connection(conn);
+    stats.reset();
     conn->close(conn, nullptr);
     conn = nullptr;
   }
@@ -324,7 +663,7 @@ key_range GraphEngine::get_key_range(int thread_id)
   key_range to_return{};
   // assign so that there is no overlap
   to_return.start = node_ranges[thread_id];
-  if (thread_id < num_threads - 1)
+  if (thread_id < get_num_partitions() - 1)
   {
     to_return.end = node_ranges[thread_id + 1] - 1;
   }
@@ -335,6 +674,185 @@ key_range GraphEngine::get_key_range(int thread_id)
   return to_return;
 }
 
+/**
+ * @brief Splits the node ID space into ranges_per_thread * num_threads ranges
+ * (using the configured partition_mode) and returns a scheduler that hands
+ * them out to the threads. The per thread key ranges returned by
+ * get_key_range() are left untouched. The scheduler is owned by the engine and
+ * replaced by the next call.
+ */
+RangeScheduler *GraphEngine::create_range_scheduler(int ranges_per_thread)
+{
+  std::vector<node_id_t> thread_ranges = node_ranges;
+  calculate_thread_offsets(false, num_threads * ranges_per_thread);
+  std::vector<key_range> ranges;
+  for (int i = 0; i < get_num_partitions(); i++)
+  {
+    // Small ID spaces give repeated boundaries, drop the empty ranges
+    if (i < get_num_partitions() - 1 && node_ranges[i + 1] <= node_ranges[i])
+    {
+      continue;
+    }
+    ranges.push_back(get_key_range(i));
+  }
+  node_ranges = std::move(thread_ranges);
+  range_scheduler =
+      std::make_unique<RangeScheduler>(std::move(ranges), num_threads);
+  return range_scheduler.get();
+}
+
+/**
+ * @brief Copies one direction of the graph into an in-memory CSR snapshot.
+ *
+ * Unless one is given a new checkpoint is taken, and every thread scans its
+ * key range of it once through read-only handles, writing the degrees
+ * straight into the offsets array and buffering its neighbours. After a
+ * prefix sum over the offsets each thread copies its buffer into place; the
+ * ranges are disjoint and in ID order, so a range's neighbours start at
+ * offsets[range.start].
+ *
+ * @param direction OutEdges scans the out adjlists, InEdges the in adjlists.
+ * @param with_weights Also copy the edge weights. The weights come from the
+ * edge table, so the rows are built from it too; only the out direction is
+ * supported.
+ * @param checkpoint_name The checkpoint to read. If empty a new one is taken;
+ * passing the same one for both directions gives snapshots of the same state.
+ * @return The snapshot, owned by the caller. Its build time and
+ * memory_bytes() tell whether materializing pays off for a job.
+ */
+CSRGraph *GraphEngine::materialize_csr(CSRDirection direction,
+                                       bool with_weights,
+                                       const std::string &checkpoint_name)
+{
+  if (with_weights && direction == CSRDirection::InEdges)
+  {
+    throw GraphException("Weighted CSR snapshots only hold the out edges");
+  }
+  if (with_weights && !opts.is_weighted)
+  {
+    throw GraphException("Weighted CSR snapshot of an unweighted graph");
+  }
+  auto start_time = std::chrono::steady_clock::now();
+  std::string checkpoint =
+      checkpoint_name.empty() ? make_checkpoint() : checkpoint_name;
+  if (node_ranges.empty()) calculate_thread_offsets();
+
+  GraphBase *graph_stats = create_ro_graph_handle(checkpoint);
+  node_id_t num_nodes = graph_stats->get_max_node_id() + 1;
+  graph_stats->close(false);
+  delete graph_stats;
+
+  int num_parts = get_num_partitions();
+  // offsets[id + 1] holds the degree of id until the prefix sum below
+  std::vector<uint64_t> offsets(num_nodes + 1, 0);
+  std::vector<std::vector<node_id_t>> part_nbrs(num_parts);
+  std::vector<std::vector<edgeweight_t>> part_weights(num_parts);
+  std::vector<key_range> part_ranges(num_parts);
+  bool sorted = true;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads) \
+    reduction(&& : sorted)
+  for (int i = 0; i < num_parts; i++)
+  {
+    // Stretch the outer ranges in case nodes were added since the offsets
+    // were calculated
+    key_range range = get_key_range(i);
+    if (i == 0) range.start = 0;
+    if (i == num_parts - 1) range.end = OutOfBand_ID_MAX;
+    part_ranges[i] = range;
+
+    GraphBase *graph = create_ro_graph_handle(checkpoint);
+    if (with_weights)
+    {
+      EdgeCursor *e_cur = graph->get_edge_iter();
+      e_cur->set_key_range(
+          edge_range(key_pair(range.start, 0),
+                     key_pair(range.end, OutOfBand_ID_MAX)));
+      edge found;
+      e_cur->next(&found);
+      while (found.src_id != OutOfBand_ID_MAX && found.src_id < num_nodes)
+      {
+        offsets[found.src_id + 1]++;
+        part_nbrs[i].push_back(found.dst_id);
+        part_weights[i].push_back(found.edge_weight);
+        e_cur->next(&found);
+      }
+      e_cur->close();
+      delete e_cur;
+    }
+    else if (direction == CSRDirection::OutEdges)
+    {
+      OutCursor *cursor = graph->get_outnbd_iter();
+      cursor->set_key_range(range);
+      sorted = sorted && cursor->is_sorted();
+      adjlist_view found;
+      cursor->next_view(&found);
+      while (found.node_id != OutOfBand_ID_MAX && found.node_id < num_nodes)
+      {
+        offsets[found.node_id + 1] = found.degree;
+        part_nbrs[i].insert(
+            part_nbrs[i].end(), found.edgelist.begin(), found.edgelist.end());
+        cursor->next_view(&found);
+      }
+      cursor->close();
+      delete cursor;
+    }
+    else
+    {
+      InCursor *cursor = graph->get_innbd_iter();
+      cursor->set_key_range(range);
+      sorted = sorted && cursor->is_sorted();
+      adjlist_view found;
+      cursor->next_view(&found);
+      while (found.node_id != OutOfBand_ID_MAX && found.node_id < num_nodes)
+      {
+        offsets[found.node_id + 1] = found.degree;
+        part_nbrs[i].insert(
+            part_nbrs[i].end(), found.edgelist.begin(), found.edgelist.end());
+        cursor->next_view(&found);
+      }
+      cursor->close();
+      delete cursor;
+    }
+    graph->close(false);
+    delete graph;
+  }
+
+  for (node_id_t n = 0; n < num_nodes; n++) offsets[n + 1] += offsets[n];
+
+  auto *csr = new CSRGraph(
+      direction, num_nodes, offsets[num_nodes], with_weights);
+  std::memcpy(
+      csr->offsets, offsets.data(), (num_nodes + 1) * sizeof(uint64_t));
+  std::vector<uint64_t>().swap(offsets);
+  csr->sorted = sorted;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+  for (int i = 0; i < num_parts; i++)
+  {
+    // Nodes at the top of the ID space may have been deleted since the
+    // ranges were calculated, leaving ranges past the last node
+    uint64_t begin =
+        csr->offsets[std::min<node_id_t>(part_ranges[i].start, num_nodes)];
+    std::memcpy(csr->nbrs + begin,
+                part_nbrs[i].data(),
+                part_nbrs[i].size() * sizeof(node_id_t));
+    std::vector<node_id_t>().swap(part_nbrs[i]);
+    if (with_weights)
+    {
+      std::memcpy(csr->weights + begin,
+                  part_weights[i].data(),
+                  part_weights[i].size() * sizeof(edgeweight_t));
+      std::vector<edgeweight_t>().swap(part_weights[i]);
+    }
+  }
+
+  csr->set_build_secs(std::chrono::duration<long double>(
+                          std::chrono::steady_clock::now() - start_time)
+                          .count());
+  return csr;
+}
+
 edge_range GraphEngine::get_edge_range(int thread_id)
 {
   edge_range to_return{};
@@ -352,7 +870,36 @@ edge_range GraphEngine::get_edge_range(int thread_id)
   }
   return to_return;
 }
-GraphEngine::GraphEngine() {}//
-// Created by puneet on 27/03/25.
-//
-void GraphEngine::force_metadata_sync() {return;}
+GraphEngine::GraphEngine() {}
+
+/**
+ * @brief Writes the node and edge counts, and the node ID bounds if they are
+ * known, to the metadata table.
+ *
+ * The counts live in per-handle slots outside the data transactions (see
+ * graph_counters.h) and are folded into the totals here. The persisted counts
+ * include every insert and delete whose call returned before this one
+ * started; calls still running may be missed and are picked up by the next
+ * sync. For exact counts, sync once the writers are done, e.g. after an
+ * ingest. Does nothing for read-only engines.
+ */
+void GraphEngine::force_metadata_sync()
+{
+  if (opts.read_only) return;
+  int64_t num_nodes, num_edges;
+  stats->fold(&num_nodes, &num_edges);
+  node_id_t nodes = num_nodes;
+  edge_id_t edges = num_edges;
+  set_engine_metadata(
+      MetadataKey::num_nodes, (const char *)&nodes, sizeof(node_id_t));
+  set_engine_metadata(
+      MetadataKey::num_edges, (const char *)&edges, sizeof(edge_id_t));
+  node_id_t min_id, max_id;
+  if (stats->node_bounds(&min_id, &max_id))
+  {
+    set_engine_metadata(
+        MetadataKey::min_node_id, (const char *)&min_id, sizeof(node_id_t));
+    set_engine_metadata(
+        MetadataKey::max_node_id, (const char *)&max_id, sizeof(node_id_t));
+  }
+}
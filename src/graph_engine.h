@@ -2,15 +2,28 @@
 #define GRAPH_ENGINE
 
 #include <array>
+#include <memory>
 
 #include "adj_list.h"
 #include "common_util.h"
+#include "csr_graph.h"
 #include "edgekey.h"
 #include "edgekey_split.h"
 #include "graph.h"
 #include "graph_exception.h"
+#include "range_scheduler.h"
 // #include "standard_graph.h"
 
+// Leads every record of the partition_bounds metadata entry, followed by
+// parts + 1 boundary IDs
+struct partition_bounds_header
+{
+  uint32_t parts;
+  edge_id_t num_edges;
+  uint64_t num_nodes;
+  node_id_t max_node_id;
+};
+
 class GraphEngine
 {
  public:
@@ -19,14 +32,22 @@ class GraphEngine
   ~GraphEngine();
   GraphBase *create_graph_handle();
   GraphBase *create_ro_graph_handle(const string &checkpoint_name = "");
+  GraphBase *thread_handle(int tid);
   void create_indices();
-  void calculate_thread_offsets(bool make_edge = false);
+  void calculate_thread_offsets(bool make_edge = false,
+                                int num_partitions = 0);
+  int get_num_partitions() const { return (int)node_ranges.size() - 1; }
   key_range get_key_range(int thread_id);
+  RangeScheduler *create_range_scheduler(int ranges_per_thread = 64);
+  CSRGraph *materialize_csr(CSRDirection direction,
+                            bool with_weights = false,
+                            const std::string &checkpoint_name = "");
   edge_range get_edge_range(int thread_id);
   void close_graph();
   WT_CONNECTION *get_connection();
   std::string make_checkpoint();
   std::string get_last_checkpoint() { return last_checkpoint; }
+  void force_metadata_sync();
 
  protected:
   WT_CONNECTION *conn = nullptr;
@@ -35,18 +56,32 @@ class GraphEngine
   int num_threads{};
   graph_opts opts;
   node_id_t last_node_id{};
+  // One lazily created handle per OpenMP thread, see thread_handle()
+  std::vector<GraphBase *> thread_handles;
+  std::unique_ptr<RangeScheduler> range_scheduler;
+  // Node/edge counts and ID bounds of this DB, shared with every handle
+  std::shared_ptr<GraphCounters> stats;
 
   void check_opts_valid();
   void create_new_graph();
   void open_connection();
   void close_connection();
+  void close_thread_handles();
+  void load_stats();
 
  private:
   std::string last_checkpoint;
-  void force_metadata_sync();
+  // Numbers the checkpoints of this DB, see make_checkpoint()
+  uint64_t checkpoint_seq = 0;
   void _calculate_thread_offsets(int thread_max, GraphBase *graph_stats);
   void _calculate_thread_offsets_fast(int thread_max, GraphBase *graph_stats);
   void _calculate_thread_offsets_edge(int thread_max, GraphBase *graph_stats);
+  void _calculate_thread_offsets_degree(int thread_max,
+                                        GraphBase *graph_stats);
+  bool load_partition_bounds(int thread_max, node_id_t max_node_id);
+  void store_partition_bounds(node_id_t max_node_id);
+  bool get_engine_metadata(int key, std::vector<char> &value);
+  void set_engine_metadata(int key, const char *value, size_t size);
 };
 
 
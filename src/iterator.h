@@ -37,7 +37,8 @@ class table_iterator
   }
   void close()
   {
-    cursor->close(cursor);
+    // Cursors over in-memory snapshots have no WT cursor
+    if (cursor != nullptr) cursor->close(cursor);
     // session->close(session, nullptr);
   }
 };
@@ -48,15 +49,74 @@ class OutCursor : public table_iterator
   key_range keys{};
   // keyrange because out_nbd is defined for a node id range
   node_id_t num_nodes{};
+  bool sorted = false;    // edgelists are returned in ascending ID order
+  bool weighted = false;  // the lists come with their edge weights
 
  public:
   OutCursor() = default;
   ~OutCursor() override = default;
   virtual void set_key_range(key_range _keys) = 0;
   void set_num_nodes(uint32_t num) { num_nodes = num; }
+  // Callers can skip sorting found->edgelist if this is true.
+  [[nodiscard]] bool is_sorted() const { return sorted; }
+  void set_sorted(bool _sorted) { sorted = _sorted; }
+  /**
+   * @brief If this is true, next() fills found->weights, next_view() sets
+   * found->weights and next_batch() fills batch.weights, so callers need not
+   * look the weights up in the edge table.
+   */
+  [[nodiscard]] bool has_weights() const { return weighted; }
+  void set_weighted(bool _weighted) { weighted = _weighted; }
 
   virtual void next(adjlist *found) = 0;
   virtual void next(adjlist *found, node_id_t key) = 0;
+
+  /**
+   * @brief Same as next(), but found->edgelist is a view that is only valid
+   * until the cursor moves again. This default copies into a buffer owned by
+   * the cursor; cursors over contiguous lists point into the WT value.
+   */
+  virtual void next_view(adjlist_view *found)
+  {
+    view_buf.clear();
+    next(&view_buf);
+    found->node_id = view_buf.node_id;
+    found->degree = view_buf.degree;
+    found->edgelist = view_buf.edgelist;
+    found->weights = view_buf.weights;
+  }
+
+  /**
+   * @brief Fills batch with the next adjacency lists, in the order next()
+   * returns them: at most max_nodes lists, and no list is started once the
+   * batch holds max_edges neighbours. A list is never split, so the last one
+   * can take the batch past max_edges. The default goes through next_view().
+   * @return the number of lists in the batch; 0 once the cursor is done
+   */
+  virtual size_t next_batch(adjlist_batch &batch,
+                            size_t max_nodes,
+                            size_t max_edges)
+  {
+    batch.clear();
+    adjlist_view found;
+    while (batch.size() < max_nodes && batch.edges.size() < max_edges)
+    {
+      next_view(&found);
+      if (found.node_id == OutOfBand_ID_MAX) break;
+      batch.edges.insert(
+          batch.edges.end(), found.edgelist.begin(), found.edgelist.end());
+      if (weighted)
+      {
+        batch.weights.insert(
+            batch.weights.end(), found.weights.begin(), found.weights.end());
+      }
+      batch.end_list(found.node_id);
+    }
+    return batch.size();
+  }
+
+ private:
+  adjlist view_buf;  // backs the default next_view()
 };
 
 class InCursor : public table_iterator
@@ -64,6 +124,7 @@ class InCursor : public table_iterator
  protected:
   key_range keys{};
   node_id_t num_nodes{};
+  bool sorted = false;  // edgelists are returned in ascending ID order
 
  public:
   InCursor() = default;
@@ -71,9 +132,29 @@ class InCursor : public table_iterator
   //! DELETE THIS LIKE IN OUTCURSOR
   virtual void set_key_range(key_range _keys) = 0;
   void set_num_nodes(node_id_t num) { num_nodes = num; }
+  // Callers can skip sorting found->edgelist if this is true.
+  [[nodiscard]] bool is_sorted() const { return sorted; }
+  void set_sorted(bool _sorted) { sorted = _sorted; }
 
   virtual void next(adjlist *found) = 0;
   virtual void next(adjlist *found, node_id_t key) = 0;
+
+  /**
+   * @brief Same as next(), but found->edgelist is a view that is only valid
+   * until the cursor moves again. This default copies into a buffer owned by
+   * the cursor; cursors over contiguous lists point into the WT value.
+   */
+  virtual void next_view(adjlist_view *found)
+  {
+    view_buf.clear();
+    next(&view_buf);
+    found->node_id = view_buf.node_id;
+    found->degree = view_buf.degree;
+    found->edgelist = view_buf.edgelist;
+  }
+
+ private:
+  adjlist view_buf;  // backs the default next_view()
 };
 
 class NodeCursor : public table_iterator
@@ -0,0 +1,204 @@
+#ifndef KEY_DECODE_H
+#define KEY_DECODE_H
+
+#include <wiredtiger.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+#include "common_defs.h"
+
+/**
+ * @brief Batch decoding of the "u" keys written by CommonUtil::set_key. Each
+ * key is a node_id_t stored big endian so that WT's bytewise order matches
+ * the numeric order; decoding is a byte swap, plus the MAKE_EKEY offset for
+ * edge-key tables.
+ *
+ * Decoding a buffer of keys at once lets the swap run as a pshufb over 16 or
+ * 32 bytes at a time. The vector paths are compiled in when the target has
+ * SSSE3 or AVX2 (e.g. -march=native); otherwise the scalar loop is used.
+ */
+class KeyDecode
+{
+ public:
+  // Byte swaps n keys in place
+  static void bswap_keys(node_id_t *keys, size_t n)
+  {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i shuf = _mm256_broadcastsi128_si256(swap_mask());
+    for (; i + LANES * 2 <= n; i += LANES * 2)
+    {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(keys + i));
+      _mm256_storeu_si256((__m256i *)(keys + i), _mm256_shuffle_epi8(v, shuf));
+    }
+#endif
+#if defined(__SSSE3__)
+    const __m128i shuf128 = swap_mask();
+    for (; i + LANES <= n; i += LANES)
+    {
+      __m128i v = _mm_loadu_si128((const __m128i *)(keys + i));
+      _mm_storeu_si128((__m128i *)(keys + i), _mm_shuffle_epi8(v, shuf128));
+    }
+#endif
+    for (; i < n; i++) keys[i] = bswap(keys[i]);
+  }
+
+  /**
+   * @brief Decodes n edge-key IDs in place: byte swap, then undo MAKE_EKEY
+   * for every ID except OutOfBand_ID_MIN, which marks a node record.
+   */
+  static void decode_ekeys(node_id_t *keys, size_t n)
+  {
+    bswap_keys(keys, n);
+    size_t i = 0;
+#if defined(__AVX2__)
+    // x - 1 - (x == 0): the compare mask is -1 exactly where x is 0
+    const __m256i one = set1_256(1);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + LANES * 2 <= n; i += LANES * 2)
+    {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(keys + i));
+      __m256i r = sub_256(sub_256(v, one), cmpeq_256(v, zero));
+      _mm256_storeu_si256((__m256i *)(keys + i), r);
+    }
+#endif
+    for (; i < n; i++)
+    {
+      if (keys[i] != OutOfBand_ID_MIN) keys[i] = OG_KEY(keys[i]);
+    }
+  }
+
+ private:
+  static constexpr size_t LANES = 16 / sizeof(node_id_t);
+
+  static node_id_t bswap(node_id_t key)
+  {
+#ifdef B64
+    return __builtin_bswap64(key);
+#else
+    return __builtin_bswap32(key);
+#endif
+  }
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+  // Reverses the bytes within every node_id_t of a 16 byte lane
+  static __m128i swap_mask()
+  {
+#ifdef B64
+    return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+#else
+    return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+#endif
+  }
+#endif
+
+#if defined(__AVX2__)
+#ifdef B64
+  static __m256i set1_256(int64_t x) { return _mm256_set1_epi64x(x); }
+  static __m256i sub_256(__m256i a, __m256i b)
+  {
+    return _mm256_sub_epi64(a, b);
+  }
+  static __m256i cmpeq_256(__m256i a, __m256i b)
+  {
+    return _mm256_cmpeq_epi64(a, b);
+  }
+#else
+  static __m256i set1_256(int32_t x) { return _mm256_set1_epi32(x); }
+  static __m256i sub_256(__m256i a, __m256i b)
+  {
+    return _mm256_sub_epi32(a, b);
+  }
+  static __m256i cmpeq_256(__m256i a, __m256i b)
+  {
+    return _mm256_cmpeq_epi32(a, b);
+  }
+#endif
+#endif
+};
+
+/**
+ * @brief Read-ahead buffer for a scan over an edge-key table keyed on
+ * (src, dst). Instead of a get_key and two byte swaps per record, fill()
+ * copies the raw keys of up to BATCH records into contiguous arrays and
+ * decodes them in one pass; the cursor is then left on the first record that
+ * was not read.
+ *
+ * current() is the record the scan is on, advance() moves to the next one,
+ * so a loop over current()/advance() visits the same records as one over
+ * ekey_get_key()/cursor->next().
+ */
+class EKeyScanBuffer
+{
+ public:
+  static constexpr size_t BATCH = 256;
+
+  EKeyScanBuffer() : srcs(BATCH), dsts(BATCH) {}
+
+  // Drops whatever was buffered; call after repositioning the cursor
+  void clear()
+  {
+    pos = 0;
+    count = 0;
+    cursor_done = false;
+  }
+
+  /**
+   * @brief The record the scan is on. The first call after clear() reads the
+   * record the cursor is positioned on.
+   * @return false if the scan is past the last record
+   */
+  bool current(WT_CURSOR *cursor, node_id_t *src, node_id_t *dst)
+  {
+    if (pos == count && !fill(cursor)) return false;
+    *src = srcs[pos];
+    *dst = dsts[pos];
+    return true;
+  }
+
+  // Moves to the next record and returns it, like cursor->next() == 0
+  bool advance(WT_CURSOR *cursor, node_id_t *src, node_id_t *dst)
+  {
+    if (pos < count) pos++;
+    return current(cursor, src, dst);
+  }
+
+ private:
+  std::vector<node_id_t> srcs;
+  std::vector<node_id_t> dsts;
+  size_t pos = 0;
+  size_t count = 0;
+  bool cursor_done = false;  // the cursor has no record left to read
+
+  bool fill(WT_CURSOR *cursor)
+  {
+    pos = 0;
+    count = 0;
+    while (!cursor_done && count < BATCH)
+    {
+      // The key items point into the cursor and are only valid until it
+      // moves, so the raw bytes are copied first and decoded below
+      WT_ITEM k1, k2;
+      if (cursor->get_key(cursor, &k1, &k2) != 0)
+      {
+        cursor_done = true;
+        break;
+      }
+      std::memcpy(&srcs[count], k1.data, sizeof(node_id_t));
+      std::memcpy(&dsts[count], k2.data, sizeof(node_id_t));
+      count++;
+      cursor_done = cursor->next(cursor) != 0;
+    }
+    KeyDecode::decode_ekeys(srcs.data(), count);
+    KeyDecode::decode_ekeys(dsts.data(), count);
+    return count > 0;
+  }
+};
+
+#endif  // KEY_DECODE_H
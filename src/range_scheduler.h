@@ -0,0 +1,89 @@
+#ifndef RANGE_SCHEDULER_H
+#define RANGE_SCHEDULER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "common_defs.h"
+
+/**
+ * @brief Hands out many small key ranges to a fixed set of threads.
+ *
+ * The ranges are dealt to the threads in contiguous blocks. A thread first
+ * claims ranges from its own block, which keeps its cursor moving forward
+ * through the table, and once that is empty steals single ranges from the
+ * other blocks. Claims are a fetch_add on the block's counter, so no locks
+ * are taken.
+ *
+ * Usage: call reset() before every parallel region, then have every thread
+ * loop on next(omp_get_thread_num(), &range), calling cursor->reset() and
+ * cursor->set_key_range(range) for every range it gets.
+ */
+class RangeScheduler
+{
+ public:
+  RangeScheduler(std::vector<key_range> _ranges, int _num_threads)
+      : ranges(std::move(_ranges)),
+        num_threads(_num_threads),
+        blocks(new block[_num_threads])
+  {
+    reset();
+  }
+
+  /**
+   * @brief Makes all ranges available again. Must not be called while
+   * threads are pulling ranges.
+   */
+  void reset()
+  {
+    size_t per_thread = ranges.size() / num_threads;
+    size_t extra = ranges.size() % num_threads;
+    size_t start = 0;
+    for (int i = 0; i < num_threads; i++)
+    {
+      size_t len = per_thread + ((size_t)i < extra);
+      blocks[i].next.store(start, std::memory_order_relaxed);
+      blocks[i].end = start + len;
+      start += len;
+    }
+  }
+
+  /**
+   * @brief Claims the next range for thread tid.
+   * @return false once every range has been handed out.
+   */
+  bool next(int tid, key_range *range)
+  {
+    for (int i = 0; i < num_threads; i++)
+    {
+      block &b = blocks[(tid + i) % num_threads];
+      if (b.next.load(std::memory_order_relaxed) >= b.end) continue;
+      size_t idx = b.next.fetch_add(1, std::memory_order_relaxed);
+      if (idx < b.end)
+      {
+        *range = ranges[idx];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  [[nodiscard]] size_t size() const { return ranges.size(); }
+  [[nodiscard]] int get_num_threads() const { return num_threads; }
+
+ private:
+  // One block per thread, on its own cache line
+  struct alignas(64) block
+  {
+    std::atomic<size_t> next{0};
+    size_t end = 0;
+  };
+
+  std::vector<key_range> ranges;
+  int num_threads;
+  std::unique_ptr<block[]> blocks;
+};
+
+#endif  // RANGE_SCHEDULER_H
@@ -191,6 +191,37 @@ class StdOutCursor : public OutCursor
     has_next = false;
   }
 
+  // Appends straight to the flat neighbour array of the batch
+  size_t next_batch(adjlist_batch &batch,
+                    size_t max_nodes,
+                    size_t max_edges) override
+  {
+    node_id_t temp_src, temp_dst;
+    batch.clear();
+    while (has_next && batch.size() < max_nodes &&
+           batch.edges.size() < max_edges)
+    {
+      CommonUtil::get_key(cursor, &curr_edge_src, &temp_dst);
+      if (curr_edge_src > keys.end)
+      {
+        has_next = false;
+        break;
+      }
+      batch.edges.push_back(temp_dst);
+
+      bool more;
+      while ((more = cursor->next(cursor) == 0))
+      {
+        CommonUtil::get_key(cursor, &temp_src, &temp_dst);
+        if (temp_src != curr_edge_src) break;
+        batch.edges.push_back(temp_dst);
+      }
+      batch.end_list(curr_edge_src);
+      if (!more) has_next = false;
+    }
+    return batch.size();
+  }
+
   void next(adjlist *found, node_id_t key) override {}
 };
 
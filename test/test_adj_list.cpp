@@ -1,6 +1,11 @@
 #include <cassert>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
 
 #include "common_util.h"
+#include "csr_file.h"
 #include "graph_engine.h"
 #include "graph_exception.h"
 #include "sample_graph.h"
@@ -274,6 +279,14 @@ void test_get_out_nodes(AdjList graph)
   assert(nodes.at(2).id == SampleGraph::node7.id);  // edge(1->7)
   assert(nodes.at(2).id == nodes_id.at(2));
 
+  // for_each_out_neighbor visits the same IDs, and stops on false
+  std::vector<node_id_t> visited;
+  graph.for_each_out_neighbor(1, [&](node_id_t v) { visited.push_back(v); });
+  assert(visited == nodes_id);
+  int seen = 0;
+  graph.for_each_out_neighbor(1, [&](node_id_t) { return ++seen < 2; });
+  assert(seen == 2);
+
   // test for a node that has no out-edge
   nodes = graph.get_out_nodes(test_id2);
   nodes_id = graph.get_out_nodes_id(test_id2);
@@ -319,11 +332,20 @@ void test_get_in_nodes(AdjList graph)
   assert(nodes.at(1).id == SampleGraph::node2.id);
   assert(nodes.at(1).id == nodes_id.at(1));
 
+  std::vector<node_id_t> visited;
+  graph.for_each_in_neighbor(test_id1,
+                             [&](node_id_t v) { visited.push_back(v); });
+  assert(visited == nodes_id);
+
   // test for a node that has no in_edge
   nodes = graph.get_in_nodes(test_id2);
   nodes_id = graph.get_in_nodes_id(test_id2);
   assert(nodes.empty());
   assert(nodes_id.empty());
+  visited.clear();
+  graph.for_each_in_neighbor(test_id2,
+                             [&](node_id_t v) { visited.push_back(v); });
+  assert(visited.empty());
 
   // test for a node that does not exist
   bool assert_fail = false;
@@ -684,6 +706,885 @@ void test_ro_get_nodes(GraphBase *graph)
   }
 }
 
+/**
+ * @brief Points opts at a new, writable, directed DB called name and opens
+ * it. Options the test needs on top of these are set before the call.
+ */
+std::unique_ptr<GraphEngine> make_engine(graph_opts &opts,
+                                         const std::string &name,
+                                         int num_threads = 1)
+{
+  opts.create_new = true;
+  opts.read_only = false;
+  opts.is_directed = true;
+  opts.db_name = name;
+  return std::make_unique<GraphEngine>(num_threads, opts);
+}
+
+void test_chunked_adjlist(graph_opts opts)
+{
+  INFO();
+  // A chunk size of 2 makes node 1's out-list span three chunks.
+  opts.adjlist_layout = AdjListLayout::Chunked;
+  opts.adjlist_chunk_size = 2;
+  auto engine = make_engine(opts, "test_adj_chunked");
+  AdjList graph(opts, engine->get_connection());
+  for (node_id_t dst = 2; dst <= 6; dst++)
+  {
+    edge e;
+    e.src_id = 1;
+    e.dst_id = dst;
+    assert(graph.add_edge(e, false) == 0);
+  }
+  std::vector<node_id_t> expected = {2, 3, 4, 5, 6};
+  assert(graph.get_out_nodes_id(1) == expected);
+  assert(graph.get_out_degree(1) == 5);
+  assert(graph.get_in_nodes_id(4) == std::vector<node_id_t>{1});
+
+  // Remove an ID from the middle chunk, then append to the tail chunk.
+  assert(graph.delete_edge(1, 4) == 0);
+  edge e;
+  e.src_id = 1;
+  e.dst_id = 4;
+  assert(graph.add_edge(e, false) == 0);
+  expected = {2, 3, 5, 6, 4};
+  assert(graph.get_out_nodes_id(1) == expected);
+
+  // The out cursor stitches the chunks back together.
+  OutCursor *out_cursor = graph.get_outnbd_iter();
+  adjlist found;
+  out_cursor->next(&found);
+  assert(found.node_id == 1);
+  assert(found.degree == 5);
+  assert(found.edgelist == expected);
+  out_cursor->next(&found);
+  assert(found.node_id == OutOfBand_ID_MAX);
+  out_cursor->close();
+  delete out_cursor;
+
+  assert(graph.delete_node(1) == 0);
+  assert(graph.get_out_nodes_id(2).empty());
+  graph.close(false);
+  engine->close_graph();
+}
+
+void test_sorted_adjlist(graph_opts opts)
+{
+  INFO();
+  // Out of order inserts must come back sorted, for both layouts. With a chunk
+  // size of 2 the sorted chunks are split on insert.
+  opts.sorted_adjlist = true;
+  opts.adjlist_chunk_size = 2;
+  for (AdjListLayout layout : {AdjListLayout::Blob, AdjListLayout::Chunked})
+  {
+    opts.adjlist_layout = layout;
+    auto engine = make_engine(opts,
+                              layout == AdjListLayout::Blob
+                                  ? "test_adj_sorted_blob"
+                                  : "test_adj_sorted_chunked");
+    AdjList graph(opts, engine->get_connection());
+    for (node_id_t dst : {6, 2, 5, 3, 4})
+    {
+      edge e;
+      e.src_id = 1;
+      e.dst_id = dst;
+      assert(graph.add_edge(e, false) == 0);
+    }
+    std::vector<node_id_t> expected = {2, 3, 4, 5, 6};
+    assert(graph.get_out_nodes_id(1) == expected);
+    assert(graph.has_edge(1, 5));
+    assert(!graph.has_edge(1, 7));
+    assert(!graph.has_edge(2, 1));
+
+    assert(graph.delete_edge(1, 4) == 0);
+    assert(!graph.has_edge(1, 4));
+    expected = {2, 3, 5, 6};
+    assert(graph.get_out_nodes_id(1) == expected);
+
+    OutCursor *out_cursor = graph.get_outnbd_iter();
+    assert(out_cursor->is_sorted());
+    adjlist found;
+    out_cursor->next(&found);
+    assert(found.node_id == 1);
+    assert(found.edgelist == expected);
+    out_cursor->close();
+    delete out_cursor;
+
+    // next_view returns the same list without copying it out
+    out_cursor = graph.get_outnbd_iter();
+    adjlist_view view;
+    out_cursor->next_view(&view);
+    assert(view.node_id == 1);
+    assert(view.degree == expected.size());
+    assert(std::equal(view.edgelist.begin(),
+                      view.edgelist.end(),
+                      expected.begin(),
+                      expected.end()));
+    out_cursor->next_view(&view);
+    assert(view.node_id == OutOfBand_ID_MAX);
+    out_cursor->close();
+    delete out_cursor;
+    graph.close(false);
+    engine->close_graph();
+  }
+}
+
+void test_adjlist_codec(graph_opts opts)
+{
+  INFO();
+  // Round trip through each codec, including gaps that need the widest codes
+  std::vector<node_id_t> ids = {0, 1, 2, 130, 70000, 20000000, 4000000000};
+  for (AdjListCodec codec : {AdjListCodec::Raw,
+                             AdjListCodec::DeltaVarint,
+                             AdjListCodec::BitPacked})
+  {
+    std::vector<uint8_t> buf;
+    WT_ITEM item = AdjCodec::encode(codec, ids, buf);
+    std::vector<node_id_t> decoded;
+    AdjCodec::decode(codec, item, decoded);
+    assert(decoded == ids);
+    if (codec != AdjListCodec::Raw)
+    {
+      assert(item.size < ids.size() * sizeof(node_id_t));
+    }
+  }
+
+  // The graph API is unchanged on top of a compressed codec
+  opts.sorted_adjlist = false;  // implied by the codec
+  opts.adjlist_chunk_size = 2;
+  for (AdjListLayout layout : {AdjListLayout::Blob, AdjListLayout::Chunked})
+  {
+    opts.adjlist_layout = layout;
+    opts.adjlist_codec = layout == AdjListLayout::Blob
+                             ? AdjListCodec::DeltaVarint
+                             : AdjListCodec::BitPacked;
+    auto engine =
+        make_engine(opts, "test_adj_codec_" + std::to_string(layout));
+    AdjList graph(opts, engine->get_connection());
+    for (node_id_t dst : {600, 2, 50000, 3, 4})
+    {
+      edge e;
+      e.src_id = 1;
+      e.dst_id = dst;
+      assert(graph.add_edge(e, false) == 0);
+    }
+    std::vector<node_id_t> expected = {2, 3, 4, 600, 50000};
+    assert(graph.get_out_nodes_id(1) == expected);
+    assert(graph.get_in_nodes_id(50000) == std::vector<node_id_t>{1});
+    assert(graph.has_edge(1, 600));
+    assert(graph.delete_edge(1, 3) == 0);
+    assert(!graph.has_edge(1, 3));
+
+    OutCursor *out_cursor = graph.get_outnbd_iter();
+    adjlist found;
+    out_cursor->next(&found);
+    assert(found.node_id == 1);
+    assert(found.edgelist == (std::vector<node_id_t>{2, 4, 600, 50000}));
+    out_cursor->close();
+    delete out_cursor;
+    graph.close(false);
+    engine->close_graph();
+  }
+}
+
+void test_weighted_adjlist(graph_opts opts)
+{
+  INFO();
+  opts.is_weighted = true;
+  opts.sorted_adjlist = false;
+  opts.adjlist_layout = AdjListLayout::Blob;
+  opts.adjlist_codec = AdjListCodec::Weighted;
+  auto engine = make_engine(opts, "test_adj_weighted");
+  AdjList graph(opts, engine->get_connection());
+  graph.add_edge({.src_id = 1, .dst_id = 5, .edge_weight = 50}, false);
+  graph.add_edge({.src_id = 1, .dst_id = 3, .edge_weight = 30}, false);
+  std::vector<edge> batch_edges = {
+      {.src_id = 1, .dst_id = 4, .edge_weight = 40},
+      {.src_id = 2, .dst_id = 5, .edge_weight = 25}};
+  assert(graph.add_edges(batch_edges) == 0);
+
+  // Weights come out of the adjlist record alongside the IDs
+  std::map<node_id_t, edgeweight_t> expected = {{5, 50}, {3, 30}, {4, 40}};
+  std::vector<edge> out_edges = graph.get_out_edges(1);
+  assert(out_edges.size() == expected.size());
+  for (const edge &e : out_edges)
+  {
+    assert(e.src_id == 1 && expected.at(e.dst_id) == e.edge_weight);
+  }
+  std::vector<edge> in_edges = graph.get_in_edges(5);
+  assert(in_edges.size() == 2);
+  for (const edge &e : in_edges)
+  {
+    assert(e.dst_id == 5 && e.edge_weight == (e.src_id == 1 ? 50 : 25));
+  }
+  size_t visited = 0;
+  graph.for_each_out_edge(1,
+                          [&](node_id_t v, edgeweight_t w)
+                          {
+                            assert(expected.at(v) == w);
+                            visited++;
+                          });
+  assert(visited == expected.size());
+
+  // Deleting an edge keeps the remaining IDs paired with their weights
+  assert(graph.delete_edge(1, 3) == 0);
+  expected.erase(3);
+  graph.update_edge_weight(1, 4, 7);
+  expected[4] = 7;
+  assert(graph.get_edge(1, 4).edge_weight == 7);
+
+  OutCursor *out_cursor = graph.get_outnbd_iter();
+  assert(out_cursor->has_weights());
+  adjlist_view view;
+  out_cursor->next_view(&view);
+  assert(view.node_id == 1);
+  assert(view.edgelist.size() == expected.size());
+  assert(view.weights.size() == expected.size());
+  for (size_t i = 0; i < view.edgelist.size(); i++)
+  {
+    assert(expected.at(view.edgelist[i]) == view.weights[i]);
+  }
+  out_cursor->reset();
+  adjlist_batch batch;
+  out_cursor->next_batch(batch, 8, 64);
+  assert(batch.size() == 2);
+  assert(batch.weights.size() == batch.edges.size());
+  for (size_t i = 0; i < batch.neighbors(0).size(); i++)
+  {
+    assert(expected.at(batch.neighbors(0)[i]) ==
+           batch.neighbor_weights(0)[i]);
+  }
+  assert(batch.neighbor_weights(1).size() == 1 &&
+         batch.neighbor_weights(1)[0] == 25);
+  out_cursor->close();
+  delete out_cursor;
+
+  // Whole adjlists are written with their weights, and refused without them
+  std::vector<node_id_t> ids = {7, 6};
+  std::vector<edgeweight_t> weights = {70, 60};
+  graph.add_adjlist(graph.get_out_adjlist_cursor(), 9, ids, &weights);
+  adjlist written = graph.get_adjlist_record(graph.get_out_adjlist_cursor(), 9);
+  assert(written.edgelist.size() == 2 && written.weights.size() == 2);
+  for (size_t i = 0; i < written.edgelist.size(); i++)
+  {
+    assert(written.weights[i] == (edgeweight_t)(written.edgelist[i] * 10));
+  }
+  try
+  {
+    graph.add_adjlist(graph.get_out_adjlist_cursor(), 10, ids);
+    assert(false);
+  }
+  catch (GraphException &)
+  {
+  }
+  graph.close(false);
+  engine->close_graph();
+}
+
+void test_thread_handles(graph_opts opts)
+{
+  INFO();
+  auto engine = make_engine(opts, "test_adj_thread_handles", 2);
+  GraphBase *graph = engine->create_graph_handle();
+  edge e;
+  e.src_id = 1;
+  e.dst_id = 2;
+  assert(graph->add_edge(e, false) == 0);
+  graph->close(false);
+  delete graph;
+
+  // The same handle comes back on every call, one per thread slot.
+  GraphBase *h0 = engine->thread_handle(0);
+  assert(engine->thread_handle(0) == h0);
+  GraphBase *h1 = engine->thread_handle(1);
+  assert(h1 != h0);
+  assert(h0->get_out_nodes_id(1) == std::vector<node_id_t>{2});
+  assert(h1->get_in_nodes_id(2) == std::vector<node_id_t>{1});
+  try
+  {
+    engine->thread_handle(-1);
+    assert(false);
+  }
+  catch (GraphException &)
+  {
+  }
+  // close_graph() closes the pooled handles with the connection.
+  engine->close_graph();
+}
+
+void test_degree_partitions(graph_opts opts)
+{
+  INFO();
+  // Node 1 points at 2..20, which have no out edges. An equal ID split puts
+  // all edges in the first range; the degree split isolates the hub.
+  opts.partition_mode = PartitionMode::DegreeBalanced;
+  {
+    auto engine = make_engine(opts, "test_adj_partitions", 2);
+    AdjList graph(opts, engine->get_connection());
+    for (node_id_t dst = 2; dst <= 20; dst++)
+    {
+      edge e;
+      e.src_id = 1;
+      e.dst_id = dst;
+      assert(graph.add_edge(e, false) == 0);
+    }
+    graph.close(true);
+
+    engine->calculate_thread_offsets();
+    assert(engine->get_num_partitions() == 2);
+    assert(engine->get_key_range(0).start == 1);
+    assert(engine->get_key_range(0).end == 1);
+    assert(engine->get_key_range(1).start == 2);
+    assert(engine->get_key_range(1).end == 20);
+
+    // More partitions than threads, still covering [1, 20] without gaps
+    engine->calculate_thread_offsets(false, 4);
+    assert(engine->get_num_partitions() == 4);
+    assert(engine->get_key_range(0).start == 1);
+    for (int i = 1; i < 4; i++)
+    {
+      assert(engine->get_key_range(i).start ==
+             engine->get_key_range(i - 1).end + 1);
+    }
+    assert(engine->get_key_range(3).end == 20);
+
+    // The scheduler hands out every range once, thread 1 steals thread 0's
+    // once its own block is empty. The per thread ranges are unchanged.
+    engine->calculate_thread_offsets();
+    RangeScheduler *scheduler = engine->create_range_scheduler(4);
+    assert(engine->get_num_partitions() == 2);
+    std::vector<bool> seen(21, false);
+    key_range range;
+    size_t claimed = 0;
+    while (scheduler->next(1, &range))
+    {
+      for (node_id_t id = range.start; id <= range.end; id++)
+      {
+        assert(!seen[id]);
+        seen[id] = true;
+      }
+      claimed++;
+    }
+    assert(claimed == scheduler->size());
+    for (node_id_t id = 1; id <= 20; id++) assert(seen[id]);
+    scheduler->reset();
+    assert(scheduler->next(0, &range) && range.start == 1);
+    engine->close_graph();
+  }
+
+  // The saved boundaries are picked up on reopen
+  opts.create_new = false;
+  GraphEngine engine(2, opts);
+  engine.calculate_thread_offsets(false, 4);
+  assert(engine.get_num_partitions() == 4);
+  assert(engine.get_key_range(3).end == 20);
+
+  // Every partition count has its own record, so the 8 scheduler ranges did
+  // not replace the 2 per thread ones
+  WT_CONNECTION *conn = engine.get_connection();
+  WT_SESSION *sess;
+  WT_CURSOR *meta;
+  conn->open_session(conn, nullptr, nullptr, &sess);
+  sess->open_cursor(sess, "table:metadata", nullptr, nullptr, &meta);
+  meta->set_key(meta, (int)MetadataKey::partition_bounds);
+  assert(meta->search(meta) == 0);
+  WT_ITEM item;
+  meta->get_value(meta, &item);
+  std::set<uint32_t> counts;
+  for (size_t pos = 0; pos < item.size;)
+  {
+    partition_bounds_header header;
+    std::memcpy(&header, (const char *)item.data + pos, sizeof(header));
+    assert(header.num_edges == 19 && header.max_node_id == 20);
+    counts.insert(header.parts);
+    pos += sizeof(header) + (header.parts + 1) * sizeof(node_id_t);
+  }
+  assert(counts == std::set<uint32_t>({2, 4, 8}));
+  sess->close(sess, nullptr);
+
+  // A node added without edges leaves the edge count as it was, but the
+  // saved boundaries no longer cover it
+  GraphBase *graph = engine.create_graph_handle();
+  node isolated = {.id = 30};
+  assert(graph->add_node(isolated, false) == 0);
+  graph->close(false);
+  delete graph;
+  engine.calculate_thread_offsets(false, 4);
+  assert(engine.get_key_range(3).end == 30);
+  engine.close_graph();
+}
+
+void test_materialize_csr(graph_opts opts)
+{
+  INFO();
+  opts.is_weighted = true;
+  auto engine = make_engine(opts, "test_adj_csr", 2);
+  AdjList graph(opts, engine->get_connection());
+  for (node n : SampleGraph::test_nodes) graph.add_node(n);
+  for (edge e : SampleGraph::test_edges)
+  {
+    e.edge_weight = e.src_id * 10 + e.dst_id;
+    graph.add_edge(e, false);
+  }
+  graph.close(true);
+  engine->calculate_thread_offsets();
+
+  CSRGraph *out_csr = engine->materialize_csr(CSRDirection::OutEdges);
+  CSRGraph *in_csr = engine->materialize_csr(CSRDirection::InEdges);
+  CSRGraph *w_csr = engine->materialize_csr(CSRDirection::OutEdges, true);
+  assert(out_csr->get_num_edges() == SampleGraph::test_edges.size());
+  assert(in_csr->get_num_edges() == SampleGraph::test_edges.size());
+  assert(out_csr->memory_bytes() > 0);
+  assert((uintptr_t)out_csr->get_nbrs() % CSRGraph::ALIGNMENT == 0);
+
+  GraphBase *handle = engine->create_graph_handle();
+  for (node n : SampleGraph::test_nodes)
+  {
+    std::vector<node_id_t> out = handle->get_out_nodes_id(n.id);
+    std::span<const node_id_t> csr_out = out_csr->get_neighbors(n.id);
+    assert(std::vector<node_id_t>(csr_out.begin(), csr_out.end()) == out);
+    std::vector<node_id_t> in = handle->get_in_nodes_id(n.id);
+    std::span<const node_id_t> csr_in = in_csr->get_neighbors(n.id);
+    assert(std::vector<node_id_t>(csr_in.begin(), csr_in.end()) == in);
+
+    // The weighted rows come from the edge table, in dst order
+    std::span<const node_id_t> w_out = w_csr->get_neighbors(n.id);
+    std::span<const edgeweight_t> weights = w_csr->get_weights(n.id);
+    assert(w_out.size() == out.size());
+    for (size_t i = 0; i < w_out.size(); i++)
+    {
+      assert(i == 0 || w_out[i - 1] < w_out[i]);
+      assert(weights[i] == (edgeweight_t)(n.id * 10 + w_out[i]));
+    }
+  }
+  handle->close(false);
+  delete handle;
+
+  // The CSR cursors walk the same lists as the WT cursors
+  OutCursor *cursor = out_csr->get_outnbd_iter();
+  cursor->set_key_range({2, 7});
+  adjlist found;
+  cursor->next(&found);
+  assert(found.node_id == 2);
+  assert(found.edgelist == std::vector<node_id_t>{3});
+  cursor->next(&found);
+  assert(found.node_id == 7);
+  cursor->next(&found);
+  assert(found.node_id == OutOfBand_ID_MAX);
+  cursor->reset();
+  adjlist_view view;
+  cursor->next_view(&view);
+  assert(view.node_id == 2 && view.degree == 1);
+  assert(!cursor->has_weights() && view.weights.empty());
+  cursor->close();
+  delete cursor;
+
+  // A weighted snapshot hands out its weights through all three paths
+  cursor = w_csr->get_outnbd_iter();
+  assert(cursor->has_weights());
+  cursor->next(&found);
+  while (found.node_id != OutOfBand_ID_MAX)
+  {
+    assert(found.weights.size() == found.edgelist.size());
+    for (size_t i = 0; i < found.edgelist.size(); i++)
+    {
+      assert(found.weights[i] ==
+             (edgeweight_t)(found.node_id * 10 + found.edgelist[i]));
+    }
+    cursor->next(&found);
+  }
+  cursor->reset();
+  cursor->next_view(&view);
+  assert(view.weights.size() == view.edgelist.size());
+  assert(view.weights[0] ==
+         (edgeweight_t)(view.node_id * 10 + view.edgelist[0]));
+  cursor->reset();
+  adjlist_batch batch;
+  assert(cursor->next_batch(batch, 64, 1024) > 0);
+  assert(batch.weights.size() == batch.edges.size());
+  for (size_t n = 0; n < batch.size(); n++)
+  {
+    for (size_t i = 0; i < batch.neighbors(n).size(); i++)
+    {
+      assert(batch.neighbor_weights(n)[i] ==
+             (edgeweight_t)(batch.node_ids[n] * 10 + batch.neighbors(n)[i]));
+    }
+  }
+  cursor->close();
+  delete cursor;
+  try
+  {
+    out_csr->get_innbd_iter();
+    assert(false);
+  }
+  catch (GraphException &)
+  {
+  }
+
+  delete out_csr;
+  delete in_csr;
+  delete w_csr;
+  engine->close_graph();
+}
+
+void test_materialize_csr_deleted_tail(graph_opts opts)
+{
+  INFO();
+  opts.is_weighted = false;
+  auto engine = make_engine(opts, "test_adj_csr_tail", 2);
+  AdjList graph(opts, engine->get_connection());
+  for (node_id_t id = 1; id < 20; id++)
+  {
+    graph.add_edge({.src_id = id, .dst_id = id + 1}, false);
+  }
+  engine->calculate_thread_offsets(false, 4);
+
+  // Only the weighted graphs have weights to copy
+  try
+  {
+    delete engine->materialize_csr(CSRDirection::OutEdges, true);
+    assert(false);
+  }
+  catch (GraphException &)
+  {
+  }
+
+  // The last ranges now start past the largest node ID
+  for (node_id_t id = 11; id <= 20; id++) graph.delete_node(id);
+  graph.close(true);
+  CSRGraph *csr = engine->materialize_csr(CSRDirection::OutEdges);
+  assert(csr->get_num_edges() == 9);
+  for (node_id_t id = 1; id < 10; id++)
+  {
+    std::span<const node_id_t> nbrs = csr->get_neighbors(id);
+    assert(nbrs.size() == 1 && nbrs[0] == id + 1);
+  }
+  assert(csr->get_neighbors(10).empty());
+  delete csr;
+  engine->close_graph();
+}
+
+void test_add_edges(graph_opts opts)
+{
+  INFO();
+  opts.read_optimize = true;
+  auto engine = make_engine(opts, "test_adj_batch");
+  AdjList graph(opts, engine->get_connection());
+
+  // Unsorted, and split over several transactions
+  std::vector<edge> batch(SampleGraph::test_edges.rbegin(),
+                          SampleGraph::test_edges.rend());
+  assert(graph.get_num_edges() == 0);
+  assert(graph.add_edges(batch, nullptr, 4) == 0);
+  assert(graph.get_num_edges() == batch.size());
+  for (node_id_t id : {1, 2, 3, 7, 8})
+  {
+    std::vector<node_id_t> out, in;
+    for (edge e : SampleGraph::test_edges)
+    {
+      if (e.src_id == id) out.push_back(e.dst_id);
+      if (e.dst_id == id) in.push_back(e.src_id);
+    }
+    std::vector<node_id_t> found_out = graph.get_out_nodes_id(id);
+    std::vector<node_id_t> found_in = graph.get_in_nodes_id(id);
+    std::sort(found_out.begin(), found_out.end());
+    std::sort(found_in.begin(), found_in.end());
+    assert(found_out == out);
+    assert(found_in == in);
+    assert(graph.get_out_degree(id) == out.size());
+    assert(graph.get_in_degree(id) == in.size());
+  }
+
+  // A duplicate edge only fails itself
+  std::vector<edge> failed;
+  edge new_edge = {.src_id = 2, .dst_id = 8};
+  std::vector<edge> second = {SampleGraph::edge1, new_edge};
+  assert(graph.add_edges(second, &failed) == WT_DUPLICATE_KEY);
+  assert(failed.size() == 1 && failed[0].src_id == 1 && failed[0].dst_id == 2);
+  assert(graph.has_edge(2, 8));
+  assert(graph.get_out_degree(2) == 2);
+  node_id_t num_nodes = graph.get_num_nodes();
+  edge_id_t num_edges = graph.get_num_edges();
+  assert(num_edges == batch.size() + 1);
+  graph.close(false);
+  engine->force_metadata_sync();
+  engine->close_graph();
+
+  // A new engine on the same DB starts from the synced counts
+  opts.create_new = false;
+  GraphEngine reopened_engine(1, opts);
+  AdjList reopened(opts, reopened_engine.get_connection());
+  assert(reopened.get_num_nodes() == num_nodes);
+  assert(reopened.get_num_edges() == num_edges);
+  reopened.close(false);
+  reopened_engine.close_graph();
+}
+
+void test_next_batch(graph_opts opts)
+{
+  INFO();
+  opts.read_optimize = true;
+  opts.adjlist_chunk_size = 2;
+  // Node i has i % 5 out edges, so some lists are empty and get skipped
+  std::vector<edge> edges;
+  for (node_id_t src = 1; src <= 60; src++)
+  {
+    for (node_id_t k = 1; k <= src % 5; k++)
+    {
+      edges.push_back({.src_id = src, .dst_id = 100 + k});
+    }
+  }
+  for (AdjListCodec codec : {AdjListCodec::Raw, AdjListCodec::DeltaVarint})
+  {
+    for (AdjListLayout layout : {AdjListLayout::Blob, AdjListLayout::Chunked})
+    {
+      opts.adjlist_codec = codec;
+      opts.adjlist_layout = layout;
+      auto engine = make_engine(opts,
+                                "test_adj_next_batch_" +
+                                    std::to_string(layout) + "_" +
+                                    std::to_string((int)codec));
+      AdjList graph(opts, engine->get_connection());
+      assert(graph.add_edges(edges) == 0);
+
+      // The batches hold the same lists as next(), within the limits
+      OutCursor *list_cursor = graph.get_outnbd_iter();
+      OutCursor *batch_cursor = graph.get_outnbd_iter();
+      list_cursor->set_key_range({5, 50});
+      batch_cursor->set_key_range({5, 50});
+      adjlist found;
+      adjlist_batch batch;
+      size_t lists = 0;
+      while (batch_cursor->next_batch(batch, 7, 10) != 0)
+      {
+        assert(batch.size() <= 7);
+        assert(batch.offsets[batch.size() - 1] < 10);
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+          list_cursor->next(&found);
+          assert(found.node_id == batch.node_ids[i]);
+          assert(std::equal(found.edgelist.begin(),
+                            found.edgelist.end(),
+                            batch.neighbors(i).begin(),
+                            batch.neighbors(i).end()));
+          lists++;
+        }
+      }
+      list_cursor->next(&found);
+      assert(found.node_id == OutOfBand_ID_MAX);
+      assert(lists == 36);  // 46 IDs in range, 10 of them without edges
+      list_cursor->close();
+      batch_cursor->close();
+      delete list_cursor;
+      delete batch_cursor;
+      graph.close(false);
+      engine->close_graph();
+    }
+  }
+}
+
+void test_out_nodes_multi(graph_opts opts)
+{
+  INFO();
+  opts.read_optimize = true;
+  opts.adjlist_codec = AdjListCodec::Raw;
+  opts.adjlist_chunk_size = 2;
+  std::vector<edge> edges;
+  for (node_id_t src = 1; src <= 40; src++)
+  {
+    for (node_id_t k = 1; k <= src % 4; k++)
+    {
+      edges.push_back({.src_id = src, .dst_id = 100 + k});
+    }
+  }
+  for (AdjListLayout layout : {AdjListLayout::Blob, AdjListLayout::Chunked})
+  {
+    opts.adjlist_layout = layout;
+    auto engine =
+        make_engine(opts, "test_adj_multi_" + std::to_string(layout));
+    AdjList graph(opts, engine->get_connection());
+    assert(graph.add_edges(edges) == 0);
+
+    // Unsorted, with duplicates and runs of consecutive IDs
+    std::vector<node_id_t> ids = {30, 3, 7, 5, 6, 3, 101, 39, 29, 31, 1};
+    std::vector<node_id_t> visited;
+    std::vector<std::vector<node_id_t>> lists;
+    graph.get_out_nodes_multi(
+        ids,
+        [&](node_id_t u, std::span<const node_id_t> nbrs)
+        {
+          visited.push_back(u);
+          lists.emplace_back(nbrs.begin(), nbrs.end());
+        });
+    for (size_t i = 0; i < visited.size(); i++)
+    {
+      assert(lists[i] == graph.get_out_nodes_id(visited[i]));
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    assert(visited == ids);
+
+    // Returning false stops the walk
+    visited.clear();
+    graph.get_out_nodes_multi(ids,
+                              [&](node_id_t u, std::span<const node_id_t>)
+                              {
+                                visited.push_back(u);
+                                return visited.size() < 3;
+                              });
+    assert(visited.size() == 3);
+    graph.close(false);
+    engine->close_graph();
+  }
+}
+
+void test_graph_stats(graph_opts opts)
+{
+  INFO();
+  opts.read_optimize = true;
+  auto engine_a = make_engine(opts, "test_adj_stats_a");
+  AdjList graph_a(opts, engine_a->get_connection());
+  auto engine_b = make_engine(opts, "test_adj_stats_b");
+  AdjList graph_b(opts, engine_b->get_connection());
+
+  // Two graphs open side by side keep their own counts and bounds
+  for (edge e : SampleGraph::test_edges)
+  {
+    assert(graph_a.add_edge(e, false) == 0);
+  }
+  edge far_edge = {.src_id = 50, .dst_id = 100};
+  assert(graph_b.add_edge(far_edge, false) == 0);
+  assert(graph_a.get_num_edges() == SampleGraph::test_edges.size());
+  assert(graph_b.get_num_edges() == 1);
+  assert(graph_b.get_num_nodes() == 2);
+  assert(graph_b.get_min_node_id() == 50);
+  assert(graph_b.get_max_node_id() == 100);
+
+  // A second handle on a DB shares its counts
+  AdjList graph_a2(opts, engine_a->get_connection());
+  node new_node = {.id = 200};
+  assert(graph_a2.add_node(new_node, false) == 0);
+  assert(graph_a.get_num_nodes() == graph_a2.get_num_nodes());
+  assert(graph_a.get_max_node_id() == 200);
+
+  // Deleting the node on the bound falls back to the table
+  assert(graph_a2.delete_node(200) == 0);
+  node_id_t max_id = 0;
+  for (edge e : SampleGraph::test_edges)
+  {
+    max_id = std::max({max_id, e.src_id, e.dst_id});
+  }
+  assert(graph_a.get_max_node_id() == max_id);
+  assert(graph_b.get_max_node_id() == 100);
+
+  graph_a2.close(false);
+  graph_a.close(false);
+  graph_b.close(false);
+  engine_a->close_graph();
+  engine_b->close_graph();
+}
+
+void test_csr_file(graph_opts opts)
+{
+  INFO();
+  opts.is_weighted = true;
+  auto engine = make_engine(opts, "test_adj_csr_file", 2);
+  AdjList graph(opts, engine->get_connection());
+  for (node n : SampleGraph::test_nodes) graph.add_node(n);
+  for (edge e : SampleGraph::test_edges)
+  {
+    e.edge_weight = e.src_id * 10 + e.dst_id;
+    graph.add_edge(e, false);
+  }
+  graph.close(true);
+  engine->calculate_thread_offsets();
+
+  CSRGraph *csr = engine->materialize_csr(CSRDirection::OutEdges, true);
+  std::string checkpoint = engine->get_last_checkpoint();
+  std::string path =
+      CSRFile::sidecar_path(opts.db_dir, opts.db_name, CSRDirection::OutEdges);
+  CSRFile::write(path, *csr, checkpoint, true);
+  assert(CSRFile::read_checkpoint(path) == checkpoint);
+
+  CSRGraph *mapped = CSRFile::open(path, checkpoint);
+  assert(mapped->get_direction() == CSRDirection::OutEdges);
+  assert(mapped->get_num_nodes() == csr->get_num_nodes());
+  assert(mapped->get_num_edges() == csr->get_num_edges());
+  assert(mapped->is_weighted() && mapped->has_opposite_degrees());
+  assert((uintptr_t)mapped->get_nbrs() % CSRGraph::ALIGNMENT == 0);
+  GraphBase *handle = engine->create_graph_handle();
+  for (node n : SampleGraph::test_nodes)
+  {
+    std::span<const node_id_t> a = csr->get_neighbors(n.id);
+    std::span<const node_id_t> b = mapped->get_neighbors(n.id);
+    assert(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    std::span<const edgeweight_t> wa = csr->get_weights(n.id);
+    std::span<const edgeweight_t> wb = mapped->get_weights(n.id);
+    assert(std::equal(wa.begin(), wa.end(), wb.begin(), wb.end()));
+    assert(mapped->get_opposite_degree(n.id) ==
+           handle->get_in_nodes_id(n.id).size());
+  }
+  handle->close(false);
+  delete handle;
+  delete mapped;
+
+  // A file stamped with another checkpoint is stale
+  try
+  {
+    CSRFile::open(path, checkpoint + "_old");
+    assert(false);
+  }
+  catch (GraphException &)
+  {
+  }
+
+  // Checkpoints taken within the same second still have different names, so
+  // the sidecar goes stale and is materialized and written again
+  std::string next = engine->make_checkpoint();
+  assert(next != checkpoint);
+  CSRGraph *loaded = CSRFile::open_or_materialize(
+      *engine, opts.db_dir, opts.db_name, CSRDirection::OutEdges);
+  assert(loaded->get_num_edges() == csr->get_num_edges());
+  assert(CSRFile::read_checkpoint(path) == engine->get_last_checkpoint());
+  delete loaded;
+  // A current sidecar is mapped without taking another checkpoint
+  checkpoint = engine->get_last_checkpoint();
+  loaded = CSRFile::open_or_materialize(
+      *engine, opts.db_dir, opts.db_name, CSRDirection::OutEdges);
+  assert(loaded->has_opposite_degrees());
+  assert(engine->get_last_checkpoint() == checkpoint);
+  delete loaded;
+
+  delete csr;
+  engine->close_graph();
+
+  // A graph without edges has empty neighbour and weight sections
+  auto empty_engine = make_engine(opts, "test_adj_csr_file_empty", 2);
+  AdjList empty_graph(opts, empty_engine->get_connection());
+  for (node n : SampleGraph::test_nodes) empty_graph.add_node(n);
+  empty_graph.close(true);
+  empty_engine->calculate_thread_offsets();
+
+  csr = empty_engine->materialize_csr(CSRDirection::OutEdges, true);
+  assert(csr->get_num_edges() == 0);
+  checkpoint = empty_engine->get_last_checkpoint();
+  path =
+      CSRFile::sidecar_path(opts.db_dir, opts.db_name, CSRDirection::OutEdges);
+  CSRFile::write(path, *csr, checkpoint, true);
+  mapped = CSRFile::open(path, checkpoint);
+  assert(mapped->get_num_nodes() == csr->get_num_nodes());
+  assert(mapped->get_num_edges() == 0);
+  assert(mapped->is_weighted() && mapped->has_opposite_degrees());
+  for (node n : SampleGraph::test_nodes)
+  {
+    assert(mapped->get_neighbors(n.id).empty());
+    assert(mapped->get_opposite_degree(n.id) == 0);
+  }
+  delete mapped;
+  delete csr;
+  empty_engine->close_graph();
+}
+
 int main()
 {
   const int THREAD_NUM = 1;
@@ -744,4 +1645,18 @@ int main()
   test_ro_get_nodes(rograph);
   rograph->close(false);
   roEngine.close_graph();
+
+  test_chunked_adjlist(opts);
+  test_sorted_adjlist(opts);
+  test_adjlist_codec(opts);
+  test_weighted_adjlist(opts);
+  test_thread_handles(opts);
+  test_degree_partitions(opts);
+  test_materialize_csr(opts);
+  test_materialize_csr_deleted_tail(opts);
+  test_csr_file(opts);
+  test_add_edges(opts);
+  test_graph_stats(opts);
+  test_next_batch(opts);
+  test_out_nodes_multi(opts);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "common_util.h"
 #include "graph_engine.h"
 #include "graph_exception.h"
+#include "key_decode.h"
 #include "sample_graph.h"
 
 #define delim "--------------"
@@ -194,6 +195,14 @@ void test_get_out_nodes(SplitEdgeKey &graph)
   assert(nodes.at(1).id == nodes_id.at(1));
   assert(nodes.at(2).id == SampleGraph::node7.id);  // edge(1->7)
   assert(nodes.at(2).id == nodes_id.at(2));
+
+  // for_each_out_neighbor visits the same IDs, and stops on false
+  std::vector<node_id_t> visited;
+  graph.for_each_out_neighbor(1, [&](node_id_t v) { visited.push_back(v); });
+  assert(visited == nodes_id);
+  int seen = 0;
+  graph.for_each_out_neighbor(1, [&](node_id_t) { return ++seen < 2; });
+  assert(seen == 2);
   // test for a node that has no out-edge
   nodes = graph.get_out_nodes(4);
   nodes_id = graph.get_out_nodes_id(4);
@@ -262,11 +271,20 @@ void test_get_in_nodes(SplitEdgeKey &graph)
   assert(nodes.at(1).id == SampleGraph::node2.id);
   assert(nodes.at(1).id == nodes_id.at(1));
 
+  std::vector<node_id_t> visited;
+  graph.for_each_in_neighbor(test_id1,
+                             [&](node_id_t v) { visited.push_back(v); });
+  assert(visited == nodes_id);
+
   // test for a node that has no in_edge
   nodes = graph.get_in_nodes(test_id2);
   nodes_id = graph.get_in_nodes_id(test_id2);
   assert(nodes.empty());
   assert(nodes_id.empty());
+  visited.clear();
+  graph.for_each_in_neighbor(test_id2,
+                             [&](node_id_t v) { visited.push_back(v); });
+  assert(visited.empty());
 
   // test for a node that does not exist
   bool assert_fail = false;
@@ -544,6 +562,160 @@ void test_InCursor(SplitEdgeKey &graph)
   delete in_cursor;
 }
 
+void test_degree_table(graph_opts opts)
+{
+  INFO()
+  opts.create_new = true;
+  opts.read_only = false;
+  opts.is_directed = true;
+  opts.read_optimize = true;
+  opts.degree_table = true;
+  opts.db_name = "test_split_degrees";
+  GraphEngine engine(1, opts);
+  SplitEdgeKey graph(opts, engine.get_connection());
+  graph.add_node(SampleGraph::node4);
+  for (edge e : SampleGraph::test_edges) graph.add_edge(e, false);
+  edge batched[] = {{.src_id = 2, .dst_id = 8}, {.src_id = 9, .dst_id = 1}};
+  assert(graph.add_edges(batched) == 0);
+
+  // The degree table agrees with the node records, absent IDs read as 0
+  auto check_degrees = [&]()
+  {
+    std::vector<degree_t> out(12, 7), in(12, 7);
+    graph.get_degrees({0, OutOfBand_ID_MAX}, out, in);
+    for (node_id_t id = 0; id < out.size(); id++)
+    {
+      node found = graph.get_node(id);
+      assert(out[id] == found.out_degree && in[id] == found.in_degree);
+      if (found.id == id && id != 0)
+      {
+        assert(graph.get_out_degree(id) == found.out_degree);
+        assert(graph.get_in_degree(id) == found.in_degree);
+      }
+    }
+    return out;
+  };
+  std::vector<degree_t> out = check_degrees();
+  assert(out[1] == 3 && out[2] == 2 && out[4] == 0 && out[9] == 1);
+
+  // A sub range lands at the start of the array
+  std::vector<degree_t> sub(2);
+  graph.get_degrees({7, 8}, sub);
+  assert(sub[0] == 1 && sub[1] == 1);
+
+  assert(graph.delete_edge(1, 3) == 0);
+  assert(graph.delete_node(8) == 0);
+  out = check_degrees();
+  assert(out[1] == 2 && out[8] == 0 && out[7] == 0);
+  graph.close(false);
+  engine.close_graph();
+}
+
+void test_key_decode()
+{
+  INFO()
+  // Long enough to go through the vector loops and the scalar tail
+  std::vector<node_id_t> keys, expected;
+  for (node_id_t i = 0; i < 67; i++)
+  {
+    node_id_t id = (i % 5 == 0) ? OutOfBand_ID_MIN : MAKE_EKEY(i * 7919);
+#ifdef B64
+    keys.push_back(__builtin_bswap64(id));
+#else
+    keys.push_back(__builtin_bswap32(id));
+#endif
+    expected.push_back(id == OutOfBand_ID_MIN ? id : OG_KEY(id));
+  }
+  KeyDecode::decode_ekeys(keys.data(), keys.size());
+  assert(keys == expected);
+}
+
+// Out lists longer than EKeyScanBuffer::BATCH are split across refills
+void test_out_scan_batches(graph_opts opts)
+{
+  INFO()
+  opts.create_new = true;
+  opts.read_only = false;
+  opts.is_directed = true;
+  opts.degree_table = false;
+  opts.db_name = "test_split_scan";
+  GraphEngine engine(1, opts);
+  SplitEdgeKey graph(opts, engine.get_connection());
+  const node_id_t num_nodes = 700;
+  std::vector<edge> edges;
+  for (node_id_t dst = 2; dst <= num_nodes; dst++)
+  {
+    edges.push_back({.src_id = 1, .dst_id = dst});
+  }
+  for (node_id_t src = 2; src < num_nodes; src += 3)
+  {
+    edges.push_back({.src_id = src, .dst_id = src + 1});
+  }
+  assert(graph.add_edges(edges) == 0);
+
+  auto check_range = [&](key_range keys)
+  {
+    OutCursor *out_cursor = graph.get_outnbd_iter();
+    out_cursor->set_key_range(keys);
+    adjlist found;
+    node_id_t last = OutOfBand_ID_MIN;
+    size_t lists = 0;
+    out_cursor->next(&found);
+    while (found.node_id != OutOfBand_ID_MAX)
+    {
+      assert(found.node_id > last && found.node_id >= keys.start);
+      assert(found.edgelist == graph.get_out_nodes_id(found.node_id));
+      last = found.node_id;
+      lists++;
+      found.clear();
+      out_cursor->next(&found);
+    }
+    delete out_cursor;
+    return lists;
+  };
+  assert(check_range({OutOfBand_ID_MIN, OutOfBand_ID_MAX}) == 1 + 233);
+  check_range({300, 400});
+
+  // next_batch() returns the same lists; node 1 alone passes max_edges
+  OutCursor *batch_cursor = graph.get_outnbd_iter();
+  adjlist_batch batch;
+  assert(batch_cursor->next_batch(batch, 100, 64) == 1);
+  assert(batch.node_ids[0] == 1 && batch.edges.size() == num_nodes - 1);
+  node_id_t src = 2;
+  while (batch_cursor->next_batch(batch, 100, 64) != 0)
+  {
+    assert(batch.size() <= 64);
+    for (size_t i = 0; i < batch.size(); i++, src += 3)
+    {
+      std::span<const node_id_t> nbrs = batch.neighbors(i);
+      assert(batch.node_ids[i] == src);
+      assert(nbrs.size() == 1 && nbrs[0] == src + 1);
+    }
+  }
+  assert(src == 701);
+  delete batch_cursor;
+
+  // The multi-get walks the lists in key order
+  std::vector<node_id_t> ids = {698, 1, 5, 4, 2, 3, 350};
+  std::vector<node_id_t> visited;
+  std::vector<std::vector<node_id_t>> lists;
+  graph.get_out_nodes_multi(
+      ids,
+      [&](node_id_t u, std::span<const node_id_t> nbrs)
+      {
+        visited.push_back(u);
+        lists.emplace_back(nbrs.begin(), nbrs.end());
+      });
+  for (size_t i = 0; i < visited.size(); i++)
+  {
+    assert(lists[i] == graph.get_out_nodes_id(visited[i]));
+  }
+  std::sort(ids.begin(), ids.end());
+  assert(visited == ids);
+  graph.close(false);
+  engine.close_graph();
+}
+
 void tearDown(SplitEdgeKey &graph) { graph.close(true); }
 
 void test_ro_get_nodes(GraphBase *graph)
@@ -629,4 +801,8 @@ int main()
   test_ro_get_nodes(rograph);
   rograph->close(false);
   roEngine.close_graph();
+
+  test_degree_table(opts);
+  test_key_decode();
+  test_out_scan_batches(opts);
 }
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <set>
+
+#include "common_util.h"
+#include "graph_engine.h"
+#include "graph_exception.h"
+#include "sssp.h"
+
+#define delim "--------------"
+#define INFO() fprintf(stderr, "%s\nNow running: %s\n", delim, __FUNCTION__);
+
+const int THREAD_NUM = 4;
+const node_id_t SOURCE = 1;
+// The source fans out to this many nodes, so the second round of
+// delta-stepping has a frontier of at least kMultiGetFrontier
+const node_id_t FAN_OUT = kMultiGetFrontier + 1000;
+const node_id_t NUM_NODES = FAN_OUT + 2000;
+const size_t NUM_RANDOM_EDGES = 4 * NUM_NODES;
+
+// A directed graph with random weights in [1, 64] and no duplicate edges
+std::vector<edge> make_edges()
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<node_id_t> pick_node(1, NUM_NODES);
+  std::uniform_int_distribution<edgeweight_t> pick_weight(1, 64);
+  std::set<std::pair<node_id_t, node_id_t>> seen;
+  std::vector<edge> edges;
+  for (node_id_t dst = 2; dst <= FAN_OUT + 1; dst++)
+  {
+    seen.insert({SOURCE, dst});
+    edges.push_back(
+        {.src_id = SOURCE, .dst_id = dst, .edge_weight = pick_weight(gen)});
+  }
+  while (edges.size() < FAN_OUT + NUM_RANDOM_EDGES)
+  {
+    node_id_t src = pick_node(gen);
+    node_id_t dst = pick_node(gen);
+    if (src == dst || !seen.insert({src, dst}).second) continue;
+    edges.push_back(
+        {.src_id = src, .dst_id = dst, .edge_weight = pick_weight(gen)});
+  }
+  return edges;
+}
+
+void test_delta_step(graph_opts opts, GraphType type)
+{
+  INFO()
+  opts.type = type;
+  opts.db_name = "test_sssp_" + std::to_string(type);
+  GraphEngine engine(THREAD_NUM, opts);
+  GraphBase *graph = engine.create_graph_handle();
+  assert(graph->add_edges(make_edges()) == 0);
+  // Unreachable from the source
+  graph->add_edge({.src_id = NUM_NODES + 1, .dst_id = 2, .edge_weight = 1},
+                  false);
+
+  node_id_t num_ids = graph->get_max_node_id() + 1;
+  edge_id_t num_edges = graph->get_num_edges();
+  pvector<edgeweight_t> expected = DijkstraSSSP(graph, SOURCE, num_ids);
+  assert(expected[SOURCE] == 0);
+  assert(expected[NUM_NODES + 1] == DistInf);
+
+  // The weighted visitor sees the same edges as get_out_edges
+  std::vector<edge> walked;
+  graph->for_each_out_edge(
+      SOURCE,
+      [&](node_id_t v, edgeweight_t w) {
+        walked.push_back({.src_id = SOURCE, .dst_id = v, .edge_weight = w});
+      });
+  std::vector<edge> out_edges = graph->get_out_edges(SOURCE);
+  // The AdjList lists are in insertion order, the edge table in key order
+  auto by_dst = [](const edge &a, const edge &b)
+  { return a.dst_id < b.dst_id; };
+  std::sort(walked.begin(), walked.end(), by_dst);
+  std::sort(out_edges.begin(), out_edges.end(), by_dst);
+  assert(walked.size() == FAN_OUT && walked.size() == out_edges.size());
+  for (size_t i = 0; i < walked.size(); i++)
+  {
+    assert(walked[i].dst_id == out_edges[i].dst_id);
+    assert(walked[i].edge_weight == out_edges[i].edge_weight);
+  }
+  graph->close(false);
+
+  for (edgeweight_t delta : {1, 8, 32, 1000})
+  {
+    pvector<edgeweight_t> dist = DeltaStep(
+        engine, SOURCE, delta, num_ids, num_edges, THREAD_NUM, false);
+    for (node_id_t v = 0; v < num_ids; v++)
+    {
+      assert(dist[v] == expected[v]);
+    }
+  }
+  engine.close_graph();
+}
+
+// Unweighted edge tables store a placeholder byte, not a weight, so every
+// edge must be seen with weight 0 and every reachable node at distance 0
+void test_unweighted(graph_opts opts, GraphType type)
+{
+  INFO()
+  opts.type = type;
+  opts.is_weighted = false;
+  opts.db_name = "test_sssp_unweighted_" + std::to_string(type);
+  GraphEngine engine(THREAD_NUM, opts);
+  GraphBase *graph = engine.create_graph_handle();
+  assert(graph->add_edges(make_edges()) == 0);
+  graph->add_edge({.src_id = NUM_NODES + 1, .dst_id = 2, .edge_weight = 1},
+                  false);
+
+  node_id_t num_ids = graph->get_max_node_id() + 1;
+  edge_id_t num_edges = graph->get_num_edges();
+  size_t walked = 0;
+  graph->for_each_out_edge(SOURCE,
+                           [&](node_id_t v, edgeweight_t w)
+                           {
+                             assert(w == 0);
+                             walked++;
+                           });
+  assert(walked == FAN_OUT);
+  graph->close(false);
+
+  for (edgeweight_t delta : {1, 32})
+  {
+    pvector<edgeweight_t> dist = DeltaStep(
+        engine, SOURCE, delta, num_ids, num_edges, THREAD_NUM, false);
+    assert(dist[SOURCE] == 0);
+    assert(dist[NUM_NODES + 1] == DistInf);
+    for (node_id_t dst = 2; dst <= FAN_OUT + 1; dst++)
+    {
+      assert(dist[dst] == 0);
+    }
+    for (node_id_t v = 0; v < num_ids; v++)
+    {
+      assert(dist[v] == 0 || dist[v] == DistInf);
+    }
+  }
+  engine.close_graph();
+}
+
+int main()
+{
+  graph_opts opts;
+  opts.create_new = true;
+  opts.optimize_create = false;
+  opts.is_directed = true;
+  opts.read_optimize = true;
+  opts.is_weighted = true;
+  opts.db_dir = "./db";
+  opts.conn_config = "cache_size=1GB";
+  if (const char *env_p = std::getenv("GRAPH_PROJECT_DIR"))
+  {
+    opts.stat_log = std::string(env_p);
+  }
+  else
+  {
+    std::cout << "GRAPH_PROJECT_DIR not set. Using CWD" << std::endl;
+    opts.stat_log = "./";
+  }
+
+  test_delta_step(opts, GraphType::Adj);
+  test_delta_step(opts, GraphType::SplitEKey);
+  test_unweighted(opts, GraphType::Adj);
+  test_unweighted(opts, GraphType::SplitEKey);
+  return 0;
+}
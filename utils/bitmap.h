@@ -52,6 +52,11 @@ class Bitmap
     return (start_[word_offset(pos)] >> bit_offset(pos)) & 1l;
   }
 
+  // The bits as 64 bit words, so callers can skip empty words and walk the
+  // set bits of the others with ctz
+  size_t num_words() const { return end_ - start_; }
+  uint64_t get_word(size_t w) const { return start_[w]; }
+
   void swap(Bitmap &other)
   {
     std::swap(start_, other.start_);
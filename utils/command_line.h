@@ -4,9 +4,11 @@
 #include <fmt/core.h>
 #include <getopt.h>
 
+#include <cerrno>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -20,6 +22,7 @@ struct cmdline_opts : graph_opts
   int num_trials = 16;
   node_id_t start_vertex = OutOfBand_ID_MAX;
   bool verify = false;
+  bool materialize_csr = false;
   // pagerank opts
   double tolerance = 1e-4;
   int iterations = 1;
@@ -40,6 +43,7 @@ struct cmdline_opts : graph_opts
     out << "START_VERTEX: " << start_vertex << std::endl;
     out << "TOLERANCE: " << tolerance << std::endl;
     out << "ITERATIONS: " << iterations << std::endl;
+    out << "MATERIALIZE_CSR: " << materialize_csr << std::endl;
     out.close();
   }
 };
@@ -51,9 +55,9 @@ class CmdLineBase
   char **argv_;
 
   std::string argstr_ =
-      "p:m:g:"           // required args
-      "s:nordwl:hz:aV";  //! Construct this after you finish the
-                         //! rest of this thing
+      "p:m:g:"                // required args
+      "s:nordwl:hz:aVc:SC:P:G";  //! Construct this after you finish the
+                                 //! rest of this thing
   std::vector<std::string> help_strings_;
   cmdline_opts opts;
 
@@ -114,6 +118,27 @@ class CmdLineBase
                      "verify",
                      "(Optional) Verify the results of the app. Default = "
                      "false");
+    add_help_message('c',
+                     "chunk_size",
+                     "(Optional) Store adjlists in chunks of chunk_size IDs "
+                     "(adj only). Default = one record per node");
+    add_help_message('S',
+                     "sorted_adjlist",
+                     "(Optional) Keep adjlists sorted by node ID (adj only). "
+                     "Default = false");
+    add_help_message('C',
+                     "adjlist_codec",
+                     "(Optional) Encoding of adjlist values (adj only). Can "
+                     "be one of raw, delta, bitpack, weighted. Default = "
+                     "raw");
+    add_help_message('P',
+                     "partition_mode",
+                     "(Optional) How the node IDs are split between threads. "
+                     "Can be one of range, degree. Default = range");
+    add_help_message('G',
+                     "degree_table",
+                     "(Optional) Keep a dense degree table (split_ekey only, "
+                     "needs -r). Default = false");
 
     if (argc_ == 1)
     {
@@ -198,6 +223,22 @@ class CmdLineBase
       case 'V':
         opts.verify = true;
         break;
+      case 'c':
+        opts.adjlist_layout = AdjListLayout::Chunked;
+        opts.adjlist_chunk_size = handle_chunk_size(opt_arg);
+        break;
+      case 'S':
+        opts.sorted_adjlist = true;
+        break;
+      case 'C':
+        opts.adjlist_codec = handle_adjlist_codec(opt_arg);
+        break;
+      case 'P':
+        opts.partition_mode = handle_partition_mode(opt_arg);
+        break;
+      case 'G':
+        opts.degree_table = true;
+        break;
       case 'h':
         print_help();
         break;
@@ -232,6 +273,54 @@ class CmdLineBase
     return type;
   }
 
+  static degree_t handle_chunk_size(char *opt_arg)
+  {
+    char *end = nullptr;
+    errno = 0;
+    long size = strtol(opt_arg, &end, 0);
+    if (end == opt_arg || *end != '\0' || errno != 0 || size <= 0 ||
+        size > std::numeric_limits<degree_t>::max())
+    {
+      throw GraphException("Invalid chunk size " + std::string(opt_arg) +
+                           ", expected a positive integer. Use -h for help.");
+    }
+    return (degree_t)size;
+  }
+
+  static AdjListCodec handle_adjlist_codec(char *opt_arg)
+  {
+    if (strcmp(opt_arg, "raw") == 0)
+    {
+      return AdjListCodec::Raw;
+    }
+    else if (strcmp(opt_arg, "delta") == 0)
+    {
+      return AdjListCodec::DeltaVarint;
+    }
+    else if (strcmp(opt_arg, "bitpack") == 0)
+    {
+      return AdjListCodec::BitPacked;
+    }
+    else if (strcmp(opt_arg, "weighted") == 0)
+    {
+      return AdjListCodec::Weighted;
+    }
+    throw GraphException("Unrecognized adjlist codec");
+  }
+
+  static PartitionMode handle_partition_mode(char *opt_arg)
+  {
+    if (strcmp(opt_arg, "range") == 0)
+    {
+      return PartitionMode::IdRange;
+    }
+    else if (strcmp(opt_arg, "degree") == 0)
+    {
+      return PartitionMode::DegreeBalanced;
+    }
+    throw GraphException("Unrecognized partition mode");
+  }
+
   void print_help()
   {
     for (const std::string &h : help_strings_) std::cout << h << std::endl;
@@ -270,7 +359,7 @@ class CmdLineApp : public CmdLineBase
  public:
   CmdLineApp(int argc, char **argv) : CmdLineBase(argc, argv)
   {
-    argstr_ += "#:v:";  // add v: for start_vertex
+    argstr_ += "#:v:M";  // add v: for start_vertex
     add_help_message(
         '#',
         "num_trials",
@@ -281,6 +370,10 @@ class CmdLineApp : public CmdLineBase
         "start_vertex",
         "(Optional) Starting vertex id. If not provided, then a random "
         "vertex is picked. ");
+    add_help_message('M',
+                     "materialize_csr",
+                     "(Optional) Load the graph into an in-memory CSR snapshot "
+                     "before running iterative apps. Default = false");
   }
 
   void handle_args(signed char opt, char *opt_arg) override
@@ -293,6 +386,9 @@ class CmdLineApp : public CmdLineBase
       case 'v':
         opts.start_vertex = (node_id_t)strtol(opt_arg, nullptr, 0);
         break;
+      case 'M':
+        opts.materialize_csr = true;
+        break;
       default:
         CmdLineBase::handle_args(opt, opt_arg);
     }
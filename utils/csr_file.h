@@ -0,0 +1,358 @@
+#ifndef CSR_FILE_H
+#define CSR_FILE_H
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph_engine.h"
+#include "graph_exception.h"
+#include "mmap_helper.h"
+
+/**
+ * On-disk form of a CSRGraph, written next to a WT database so analytics jobs
+ * can map it instead of scanning the tables.
+ *
+ * Layout: a csr_file_header followed by the offsets (uint64_t[num_nodes + 1]),
+ * the neighbours (node_id_t[num_edges]) and, if flagged, the weights
+ * (edgeweight_t[num_edges]) and the opposite direction degrees
+ * (degree_t[num_nodes]). Every section starts on a 64 byte boundary and its
+ * position is recorded in the header. The file is in host byte order.
+ *
+ * The header carries the name of the WT checkpoint the snapshot was taken
+ * from. open() compares it with the checkpoint the caller expects, normally
+ * GraphEngine::get_last_checkpoint(), and refuses stale files.
+ */
+
+const uint32_t CSR_FILE_VERSION = 1;
+const char CSR_FILE_MAGIC[8] = {'W', 'T', 'G', 'C', 'S', 'R', '\0', '\0'};
+
+typedef enum CSRFileFlags
+{
+  CSR_WEIGHTED = 1,
+  CSR_DEGREES = 2,
+  CSR_SORTED = 4
+} CSRFileFlags;
+
+struct csr_file_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  uint32_t direction;  // CSRDirection
+  uint32_t id_bytes;   // sizeof(node_id_t), differs between B64 builds
+  uint64_t num_nodes;
+  uint64_t num_edges;
+  char checkpoint[64];  // NUL terminated checkpoint name
+  uint64_t offsets_pos;
+  uint64_t nbrs_pos;
+  uint64_t weights_pos;  // 0 if absent
+  uint64_t degrees_pos;  // 0 if absent
+};
+
+class CSRFile
+{
+ public:
+  /**
+   * @brief The sidecar path for one direction of the WT database at
+   * db_dir/db_name. The file lives inside the database directory.
+   */
+  static std::string sidecar_path(const std::string &db_dir,
+                                  const std::string &db_name,
+                                  CSRDirection direction)
+  {
+    return db_dir + "/" + db_name + "/" +
+           (direction == CSRDirection::OutEdges ? "csr_out" : "csr_in") +
+           ".csr";
+  }
+
+  /**
+   * @brief Writes csr to path, stamped with checkpoint. If with_degrees is
+   * set, the degree of every node in the other direction is computed from
+   * the neighbour array and stored too.
+   */
+  static void write(const std::string &path,
+                    const CSRGraph &csr,
+                    const std::string &checkpoint,
+                    bool with_degrees = false)
+  {
+    if (checkpoint.size() >= sizeof(csr_file_header::checkpoint))
+    {
+      throw GraphException("Checkpoint name too long: " + checkpoint);
+    }
+    csr_file_header header{};
+    std::memcpy(header.magic, CSR_FILE_MAGIC, sizeof(header.magic));
+    header.version = CSR_FILE_VERSION;
+    header.flags = (csr.is_weighted() ? CSR_WEIGHTED : 0) |
+                   (with_degrees ? CSR_DEGREES : 0) |
+                   (csr.is_sorted() ? CSR_SORTED : 0);
+    header.direction = csr.get_direction();
+    header.id_bytes = sizeof(node_id_t);
+    header.num_nodes = csr.get_num_nodes();
+    header.num_edges = csr.get_num_edges();
+    std::strncpy(
+        header.checkpoint, checkpoint.c_str(), sizeof(header.checkpoint) - 1);
+
+    uint64_t pos = align(sizeof(header));
+    header.offsets_pos = pos;
+    pos = align(pos + (header.num_nodes + 1) * sizeof(uint64_t));
+    header.nbrs_pos = pos;
+    pos = align(pos + header.num_edges * sizeof(node_id_t));
+    if (csr.is_weighted())
+    {
+      header.weights_pos = pos;
+      pos = align(pos + header.num_edges * sizeof(edgeweight_t));
+    }
+    std::vector<degree_t> degrees;
+    if (with_degrees)
+    {
+      header.degrees_pos = pos;
+      pos = align(pos + header.num_nodes * sizeof(degree_t));
+      degrees = opposite_degrees(csr);
+    }
+
+    // Written to a temporary name first so readers never map a partial file
+    std::string tmp_path = path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      throw GraphException("Could not open " + tmp_path);
+    }
+    write_at(out, 0, &header, sizeof(header));
+    write_at(out,
+             header.offsets_pos,
+             csr.get_offsets(),
+             (header.num_nodes + 1) * sizeof(uint64_t));
+    write_at(out,
+             header.nbrs_pos,
+             csr.get_nbrs(),
+             header.num_edges * sizeof(node_id_t));
+    if (csr.is_weighted())
+    {
+      write_at(out,
+               header.weights_pos,
+               csr.get_edge_weights(),
+               header.num_edges * sizeof(edgeweight_t));
+    }
+    if (with_degrees)
+    {
+      write_at(out,
+               header.degrees_pos,
+               degrees.data(),
+               degrees.size() * sizeof(degree_t));
+    }
+    // Empty sections are never written, so the file is padded to the end of
+    // the last one; otherwise an edgeless graph ends before nbrs_pos
+    out.seekp(0, std::ios::end);
+    if ((uint64_t)out.tellp() < pos)
+    {
+      out.seekp((std::streamoff)(pos - 1));
+      out.put(0);
+    }
+    out.close();
+    if (!out || std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+      throw GraphException("Failed to write " + path);
+    }
+  }
+
+  /**
+   * @brief Maps the file at path and wraps it in a CSRGraph. The mapping is
+   * released when the CSRGraph is deleted.
+   * @param checkpoint If not empty, the checkpoint the file must have been
+   * taken from; a file stamped with another one is stale and rejected.
+   * @return The snapshot, owned by the caller.
+   */
+  static CSRGraph *open(const std::string &path,
+                        const std::string &checkpoint = "")
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw GraphException("Could not open CSR file " + path);
+    }
+    struct stat st
+    {
+    };
+    if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw GraphException("Could not stat CSR file " + path);
+    }
+    auto file_size = (uint64_t)st.st_size;
+    if (file_size < sizeof(csr_file_header))
+    {
+      close(fd);
+      throw GraphException("Truncated CSR file " + path);
+    }
+    mmap_helper<char> *mapped;
+    try
+    {
+      mapped = new mmap_helper<char>(file_size, fd, PROT_READ);
+    }
+    catch (GraphException &)
+    {
+      close(fd);
+      throw;
+    }
+    auto mapping = std::shared_ptr<mmap_helper<char>>(mapped,
+                                                      [](mmap_helper<char> *m)
+                                                      {
+                                                        m->unmap();
+                                                        delete m;
+                                                      });
+    close(fd);  // the mapping stays valid
+
+    char *base = mapping->get_iterator();
+    csr_file_header header{};
+    std::memcpy(&header, base, sizeof(header));
+    check_header(header, file_size, path);
+    if (!checkpoint.empty() && checkpoint != header.checkpoint)
+    {
+      throw GraphException("Stale CSR file " + path + ": taken at checkpoint " +
+                           header.checkpoint + ", expected " + checkpoint);
+    }
+
+    return new CSRGraph(
+        (CSRDirection)header.direction,
+        header.num_nodes,
+        header.num_edges,
+        (uint64_t *)(base + header.offsets_pos),
+        (node_id_t *)(base + header.nbrs_pos),
+        header.weights_pos ? (edgeweight_t *)(base + header.weights_pos)
+                           : nullptr,
+        header.degrees_pos ? (degree_t *)(base + header.degrees_pos) : nullptr,
+        header.flags & CSR_SORTED,
+        mapping);
+  }
+
+  /**
+   * @brief Returns the checkpoint stamp of the file at path without mapping
+   * the rest of it.
+   */
+  static std::string read_checkpoint(const std::string &path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    csr_file_header header{};
+    if (!in.read((char *)&header, sizeof(header)) ||
+        std::memcmp(header.magic, CSR_FILE_MAGIC, sizeof(header.magic)) != 0)
+    {
+      throw GraphException("Not a CSR file: " + path);
+    }
+    header.checkpoint[sizeof(header.checkpoint) - 1] = '\0';
+    return header.checkpoint;
+  }
+
+  /**
+   * @brief Maps the sidecar of direction if it was taken at the last
+   * checkpoint of engine. A missing or stale sidecar is replaced by a snapshot
+   * materialized from the tables, which is written back for the next job.
+   * @return The snapshot, owned by the caller.
+   */
+  static CSRGraph *open_or_materialize(GraphEngine &engine,
+                                       const std::string &db_dir,
+                                       const std::string &db_name,
+                                       CSRDirection direction)
+  {
+    std::string path = sidecar_path(db_dir, db_name, direction);
+    std::string checkpoint = engine.get_last_checkpoint();
+    if (!checkpoint.empty() && access(path.c_str(), R_OK) == 0)
+    {
+      try
+      {
+        return open(path, checkpoint);
+      }
+      catch (GraphException &e)
+      {
+        std::cout << e.what() << ", materializing it again" << std::endl;
+      }
+    }
+    CSRGraph *csr = engine.materialize_csr(direction);
+    try
+    {
+      write(path, *csr, engine.get_last_checkpoint(), true);
+    }
+    catch (GraphException &e)
+    {
+      std::cout << "Not caching the CSR snapshot: " << e.what() << std::endl;
+    }
+    return csr;
+  }
+
+ private:
+  static uint64_t align(uint64_t pos)
+  {
+    return (pos + CSRGraph::ALIGNMENT - 1) & ~(CSRGraph::ALIGNMENT - 1);
+  }
+
+  static void write_at(std::ofstream &out,
+                       uint64_t pos,
+                       const void *data,
+                       uint64_t size)
+  {
+    out.seekp((std::streamoff)pos);
+    out.write((const char *)data, (std::streamsize)size);
+  }
+
+  static std::vector<degree_t> opposite_degrees(const CSRGraph &csr)
+  {
+    std::vector<degree_t> degrees(csr.get_num_nodes(), 0);
+    const node_id_t *nbrs = csr.get_nbrs();
+#pragma omp parallel for
+    for (uint64_t i = 0; i < csr.get_num_edges(); i++)
+    {
+      if (nbrs[i] < csr.get_num_nodes())
+      {
+        std::atomic_ref<degree_t>(degrees[nbrs[i]])
+            .fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    return degrees;
+  }
+
+  static void check_header(csr_file_header &header,
+                           uint64_t file_size,
+                           const std::string &path)
+  {
+    header.checkpoint[sizeof(header.checkpoint) - 1] = '\0';
+    if (std::memcmp(header.magic, CSR_FILE_MAGIC, sizeof(header.magic)) != 0)
+    {
+      throw GraphException("Not a CSR file: " + path);
+    }
+    if (header.version != CSR_FILE_VERSION)
+    {
+      throw GraphException("Unsupported CSR file version " +
+                           std::to_string(header.version) + " in " + path);
+    }
+    if (header.id_bytes != sizeof(node_id_t))
+    {
+      throw GraphException("CSR file " + path + " uses " +
+                           std::to_string(header.id_bytes) +
+                           " byte node IDs");
+    }
+    uint64_t end = header.nbrs_pos + header.num_edges * sizeof(node_id_t);
+    if (header.offsets_pos + (header.num_nodes + 1) * sizeof(uint64_t) >
+            file_size ||
+        end > file_size ||
+        (header.weights_pos &&
+         header.weights_pos + header.num_edges * sizeof(edgeweight_t) >
+             file_size) ||
+        (header.degrees_pos &&
+         header.degrees_pos + header.num_nodes * sizeof(degree_t) > file_size))
+    {
+      throw GraphException("Truncated CSR file " + path);
+    }
+  }
+};
+
+#endif  // CSR_FILE_H
@@ -4,6 +4,12 @@
 #include <stdio.h>
 #include <sys/mman.h>
 
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "graph_exception.h"
+
 template <typename T>
 class mmap_helper
 {
@@ -21,20 +27,20 @@ class mmap_helper
                           0);
     if (start_ptr == MAP_FAILED)
     {
-      perror("Failed to allocate memory for pvector in mmap_helper");
-      exit(1);
+      throw GraphException(
+          std::string("Failed to allocate memory in mmap_helper: ") +
+          std::strerror(errno));
     }
   }
 
-  mmap_helper(size_t N, int fd)
+  mmap_helper(size_t N, int fd, int prot = PROT_READ | PROT_WRITE)
   {
     length = sizeof(T) * N;
-    start_ptr =
-        (T *)mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    start_ptr = (T *)mmap(NULL, length, prot, MAP_SHARED, fd, 0);
     if (start_ptr == MAP_FAILED)
     {
-      perror("mmap failed");
-      exit(1);
+      throw GraphException(std::string("mmap failed: ") +
+                           std::strerror(errno));
     }
   }
 
@@ -60,8 +66,8 @@ class mmap_helper
     start_ptr = (T *)mremap(start_ptr, length, new_length, 0);
     if (start_ptr == MAP_FAILED)
     {
-      perror("mremap failed");
-      exit(1);
+      throw GraphException(std::string("mremap failed: ") +
+                           std::strerror(errno));
     }
     return start_ptr;
   }